@@ -0,0 +1,729 @@
+#ifndef _ALLOCATOR_
+#define _ALLOCATOR_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+/**
+ * An allocator used by Buffer is a class with two members:
+ *  - void* allocate(size_t bytes, size_t alignment) - returns memory for bytes bytes with a specific
+ *    alignment or throws std::bad_alloc
+ *  - void deallocate(void* pointer, size_t bytes, size_t alignment) - releases memory returned by allocate
+ *    with the same size and alignment
+ *
+ * Copies of an allocator have to be able to release the memory of each other.
+ */
+
+/**
+ * @brief HeapAllocator class allocates memory with the global operator new
+ */
+class HeapAllocator
+{
+public:
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+};
+
+/**
+ * @brief MonotonicArena class hands out memory from large chunks by bumping a pointer and
+ *  releases all of it at once
+ *
+ *  Deallocation does nothing, the memory is reused only after reset(). The chunks are kept by reset(),
+ *  so an arena reused for every request stops allocating once it has grown to the largest request.
+ *  The arena isn't thread-safe.
+ */
+class MonotonicArena
+{
+private:
+    struct Chunk
+    {
+        Chunk* next;
+        size_t size;
+    };
+
+    Chunk* first;
+    Chunk* current;
+    size_t offset;      ///first free byte of the current chunk
+    size_t chunkSize;   ///size of the next new chunk
+
+private:
+    void* allocateFrom(Chunk*, size_t, size_t);
+
+public:
+    MonotonicArena(size_t initialSize = 4096);
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    ~MonotonicArena();
+
+public:
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+
+    void reset();
+    size_t reserved()const;
+};
+
+/**
+ * @brief ArenaAllocator class allocates memory from a MonotonicArena
+ */
+class ArenaAllocator
+{
+private:
+    MonotonicArena* arena;
+
+public:
+    ArenaAllocator(MonotonicArena&);
+
+public:
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+};
+
+/**
+ * @brief SizeClassPool class caches released blocks in free lists by size class
+ *
+ *  Requests are rounded up to a power of two between MIN_CLASS and MAX_CLASS bytes and served
+ *  from the free list of their class, so a block released by a buffer is reused by the next buffer
+ *  with a similar capacity. All pooled blocks are aligned to BLOCK_ALIGNMENT bytes, larger or over-aligned
+ *  requests go to the heap. Released blocks are cached only while the cached bytes stay within the limit,
+ *  the rest go back to the heap. A pool is thread-safe only if it is synchronized. The statistics show
+ *  how many allocations were served from the cache.
+ */
+class SizeClassPool
+{
+public:
+    static const size_t MIN_CLASS = 64;
+    static const size_t MAX_CLASS = size_t(1) << 26;
+    static const size_t BLOCK_ALIGNMENT = 64;
+    static const size_t DEFAULT_LIMIT = size_t(64) << 20;
+
+    struct Statistics
+    {
+        size_t hits;        ///allocations served by cached blocks
+        size_t misses;      ///allocations of new blocks
+        size_t returned;    ///releases of blocks cached by the pool
+        size_t dropped;     ///releases of blocks given back to the heap because of the limit
+        size_t retained;    ///bytes of the blocks cached by the pool
+
+        double hit_rate()const;
+    };
+
+private:
+    static const size_t CLASSES = 21;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    FreeBlock* freeLists[CLASSES];
+    size_t limit;
+    bool synchronized;
+    Statistics counters;
+    mutable std::mutex mutex;
+
+private:
+    static size_t classOf(size_t);
+    static bool pooled(size_t, size_t);
+    void trim(size_t);
+
+public:
+    SizeClassPool(size_t limit = DEFAULT_LIMIT, bool synchronized = false);
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+    ~SizeClassPool();
+
+public:
+    static SizeClassPool& global();
+
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+
+    void set_limit(size_t);
+    size_t get_limit()const;
+
+    Statistics statistics()const;
+    void reset_statistics();
+
+    void release();
+};
+
+/**
+ * @brief PoolAllocator class allocates memory from a SizeClassPool
+ */
+class PoolAllocator
+{
+private:
+    SizeClassPool* pool;
+
+public:
+    PoolAllocator(SizeClassPool&);
+
+public:
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+};
+
+/**
+ * @brief GlobalPoolAllocator class allocates memory from the process-wide SizeClassPool
+ */
+class GlobalPoolAllocator
+{
+public:
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+};
+
+/**
+ * @brief ThreadLocalPoolAllocator class allocates memory from a SizeClassPool owned by the calling thread
+ *
+ *  Blocks can be released by any thread, they are cached by the pool of the releasing thread. After the pool
+ *  of a thread is destroyed, e.g. while thread_local arrays are destroyed, the thread uses the process-wide pool.
+ */
+class ThreadLocalPoolAllocator
+{
+private:
+    struct LocalPool
+    {
+        SizeClassPool pool;
+
+        ~LocalPool();
+    };
+
+    static thread_local bool destroyed;
+
+private:
+    static SizeClassPool& pool();
+
+public:
+    void* allocate(size_t, size_t);
+    void deallocate(void*, size_t, size_t);
+};
+
+/**
+ * @brief allocates memory with the global operator new
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* HeapAllocator::allocate(size_t bytes, size_t alignment)
+{
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return ::operator new(bytes, std::align_val_t(alignment));
+    return ::operator new(bytes);
+}
+
+/**
+ * @brief releases memory with the global operator delete
+ *
+ * @param pointer - the memory
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ */
+inline void HeapAllocator::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ::operator delete(pointer, bytes, std::align_val_t(alignment));
+    else
+        ::operator delete(pointer, bytes);
+}
+
+/**
+ * @brief Construct a new Monotonic Arena object without any memory
+ *
+ * @param initialSize - size of the first chunk
+ */
+inline MonotonicArena::MonotonicArena(size_t initialSize)
+    : first(nullptr), current(nullptr), offset(0), chunkSize(initialSize > 0 ? initialSize : 4096)
+{
+
+}
+
+/**
+ * @brief Destroy the Monotonic Arena object and release all chunks
+ */
+inline MonotonicArena::~MonotonicArena()
+{
+    while(first)
+    {
+        Chunk* next = first->next;
+        ::operator delete(first);
+        first = next;
+    }
+}
+
+/**
+ * @brief bumps the free pointer of a chunk if the chunk has enough memory left
+ *
+ * @param chunk - the chunk
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void* - the memory or nullptr if it doesn't fit
+ */
+inline void* MonotonicArena::allocateFrom(Chunk* chunk, size_t bytes, size_t alignment)
+{
+    uintptr_t begin = reinterpret_cast<uintptr_t>(chunk + 1);
+    uintptr_t aligned = (begin + offset + alignment - 1) & ~uintptr_t(alignment - 1);
+
+    if(aligned + bytes > begin + chunk->size)
+        return nullptr;
+
+    offset = aligned + bytes - begin;
+    return reinterpret_cast<void*>(aligned);
+}
+
+/**
+ * @brief returns memory from the current chunk, moving to the next kept chunk or adding a new one if it doesn't fit
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* MonotonicArena::allocate(size_t bytes, size_t alignment)
+{
+    if(current)
+    {
+        void* memory = allocateFrom(current, bytes, alignment);
+        if(memory)
+            return memory;
+
+        while(current->next)
+        {
+            current = current->next;
+            offset = 0;
+
+            memory = allocateFrom(current, bytes, alignment);
+            if(memory)
+                return memory;
+        }
+    }
+
+    size_t size = chunkSize;
+    while(size < bytes + alignment)
+    {
+        size *= 2;
+    }
+    chunkSize = size * 2;
+
+    Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + size));
+    chunk->next = nullptr;
+    chunk->size = size;
+
+    if(current)
+        current->next = chunk;
+    else
+        first = chunk;
+
+    current = chunk;
+    offset = 0;
+    return allocateFrom(current, bytes, alignment);
+}
+
+/**
+ * @brief does nothing, the memory is released by reset() or by the destructor
+ */
+inline void MonotonicArena::deallocate(void*, size_t, size_t)
+{
+
+}
+
+/**
+ * @brief makes all memory of the arena available again, keeping its chunks
+ *  - all memory handed out by the arena must not be used anymore
+ */
+inline void MonotonicArena::reset()
+{
+    current = first;
+    offset = 0;
+}
+
+/**
+ * @brief returns the total size of the chunks of the arena
+ *
+ * @return size_t
+ */
+inline size_t MonotonicArena::reserved()const
+{
+    size_t total = 0;
+    for(Chunk* chunk = first; chunk; chunk = chunk->next)
+    {
+        total += chunk->size;
+    }
+    return total;
+}
+
+/**
+ * @brief Construct a new Arena Allocator object
+ *
+ * @param arena - the arena from which to allocate, it must outlive all memory allocated from it
+ */
+inline ArenaAllocator::ArenaAllocator(MonotonicArena& arena) : arena(&arena)
+{
+
+}
+
+/**
+ * @brief allocates memory from the arena
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* ArenaAllocator::allocate(size_t bytes, size_t alignment)
+{
+    return arena->allocate(bytes, alignment);
+}
+
+/**
+ * @brief returns memory to the arena
+ *
+ * @param pointer - the memory
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ */
+inline void ArenaAllocator::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    arena->deallocate(pointer, bytes, alignment);
+}
+
+/**
+ * @brief returns the share of the allocations served by cached blocks
+ *
+ * @return double - the share or 0 if there were no allocations
+ */
+inline double SizeClassPool::Statistics::hit_rate()const
+{
+    size_t total = hits + misses;
+    return total > 0 ? double(hits) / total : 0.0;
+}
+
+/**
+ * @brief Construct a new Size Class Pool object with empty free lists
+ *
+ * @param limit - maximum number of bytes cached by the pool
+ * @param synchronized - whether the pool can be used by several threads at once
+ */
+inline SizeClassPool::SizeClassPool(size_t limit, bool synchronized)
+    : freeLists(), limit(limit), synchronized(synchronized), counters()
+{
+
+}
+
+/**
+ * @brief Destroy the Size Class Pool object and release the cached blocks
+ */
+inline SizeClassPool::~SizeClassPool()
+{
+    trim(0);
+}
+
+/**
+ * @brief returns the index of the smallest size class that fits a specific size
+ *
+ * @param bytes - the size
+ * @return size_t
+ */
+inline size_t SizeClassPool::classOf(size_t bytes)
+{
+    if(bytes <= MIN_CLASS)
+        return 0;
+
+    return 64 - __builtin_clzll(bytes - 1) - 6;
+}
+
+/**
+ * @brief checks if memory with a specific size and alignment is served by the free lists
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return true
+ * @return false
+ */
+inline bool SizeClassPool::pooled(size_t bytes, size_t alignment)
+{
+    return bytes > 0 && bytes <= MAX_CLASS && alignment <= BLOCK_ALIGNMENT;
+}
+
+/**
+ * @brief releases cached blocks to the heap, starting with the largest ones, until at most
+ *  a specific number of bytes is cached
+ *  - the caller holds the lock of a synchronized pool
+ *
+ * @param bytes - the number of bytes
+ */
+inline void SizeClassPool::trim(size_t bytes)
+{
+    for(size_t index = CLASSES; index-- > 0 && counters.retained > bytes;)
+    {
+        while(freeLists[index] && counters.retained > bytes)
+        {
+            FreeBlock* next = freeLists[index]->next;
+            ::operator delete(freeLists[index], MIN_CLASS << index, std::align_val_t(BLOCK_ALIGNMENT));
+            freeLists[index] = next;
+            counters.retained -= MIN_CLASS << index;
+        }
+    }
+}
+
+/**
+ * @brief returns the process-wide pool, it is synchronized and caches at most DEFAULT_LIMIT bytes
+ *  - the pool is never destroyed, so static arrays can release their memory to it at exit
+ *
+ * @return SizeClassPool&
+ */
+inline SizeClassPool& SizeClassPool::global()
+{
+    static SizeClassPool& pool = *new SizeClassPool(DEFAULT_LIMIT, true);
+    return pool;
+}
+
+/**
+ * @brief returns a cached block of the size class of the request or allocates a new one
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* SizeClassPool::allocate(size_t bytes, size_t alignment)
+{
+    if(!pooled(bytes, alignment))
+        return HeapAllocator().allocate(bytes, alignment);
+
+    size_t index = classOf(bytes);
+    {
+        std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+        if(synchronized)
+            lock.lock();
+
+        FreeBlock* block = freeLists[index];
+        if(block)
+        {
+            freeLists[index] = block->next;
+            counters.retained -= MIN_CLASS << index;
+            ++counters.hits;
+            return block;
+        }
+        ++counters.misses;
+    }
+
+    return ::operator new(MIN_CLASS << index, std::align_val_t(BLOCK_ALIGNMENT));
+}
+
+/**
+ * @brief puts a block in the free list of its size class or releases it to the heap
+ *  if the pool would exceed its limit
+ *
+ * @param pointer - the memory
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ */
+inline void SizeClassPool::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    if(!pooled(bytes, alignment))
+    {
+        HeapAllocator().deallocate(pointer, bytes, alignment);
+        return;
+    }
+
+    size_t index = classOf(bytes);
+    {
+        std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+        if(synchronized)
+            lock.lock();
+
+        if(counters.retained + (MIN_CLASS << index) <= limit)
+        {
+            FreeBlock* block = static_cast<FreeBlock*>(pointer);
+            block->next = freeLists[index];
+            freeLists[index] = block;
+            counters.retained += MIN_CLASS << index;
+            ++counters.returned;
+            return;
+        }
+        ++counters.dropped;
+    }
+
+    ::operator delete(pointer, MIN_CLASS << index, std::align_val_t(BLOCK_ALIGNMENT));
+}
+
+/**
+ * @brief changes the maximum number of bytes cached by the pool, releasing blocks above the new limit
+ *
+ * @param bytes - the limit
+ */
+inline void SizeClassPool::set_limit(size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(synchronized)
+        lock.lock();
+
+    limit = bytes;
+    trim(limit);
+}
+
+/**
+ * @brief returns the maximum number of bytes cached by the pool
+ *
+ * @return size_t
+ */
+inline size_t SizeClassPool::get_limit()const
+{
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(synchronized)
+        lock.lock();
+
+    return limit;
+}
+
+/**
+ * @brief returns a copy of the counters of the pool
+ *
+ * @return Statistics
+ */
+inline SizeClassPool::Statistics SizeClassPool::statistics()const
+{
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(synchronized)
+        lock.lock();
+
+    return counters;
+}
+
+/**
+ * @brief sets the counters of allocations and releases to zero, the cached bytes are kept
+ */
+inline void SizeClassPool::reset_statistics()
+{
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(synchronized)
+        lock.lock();
+
+    size_t retained = counters.retained;
+    counters = Statistics();
+    counters.retained = retained;
+}
+
+/**
+ * @brief releases all cached blocks to the heap
+ */
+inline void SizeClassPool::release()
+{
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(synchronized)
+        lock.lock();
+
+    trim(0);
+}
+
+/**
+ * @brief Construct a new Pool Allocator object
+ *
+ * @param pool - the pool from which to allocate, it must outlive all memory allocated from it
+ */
+inline PoolAllocator::PoolAllocator(SizeClassPool& pool) : pool(&pool)
+{
+
+}
+
+/**
+ * @brief allocates memory from the pool
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* PoolAllocator::allocate(size_t bytes, size_t alignment)
+{
+    return pool->allocate(bytes, alignment);
+}
+
+/**
+ * @brief returns memory to the pool
+ *
+ * @param pointer - the memory
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ */
+inline void PoolAllocator::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    pool->deallocate(pointer, bytes, alignment);
+}
+
+/**
+ * @brief allocates memory from the process-wide pool
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* GlobalPoolAllocator::allocate(size_t bytes, size_t alignment)
+{
+    return SizeClassPool::global().allocate(bytes, alignment);
+}
+
+/**
+ * @brief returns memory to the process-wide pool
+ *
+ * @param pointer - the memory
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ */
+inline void GlobalPoolAllocator::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    SizeClassPool::global().deallocate(pointer, bytes, alignment);
+}
+
+inline thread_local bool ThreadLocalPoolAllocator::destroyed = false;
+
+/**
+ * @brief Destroy the Local Pool object and make the thread use the process-wide pool
+ */
+inline ThreadLocalPoolAllocator::LocalPool::~LocalPool()
+{
+    destroyed = true;
+}
+
+/**
+ * @brief returns the pool of the calling thread
+ *
+ * @return SizeClassPool&
+ */
+inline SizeClassPool& ThreadLocalPoolAllocator::pool()
+{
+    thread_local LocalPool local;
+    return local.pool;
+}
+
+/**
+ * @brief allocates memory from the pool of the calling thread
+ *
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ * @return void*
+ */
+inline void* ThreadLocalPoolAllocator::allocate(size_t bytes, size_t alignment)
+{
+    if(destroyed)
+        return SizeClassPool::global().allocate(bytes, alignment);
+    return pool().allocate(bytes, alignment);
+}
+
+/**
+ * @brief returns memory to the pool of the calling thread
+ *
+ * @param pointer - the memory
+ * @param bytes - size of the memory
+ * @param alignment - alignment of the memory
+ */
+inline void ThreadLocalPoolAllocator::deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    if(destroyed)
+        SizeClassPool::global().deallocate(pointer, bytes, alignment);
+    else
+        pool().deallocate(pointer, bytes, alignment);
+}
+
+#endif
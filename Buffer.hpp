@@ -2,64 +2,167 @@
 #define _BUFFER_
 
 
+#include <cstring>
 #include <stdexcept>
-#include <cassert>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+#include "Allocator.hpp"
+#include "Hardening.hpp"
 
 /**
  * @brief Buffer class is a class template that stores dynamically allocated array,
  *  taking care of memory allocation and deallocation
  * 
  * @tparam Type - type of data stored in the array
+ * @tparam Allocator - allocator of the memory, see Allocator.hpp
  */
-template <class Type>
+template <class Type, class Allocator = HeapAllocator>
 class Buffer
 {
 protected:
     Type* data;         ///pointer indicating the dynamically allocated array
     size_t allocated;   ///length of the array
+    [[no_unique_address]] Allocator allocator;
+
+private:
+    void allocate(size_t);
+    void deallocate();
+    void deallocate(size_t);
 
 public:
     Buffer();
-    Buffer(size_t);
-    Buffer(size_t, const Buffer<Type>&);
-    Buffer(size_t, size_t, const Buffer<Type>&);
-    Buffer(const Buffer<Type>&) = delete;
-    Buffer<Type>& operator=(const Buffer<Type>&) = delete;
+    explicit Buffer(const Allocator&);
+    Buffer(size_t, const Allocator& allocator = Allocator());
+    Buffer(size_t, const Buffer<Type, Allocator>&);
+    Buffer(size_t, size_t, const Buffer<Type, Allocator>&);
+    Buffer(size_t, size_t, const Buffer<Type, Allocator>&, const Allocator&);
+    Buffer(const Buffer<Type, Allocator>&) = delete;
+    Buffer<Type, Allocator>& operator=(const Buffer<Type, Allocator>&) = delete;
     ~Buffer();
 
 public:
     size_t size()const;
 
-    void swap(Buffer<Type>&);
+    const Allocator& get_allocator()const;
+
+    void swap(Buffer<Type, Allocator>&);
 
     Type& operator[](size_t);
 
     const Type& operator[](size_t s)const;
 
+    Type* begin();
+    const Type* begin()const;
+
+    Type* end();
+    const Type* end()const;
+
     void clear();
 };
 
+/**
+ * @brief allocates memory for a specific number of elements without constructing them
+ * 
+ * @param size - number of the elements
+ */
+template <class Type, class Allocator>
+void Buffer<Type, Allocator>::allocate(size_t size)
+{
+    if(size > size_t(-1) / sizeof(Type))
+        throw std::bad_array_new_length();
+
+    data = static_cast<Type*>(allocator.allocate(size * sizeof(Type), alignof(Type)));
+    allocated = size;
+}
+
+/**
+ * @brief destroys the elements and releases the memory
+ */
+template <class Type, class Allocator>
+void Buffer<Type, Allocator>::deallocate()
+{
+    deallocate(allocated);
+}
+
+/**
+ * @brief destroys the first elements and releases the memory
+ *  - used when constructing the elements failed and only some of them are alive
+ * 
+ * @param constructed - number of the elements to be destroyed
+ */
+template <class Type, class Allocator>
+void Buffer<Type, Allocator>::deallocate(size_t constructed)
+{
+    if(!data)
+        return;
+
+    if(!std::is_trivially_destructible<Type>::value)
+    {
+        for(size_t i = 0; i < constructed; ++i)
+        {
+            data[i].~Type();
+        }
+    }
+
+    allocator.deallocate(data, allocated * sizeof(Type), alignof(Type));
+    data = nullptr;
+    allocated = 0;
+}
+
 /**
  * @brief Construct a new Buffer object with zero elements
  */
-template <class Type>
-Buffer<Type>::Buffer() : Buffer(0)
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::Buffer() : Buffer(0)
+{
+
+}
+
+/**
+ * @brief Construct a new Buffer object with zero elements and a specific allocator
+ * 
+ * @param allocator - allocator of the memory
+ */
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::Buffer(const Allocator& allocator) : Buffer(0, allocator)
 {
 
 }
 
 /**
  * @brief Construct a new Buffer object with a specific size
+ *  - the elements are default-initialized, so elements of trivial types are left uninitialized
+ *    and their memory isn't touched
+ *  - if an exception is thrown, the constructed elements are destroyed and the memory is released
  * 
  * @param size - size of the buffer
+ * @param allocator - allocator of the memory
  */
-template <class Type>
-Buffer<Type>::Buffer(size_t size) : data(nullptr), allocated(0)
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::Buffer(size_t size, const Allocator& allocator) : data(nullptr), allocated(0), allocator(allocator)
 { 
     if(size > 0)
     {
-        data = new Type[size];
-        allocated = size;
+        allocate(size);
+
+        if constexpr(std::is_trivially_default_constructible<Type>::value)
+            return;
+
+        size_t constructed = 0;
+        try
+        {
+            for(; constructed < size; ++constructed)
+            {
+                new (data + constructed) Type;
+            }
+        }
+        catch(...)
+        {
+            deallocate(constructed);
+            throw;
+        }
     }
 
 }
@@ -70,8 +173,8 @@ Buffer<Type>::Buffer(size_t size) : data(nullptr), allocated(0)
  * @param size  - size of the buffer
  * @param other - buffer from which to copy the elements
  */
-template <class Type>
-Buffer<Type>::Buffer(size_t size, const Buffer<Type>& other) : Buffer(size, other.allocated, other)
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::Buffer(size_t size, const Buffer<Type, Allocator>& other) : Buffer(size, other.allocated, other)
 {
 
 }
@@ -81,10 +184,29 @@ Buffer<Type>::Buffer(size_t size, const Buffer<Type>& other) : Buffer(size, othe
  * 
  * @param size  - size of the buffer
  * @param elementsToCopy - number ot elements to be copied
+ * @param other - buffer from which to copy the elements and the allocator
+ */
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::Buffer(size_t size, size_t elementsToCopy, const Buffer<Type, Allocator>& other)
+    : Buffer(size, elementsToCopy, other, other.allocator)
+{
+
+}
+
+/**
+ * @brief Construct a new Buffer object with a specific size and allocator and copies all elements from another buffer
+ *  - the copied elements are copy-constructed and the rest are default-initialized
+ *  - elements of trivial types are copied with memcpy and the rest aren't touched
+ *  - if an exception is thrown, the constructed elements are destroyed and the memory is released
+ * 
+ * @param size  - size of the buffer
+ * @param elementsToCopy - number ot elements to be copied
  * @param other - buffer from which to copy the elements
+ * @param allocator - allocator of the memory
  */
-template <class Type>
-Buffer<Type>::Buffer(size_t size, size_t elementsToCopy, const Buffer<Type>& other) : data(nullptr), allocated(0)
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::Buffer(size_t size, size_t elementsToCopy, const Buffer<Type, Allocator>& other, const Allocator& allocator)
+    : data(nullptr), allocated(0), allocator(allocator)
 {
     if(size > 0) 
     {
@@ -93,12 +215,31 @@ Buffer<Type>::Buffer(size_t size, size_t elementsToCopy, const Buffer<Type>& oth
         if(other.allocated < used)
             throw std::invalid_argument("Not enough elements in the buffer object");
 
-        data = new Type[size];
-        allocated = size;
+        allocate(size);
 
-        for(size_t i = 0; i < used; ++i)
+        if constexpr(std::is_trivially_copyable<Type>::value && std::is_trivially_default_constructible<Type>::value)
+        {
+            if(used > 0)
+                std::memcpy(static_cast<void*>(data), other.data, used * sizeof(Type));
+            return;
+        }
+
+        size_t constructed = 0;
+        try
+        {
+            for(; constructed < used; ++constructed)
+            {
+                new (data + constructed) Type(other.data[constructed]);
+            }
+            for(; constructed < size; ++constructed)
+            {
+                new (data + constructed) Type;
+            }
+        }
+        catch(...)
         {
-            data[i] = other.data[i];
+            deallocate(constructed);
+            throw;
         }
     }
 }
@@ -106,10 +247,10 @@ Buffer<Type>::Buffer(size_t size, size_t elementsToCopy, const Buffer<Type>& oth
 /**
  * @brief Destroy the Buffer object
  */
-template <class Type>
-Buffer<Type>::~Buffer()
+template <class Type, class Allocator>
+Buffer<Type, Allocator>::~Buffer()
 {
-    clear();
+    deallocate();
 }
 
 /**
@@ -117,24 +258,36 @@ Buffer<Type>::~Buffer()
  *  
  * @return size_t 
  */
-template <class Type>
-size_t Buffer<Type>::size()const
+template <class Type, class Allocator>
+size_t Buffer<Type, Allocator>::size()const
 {
     return allocated;
 }
 
+/**
+ * @brief returns the allocator of the buffer
+ *  
+ * @return const Allocator& 
+ */
+template <class Type, class Allocator>
+const Allocator& Buffer<Type, Allocator>::get_allocator()const
+{
+    return allocator;
+}
+
 /**
  * @brief Exchanges the elements of two buffers
  * 
  * @param other - a buffer providing the elements to be swapped
  */
-template <class Type>
-void Buffer<Type>::swap(Buffer<Type>& other)
+template <class Type, class Allocator>
+void Buffer<Type, Allocator>::swap(Buffer<Type, Allocator>& other)
 {
     if(this != &other)
     {
     std::swap(data, other.data);
     std::swap(allocated, other.allocated);
+    std::swap(allocator, other.allocator);
     }
 }
 
@@ -144,10 +297,10 @@ void Buffer<Type>::swap(Buffer<Type>& other)
  * @param index - the index of the element
  * @return Type& 
  */
-template <class Type>
-Type& Buffer<Type>::operator[](size_t index)
+template <class Type, class Allocator>
+Type& Buffer<Type, Allocator>::operator[](size_t index)
 {
-    assert(index < allocated);
+    DYNAMIC_ARRAY_CHECK(index < allocated);
 
     return data[index];
 }
@@ -158,10 +311,54 @@ Type& Buffer<Type>::operator[](size_t index)
  * @param index - the index of the element
  * @return const Type& 
  */
-template <class Type>
-const Type& Buffer<Type>::operator[](size_t index)const 
+template <class Type, class Allocator>
+const Type& Buffer<Type, Allocator>::operator[](size_t index)const 
+{
+    return const_cast<Buffer<Type, Allocator>*>(this)->operator[](index);
+}
+
+/**
+ * @brief returns a pointer to the first element of the buffer
+ * 
+ * @return Type* 
+ */
+template <class Type, class Allocator>
+Type* Buffer<Type, Allocator>::begin()
+{
+    return data;
+}
+
+/**
+ * @brief returns a constant pointer to the first element of the buffer
+ * 
+ * @return const Type* 
+ */
+template <class Type, class Allocator>
+const Type* Buffer<Type, Allocator>::begin()const
+{
+    return data;
+}
+
+/**
+ * @brief returns a pointer past the last element of the buffer
+ * 
+ * @return Type* 
+ */
+template <class Type, class Allocator>
+Type* Buffer<Type, Allocator>::end()
 {
-    return const_cast<Buffer<Type>*>(this)->operator[](index);
+    return data + allocated;
+}
+
+/**
+ * @brief returns a constant pointer past the last element of the buffer
+ * 
+ * @return const Type* 
+ */
+template <class Type, class Allocator>
+const Type* Buffer<Type, Allocator>::end()const
+{
+    return data + allocated;
 }
     
 
@@ -169,12 +366,10 @@ const Type& Buffer<Type>::operator[](size_t index)const
  * @brief erases the elements of the buffer
  *  
  */
-template <class Type>
-void Buffer<Type>::clear()
+template <class Type, class Allocator>
+void Buffer<Type, Allocator>::clear()
 {
-    delete[] data;
-
-    allocated = 0;
+    deallocate();
 }
 
 #endif 
\ No newline at end of file
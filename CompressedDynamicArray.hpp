@@ -0,0 +1,444 @@
+#ifndef _COMPRESSED_DYNAMIC_ARRAY_
+#define _COMPRESSED_DYNAMIC_ARRAY_
+
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief CompressedDynamicArray class stores 32-bit unsigned integers compressed in blocks of 128 values
+ *
+ *  Every full block is encoded either with frame of reference (the values minus the smallest one) or,
+ *  if the block is sorted, with delta coding (the differences between consecutive values), whichever
+ *  needs fewer bits. The encoded values are bit-packed in four interleaved lanes, so four values are
+ *  unpacked at once with SSE2. The values of the last, incomplete block are stored uncompressed.
+ */
+class CompressedDynamicArray
+{
+public:
+    static const size_t BLOCK_SIZE = 128;
+
+private:
+    static const size_t LANES = 4;
+
+    enum Encoding : uint8_t
+    {
+        FRAME_OF_REFERENCE,
+        DELTA
+    };
+
+    struct Block
+    {
+        size_t offset;      ///index of the first packed word of the block
+        uint32_t base;      ///the smallest value or the first value of the block
+        uint8_t bits;       ///width of the packed values
+        Encoding encoding;
+    };
+
+    DynamicArray<Block> blocks;
+    DynamicArray<uint32_t> words;
+    uint32_t tail[BLOCK_SIZE];
+    size_t tailSize;
+
+private:
+    static uint8_t bitWidth(uint32_t);
+    static void pack(const uint32_t*, uint8_t, uint32_t*);
+    static void unpack(const uint32_t*, uint8_t, uint32_t*);
+    static uint32_t unpackOne(const uint32_t*, uint8_t, size_t);
+
+    void sealTail();
+
+public:
+    CompressedDynamicArray();
+    CompressedDynamicArray(const DynamicArray<uint32_t>&);
+
+public:
+    void push_back(uint32_t);
+
+    uint32_t at(size_t)const;
+    uint32_t operator[](size_t)const;
+
+    void decode_block(size_t, uint32_t*)const;
+    void decode(DynamicArray<uint32_t>&)const;
+
+    size_t size()const;
+    size_t block_count()const;
+    size_t compressed_bytes()const;
+    bool empty()const;
+};
+
+/**
+ * @brief returns the number of bits needed to store a value
+ *
+ * @param value - the value
+ * @return uint8_t
+ */
+inline uint8_t CompressedDynamicArray::bitWidth(uint32_t value)
+{
+    return value == 0 ? 0 : 32 - __builtin_clz(value);
+}
+
+/**
+ * @brief packs a block of values with a specific width into 4 * bits words
+ *  - value i is stored in lane i % 4, so the words of the four lanes are interleaved
+ *
+ * @param values - the block of values
+ * @param bits - width of every value
+ * @param out - the words, they have to be zeroed
+ */
+inline void CompressedDynamicArray::pack(const uint32_t* values, uint8_t bits, uint32_t* out)
+{
+    if(bits == 0)
+        return;
+
+    for(size_t row = 0; row < BLOCK_SIZE / LANES; ++row)
+    {
+        size_t position = row * bits;
+        size_t word = position / 32;
+        size_t shift = position % 32;
+
+        for(size_t lane = 0; lane < LANES; ++lane)
+        {
+            uint32_t value = values[row * LANES + lane];
+
+            out[word * LANES + lane] |= value << shift;
+            if(shift + bits > 32)
+                out[(word + 1) * LANES + lane] |= value >> (32 - shift);
+        }
+    }
+}
+
+/**
+ * @brief unpacks a block of values with a specific width
+ *
+ * @param in - the packed words
+ * @param bits - width of every value
+ * @param values - where to write the block of values
+ */
+inline void CompressedDynamicArray::unpack(const uint32_t* in, uint8_t bits, uint32_t* values)
+{
+    if(bits == 0)
+    {
+        for(size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            values[i] = 0;
+        }
+        return;
+    }
+
+    const uint32_t mask = bits == 32 ? ~uint32_t(0) : (uint32_t(1) << bits) - 1;
+
+#if defined(__SSE2__)
+    const __m128i masks = _mm_set1_epi32(mask);
+
+    for(size_t row = 0; row < BLOCK_SIZE / LANES; ++row)
+    {
+        size_t position = row * bits;
+        size_t word = position / 32;
+        size_t shift = position % 32;
+
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + word * LANES));
+        __m128i result = _mm_srl_epi32(low, _mm_cvtsi32_si128(shift));
+        if(shift + bits > 32)
+        {
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (word + 1) * LANES));
+            result = _mm_or_si128(result, _mm_sll_epi32(high, _mm_cvtsi32_si128(32 - shift)));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + row * LANES), _mm_and_si128(result, masks));
+    }
+#else
+    for(size_t row = 0; row < BLOCK_SIZE / LANES; ++row)
+    {
+        size_t position = row * bits;
+        size_t word = position / 32;
+        size_t shift = position % 32;
+
+        for(size_t lane = 0; lane < LANES; ++lane)
+        {
+            uint32_t value = in[word * LANES + lane] >> shift;
+            if(shift + bits > 32)
+                value |= in[(word + 1) * LANES + lane] << (32 - shift);
+
+            values[row * LANES + lane] = value & mask;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief unpacks a single value of a block
+ *
+ * @param in - the packed words
+ * @param bits - width of every value
+ * @param index - index of the value in the block
+ * @return uint32_t
+ */
+inline uint32_t CompressedDynamicArray::unpackOne(const uint32_t* in, uint8_t bits, size_t index)
+{
+    if(bits == 0)
+        return 0;
+
+    const uint32_t mask = bits == 32 ? ~uint32_t(0) : (uint32_t(1) << bits) - 1;
+
+    size_t lane = index % LANES;
+    size_t position = index / LANES * bits;
+    size_t word = position / 32;
+    size_t shift = position % 32;
+
+    uint32_t value = in[word * LANES + lane] >> shift;
+    if(shift + bits > 32)
+        value |= in[(word + 1) * LANES + lane] << (32 - shift);
+
+    return value & mask;
+}
+
+/**
+ * @brief encodes the full tail as a new block
+ */
+inline void CompressedDynamicArray::sealTail()
+{
+    uint32_t minimum = tail[0];
+    uint32_t maximum = tail[0];
+    uint32_t maximumDelta = 0;
+    bool sorted = true;
+
+    for(size_t i = 1; i < BLOCK_SIZE; ++i)
+    {
+        minimum = tail[i] < minimum ? tail[i] : minimum;
+        maximum = tail[i] > maximum ? tail[i] : maximum;
+
+        sorted = sorted && tail[i] >= tail[i - 1];
+        uint32_t delta = tail[i] - tail[i - 1];
+        maximumDelta = delta > maximumDelta ? delta : maximumDelta;
+    }
+
+    Block block;
+    block.offset = words.size();
+    block.base = minimum;
+    block.bits = bitWidth(maximum - minimum);
+    block.encoding = FRAME_OF_REFERENCE;
+
+    if(sorted && bitWidth(maximumDelta) < block.bits)
+    {
+        block.base = tail[0];
+        block.bits = bitWidth(maximumDelta);
+        block.encoding = DELTA;
+    }
+
+    uint32_t encoded[BLOCK_SIZE];
+    for(size_t i = 0; i < BLOCK_SIZE; ++i)
+    {
+        encoded[i] = block.encoding == DELTA ? (i == 0 ? 0 : tail[i] - tail[i - 1]) : tail[i] - block.base;
+    }
+
+    size_t packedWords = LANES * block.bits;
+    if(words.size() + packedWords > words.capacity())
+        words.reserve(words.size() + packedWords);
+
+    for(size_t i = 0; i < packedWords; ++i)
+    {
+        words.push_back(0);
+    }
+    pack(encoded, block.bits, words.data() + block.offset);
+
+    blocks.push_back(block);
+    tailSize = 0;
+}
+
+/**
+ * @brief Construct a new empty Compressed Dynamic Array object
+ */
+inline CompressedDynamicArray::CompressedDynamicArray() : tailSize(0)
+{
+
+}
+
+/**
+ * @brief Construct a new Compressed Dynamic Array object with the values of an array
+ *
+ * @param other - container from which to copy the values
+ */
+inline CompressedDynamicArray::CompressedDynamicArray(const DynamicArray<uint32_t>& other) : tailSize(0)
+{
+    for(size_t i = 0; i < other.size(); ++i)
+    {
+        push_back(other[i]);
+    }
+}
+
+/**
+ * @brief adds a new value to the end of the container, encoding the last block when it becomes full
+ *
+ * @param value - value to be pushed
+ */
+inline void CompressedDynamicArray::push_back(uint32_t value)
+{
+    tail[tailSize++] = value;
+
+    if(tailSize == BLOCK_SIZE)
+        sealTail();
+}
+
+/**
+ * @brief returns the value at a specified index
+ *
+ * @param index - index of the value to be returned
+ * @return uint32_t
+ */
+inline uint32_t CompressedDynamicArray::at(size_t index)const
+{
+    if(index < size())
+        return (*this)[index];
+    throw std::out_of_range("The index is out of range!");
+}
+
+/**
+ * @brief returns the value at a specified index
+ *  - a value of a frame of reference block is unpacked alone in O(1)
+ *  - a value of a delta block needs the preceding values of its block
+ *
+ * @param index - index of the value to be returned
+ * @return uint32_t
+ */
+inline uint32_t CompressedDynamicArray::operator[](size_t index)const
+{
+    DYNAMIC_ARRAY_CHECK(index < size());
+
+    size_t blockIndex = index / BLOCK_SIZE;
+    size_t position = index % BLOCK_SIZE;
+
+    if(blockIndex == blocks.size())
+        return tail[position];
+
+    const Block& block = blocks[blockIndex];
+    const uint32_t* in = words.data() + block.offset;
+
+    if(block.encoding == FRAME_OF_REFERENCE)
+        return block.base + unpackOne(in, block.bits, position);
+
+    uint32_t value = block.base;
+    for(size_t i = 1; i <= position; ++i)
+    {
+        value += unpackOne(in, block.bits, i);
+    }
+    return value;
+}
+
+/**
+ * @brief decodes all values of a block
+ *
+ * @param blockIndex - index of the block, block_count() is the uncompressed tail
+ * @param values - where to write the values, BLOCK_SIZE of them for a full block
+ */
+inline void CompressedDynamicArray::decode_block(size_t blockIndex, uint32_t* values)const
+{
+    if(blockIndex > blocks.size())
+        throw std::out_of_range("The block is out of range!");
+
+    if(blockIndex == blocks.size())
+    {
+        for(size_t i = 0; i < tailSize; ++i)
+        {
+            values[i] = tail[i];
+        }
+        return;
+    }
+
+    const Block& block = blocks[blockIndex];
+    unpack(words.data() + block.offset, block.bits, values);
+
+    if(block.encoding == FRAME_OF_REFERENCE)
+    {
+        for(size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            values[i] += block.base;
+        }
+        return;
+    }
+
+#if defined(__SSE2__)
+    __m128i carry = _mm_set1_epi32(block.base);
+    for(size_t i = 0; i < BLOCK_SIZE; i += LANES)
+    {
+        __m128i deltas = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 4));
+        deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 8));
+        deltas = _mm_add_epi32(deltas, carry);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), deltas);
+        carry = _mm_shuffle_epi32(deltas, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#else
+    uint32_t value = block.base;
+    for(size_t i = 0; i < BLOCK_SIZE; ++i)
+    {
+        value += values[i];
+        values[i] = value;
+    }
+#endif
+}
+
+/**
+ * @brief decodes all values and appends them to an array
+ *
+ * @param out - array to which the values are appended
+ */
+inline void CompressedDynamicArray::decode(DynamicArray<uint32_t>& out)const
+{
+    size_t offset = out.size();
+    out.resize_default_init(offset + size());
+
+    for(size_t blockIndex = 0; blockIndex <= blocks.size(); ++blockIndex)
+    {
+        decode_block(blockIndex, out.data() + offset + blockIndex * BLOCK_SIZE);
+    }
+}
+
+/**
+ * @brief returns the number of the values in the container
+ *
+ * @return size_t
+ */
+inline size_t CompressedDynamicArray::size()const
+{
+    return blocks.size() * BLOCK_SIZE + tailSize;
+}
+
+/**
+ * @brief returns the number of the encoded blocks, without the incomplete last block
+ *
+ * @return size_t
+ */
+inline size_t CompressedDynamicArray::block_count()const
+{
+    return blocks.size();
+}
+
+/**
+ * @brief returns the number of bytes used by the encoded blocks and the uncompressed tail
+ *
+ * @return size_t
+ */
+inline size_t CompressedDynamicArray::compressed_bytes()const
+{
+    return words.size() * sizeof(uint32_t) + blocks.size() * sizeof(Block) + tailSize * sizeof(uint32_t);
+}
+
+/**
+ * @brief checks if the container is empty
+ *
+ * @return true
+ * @return false
+ */
+inline bool CompressedDynamicArray::empty()const
+{
+    return size() == 0;
+}
+
+#endif
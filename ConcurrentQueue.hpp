@@ -0,0 +1,802 @@
+#ifndef _CONCURRENT_QUEUE_
+#define _CONCURRENT_QUEUE_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "Buffer.hpp"
+#include "DynamicArray.hpp"
+
+/**
+ * Wait strategies decide how a thread waits for a queue index or sequence to change from an observed value:
+ *  - wait(index, value) returns when the index may have changed, spurious returns are allowed
+ *  - notify(index) is called after the index was changed
+ */
+
+/**
+ * @brief SpinWait class busy-waits with pause instructions, it has the lowest latency but burns a core
+ */
+struct SpinWait
+{
+    void wait(const std::atomic<size_t>&, size_t)const;
+    void notify(std::atomic<size_t>&)const;
+};
+
+/**
+ * @brief YieldWait class gives the rest of the time slice to other threads while waiting
+ */
+struct YieldWait
+{
+    void wait(const std::atomic<size_t>&, size_t)const;
+    void notify(std::atomic<size_t>&)const;
+};
+
+/**
+ * @brief FutexWait class sleeps in the kernel until the index changes, using atomic wait and notify
+ *  which are futexes on Linux
+ */
+struct FutexWait
+{
+    void wait(const std::atomic<size_t>&, size_t)const;
+    void notify(std::atomic<size_t>&)const;
+};
+
+/**
+ * @brief SpscQueue class is a class template of bounded lock-free queues between one producing
+ *  and one consuming thread
+ *
+ *  The elements are kept in a Buffer with a power-of-two capacity and the head and tail indices grow
+ *  without wrapping. Every side keeps its own index and a cached copy of the index of the other side
+ *  on its own cache line, so the sides share a cache line only when the cached copy runs out.
+ *
+ * @tparam Type - type of the elements
+ * @tparam Wait - wait strategy of the blocking functions, SpinWait, YieldWait or FutexWait
+ */
+template <class Type, class Wait = YieldWait>
+class SpscQueue
+{
+public:
+    static const size_t CACHE_LINE = 64;
+
+private:
+    alignas(CACHE_LINE) std::atomic<size_t> head;   ///index of the next element to be popped, written by the consumer
+    size_t cachedTail;                              ///copy of the tail seen by the consumer
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail;   ///index of the next element to be pushed, written by the producer
+    size_t cachedHead;                              ///copy of the head seen by the producer
+
+    alignas(CACHE_LINE) Buffer<Type> slots;
+    size_t mask;
+    [[no_unique_address]] Wait waiting;
+
+public:
+    explicit SpscQueue(size_t capacity, const Wait& waiting = Wait());
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+public:
+    bool try_push(const Type&);
+    bool try_pop(Type&);
+
+    size_t try_push_n(std::span<const Type>);
+    size_t try_pop_n(std::span<Type>);
+
+    void push(const Type&);
+    Type pop();
+
+    void push_n(std::span<const Type>);
+    size_t pop_n(std::span<Type>);
+
+    size_t size_approx()const;
+    size_t capacity()const;
+};
+
+/**
+ * @brief MpmcQueue class is a class template of bounded lock-free queues between any number of producing
+ *  and consuming threads
+ *
+ *  Every slot of the Buffer has a sequence number that tells whose turn it is: a producer may fill the slot
+ *  at position p when its sequence is p and a consumer may empty it when its sequence is p + 1. A thread claims
+ *  a position with a single compare-and-swap of its index and the two indices are on separate cache lines.
+ *
+ * @tparam Type - type of the elements
+ * @tparam Wait - wait strategy of the blocking functions, SpinWait, YieldWait or FutexWait
+ */
+template <class Type, class Wait = YieldWait>
+class MpmcQueue
+{
+public:
+    static const size_t CACHE_LINE = 64;
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        Type value;
+    };
+
+private:
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePosition;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePosition;
+
+    alignas(CACHE_LINE) Buffer<Slot> slots;
+    size_t mask;
+    [[no_unique_address]] Wait waiting;
+
+private:
+    template <class Value>
+    bool tryPushValue(Value&&);
+
+public:
+    explicit MpmcQueue(size_t capacity, const Wait& waiting = Wait());
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+public:
+    bool try_push(const Type&);
+    bool try_push(Type&&);
+    bool try_pop(Type&);
+
+    void push(const Type&);
+    Type pop();
+
+    size_t size_approx()const;
+    size_t capacity()const;
+};
+
+/**
+ * @brief BatchedAppender class is a class template that collects elements from many producing threads
+ *  for a consumer that drains them periodically
+ *
+ *  Every producer fills a DynamicArray of its own and hands it over to an MpmcQueue once it holds a whole batch,
+ *  so the threads contend once per batch instead of once per element. The batches are allocated up front and
+ *  go back to the producers after the consumer copied them out.
+ *
+ * @tparam Type - type of the elements
+ * @tparam Wait - wait strategy of the threads waiting for a batch
+ */
+template <class Type, class Wait = YieldWait>
+class BatchedAppender
+{
+public:
+    /**
+     * @brief Producer class is the front end of one producing thread, it must not be shared between threads
+     */
+    class Producer
+    {
+    private:
+        BatchedAppender<Type, Wait>& appender;
+        DynamicArray<Type>* batch;
+
+    public:
+        explicit Producer(BatchedAppender<Type, Wait>&);
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+        ~Producer();
+
+    public:
+        void push_back(const Type&);
+        void flush();
+    };
+
+private:
+    size_t batchSize;
+    Buffer<DynamicArray<Type>> batches;
+    MpmcQueue<DynamicArray<Type>*, Wait> full;
+    MpmcQueue<DynamicArray<Type>*, Wait> spare;
+
+private:
+    static size_t checkSize(size_t);
+
+public:
+    BatchedAppender(size_t batchSize, size_t batches);
+    BatchedAppender(const BatchedAppender&) = delete;
+    BatchedAppender& operator=(const BatchedAppender&) = delete;
+
+public:
+    size_t drain(DynamicArray<Type>&);
+    size_t batch_size()const;
+};
+
+/**
+ * @brief spins for a while as long as the index has the observed value
+ *
+ * @param index - the index
+ * @param value - the observed value
+ */
+inline void SpinWait::wait(const std::atomic<size_t>& index, size_t value)const
+{
+    for(int spin = 0; spin < 64 && index.load(std::memory_order_relaxed) == value; ++spin)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+inline void SpinWait::notify(std::atomic<size_t>&)const
+{
+
+}
+
+/**
+ * @brief yields the time slice if the index has the observed value
+ *
+ * @param index - the index
+ * @param value - the observed value
+ */
+inline void YieldWait::wait(const std::atomic<size_t>& index, size_t value)const
+{
+    if(index.load(std::memory_order_relaxed) == value)
+        std::this_thread::yield();
+}
+
+inline void YieldWait::notify(std::atomic<size_t>&)const
+{
+
+}
+
+/**
+ * @brief sleeps until the index is notified with a value other than the observed one
+ *
+ * @param index - the index
+ * @param value - the observed value
+ */
+inline void FutexWait::wait(const std::atomic<size_t>& index, size_t value)const
+{
+    index.wait(value, std::memory_order_acquire);
+}
+
+/**
+ * @brief wakes the threads sleeping on an index, there are several of them when many producers or consumers
+ *  wait for the same slot
+ *
+ * @param index - the index
+ */
+inline void FutexWait::notify(std::atomic<size_t>& index)const
+{
+    index.notify_all();
+}
+
+/**
+ * @brief returns the smallest power of two not below a capacity
+ *
+ * @param capacity - the capacity
+ * @return size_t
+ */
+inline size_t roundCapacity(size_t capacity)
+{
+    if(capacity == 0 || capacity > (size_t(-1) >> 1) + 1)
+        throw std::invalid_argument("The capacity must be between 1 and 2^63!");
+
+    size_t rounded = 1;
+    while(rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+/**
+ * @brief Construct a new Spsc Queue object
+ *
+ * @param capacity - the least number of elements the queue holds, it is rounded up to a power of two
+ * @param waiting - the wait strategy
+ */
+template <class Type, class Wait>
+SpscQueue<Type, Wait>::SpscQueue(size_t capacity, const Wait& waiting)
+    : head(0), cachedTail(0), tail(0), cachedHead(0), slots(roundCapacity(capacity)), mask(slots.size() - 1), waiting(waiting)
+{
+
+}
+
+/**
+ * @brief adds an element to the queue if it isn't full, it is called by the producer only
+ *
+ * @param value - the element
+ * @return true - if the element was added
+ * @return false - if the queue is full
+ */
+template <class Type, class Wait>
+bool SpscQueue<Type, Wait>::try_push(const Type& value)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    if(position - cachedHead == slots.size())
+    {
+        cachedHead = head.load(std::memory_order_acquire);
+        if(position - cachedHead == slots.size())
+            return false;
+    }
+
+    slots.begin()[position & mask] = value;
+    tail.store(position + 1, std::memory_order_release);
+    waiting.notify(tail);
+    return true;
+}
+
+/**
+ * @brief takes the first element of the queue if it isn't empty, it is called by the consumer only
+ *
+ * @param value - where to move the element
+ * @return true - if an element was taken
+ * @return false - if the queue is empty
+ */
+template <class Type, class Wait>
+bool SpscQueue<Type, Wait>::try_pop(Type& value)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    if(position == cachedTail)
+    {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if(position == cachedTail)
+            return false;
+    }
+
+    value = std::move(slots.begin()[position & mask]);
+    head.store(position + 1, std::memory_order_release);
+    waiting.notify(head);
+    return true;
+}
+
+/**
+ * @brief adds as many elements of a batch as fit into the queue with a single update of the tail
+ *
+ * @param values - the batch
+ * @return size_t - number of the added elements, they are the first ones of the batch
+ */
+template <class Type, class Wait>
+size_t SpscQueue<Type, Wait>::try_push_n(std::span<const Type> values)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    size_t free = slots.size() - (position - cachedHead);
+    if(free < values.size())
+    {
+        cachedHead = head.load(std::memory_order_acquire);
+        free = slots.size() - (position - cachedHead);
+    }
+
+    size_t count = values.size() < free ? values.size() : free;
+    if(count == 0)
+        return 0;
+
+    size_t first = position & mask;
+    size_t beforeWrap = slots.size() - first < count ? slots.size() - first : count;
+    std::copy(values.data(), values.data() + beforeWrap, slots.begin() + first);
+    std::copy(values.data() + beforeWrap, values.data() + count, slots.begin());
+
+    tail.store(position + count, std::memory_order_release);
+    waiting.notify(tail);
+    return count;
+}
+
+/**
+ * @brief takes as many elements as are in the queue and fit into a batch with a single update of the head
+ *
+ * @param out - where to move the elements
+ * @return size_t - number of the taken elements
+ */
+template <class Type, class Wait>
+size_t SpscQueue<Type, Wait>::try_pop_n(std::span<Type> out)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    size_t available = cachedTail - position;
+    if(available < out.size())
+    {
+        cachedTail = tail.load(std::memory_order_acquire);
+        available = cachedTail - position;
+    }
+
+    size_t count = out.size() < available ? out.size() : available;
+    if(count == 0)
+        return 0;
+
+    size_t first = position & mask;
+    size_t beforeWrap = slots.size() - first < count ? slots.size() - first : count;
+    std::move(slots.begin() + first, slots.begin() + first + beforeWrap, out.data());
+    std::move(slots.begin(), slots.begin() + (count - beforeWrap), out.data() + beforeWrap);
+
+    head.store(position + count, std::memory_order_release);
+    waiting.notify(head);
+    return count;
+}
+
+/**
+ * @brief adds an element to the queue, waiting while it is full
+ *
+ * @param value - the element
+ */
+template <class Type, class Wait>
+void SpscQueue<Type, Wait>::push(const Type& value)
+{
+    while(!try_push(value))
+    {
+        waiting.wait(head, cachedHead);
+    }
+}
+
+/**
+ * @brief takes the first element of the queue, waiting while it is empty
+ *
+ * @return Type
+ */
+template <class Type, class Wait>
+Type SpscQueue<Type, Wait>::pop()
+{
+    Type value;
+    while(!try_pop(value))
+    {
+        waiting.wait(tail, cachedTail);
+    }
+    return value;
+}
+
+/**
+ * @brief adds all elements of a batch to the queue, waiting whenever it is full
+ *
+ * @param values - the batch
+ */
+template <class Type, class Wait>
+void SpscQueue<Type, Wait>::push_n(std::span<const Type> values)
+{
+    while(!values.empty())
+    {
+        size_t pushed = try_push_n(values);
+        if(pushed == 0)
+            waiting.wait(head, cachedHead);
+        values = values.subspan(pushed);
+    }
+}
+
+/**
+ * @brief takes at least one element into a batch, waiting while the queue is empty
+ *
+ * @param out - where to move the elements, it must not be empty
+ * @return size_t - number of the taken elements
+ */
+template <class Type, class Wait>
+size_t SpscQueue<Type, Wait>::pop_n(std::span<Type> out)
+{
+    for(;;)
+    {
+        size_t popped = try_pop_n(out);
+        if(popped > 0 || out.empty())
+            return popped;
+        waiting.wait(tail, cachedTail);
+    }
+}
+
+/**
+ * @brief returns the number of the elements in the queue, it may be outdated when it is returned
+ *
+ * @return size_t
+ */
+template <class Type, class Wait>
+size_t SpscQueue<Type, Wait>::size_approx()const
+{
+    size_t first = head.load(std::memory_order_acquire);
+    size_t last = tail.load(std::memory_order_acquire);
+    return last - first;
+}
+
+/**
+ * @brief returns the number of the elements the queue can hold
+ *
+ * @return size_t
+ */
+template <class Type, class Wait>
+size_t SpscQueue<Type, Wait>::capacity()const
+{
+    return slots.size();
+}
+
+/**
+ * @brief Construct a new Mpmc Queue object
+ *
+ * @param capacity - the least number of elements the queue holds, it is rounded up to a power of two
+ * @param waiting - the wait strategy
+ */
+template <class Type, class Wait>
+MpmcQueue<Type, Wait>::MpmcQueue(size_t capacity, const Wait& waiting)
+    : enqueuePosition(0), dequeuePosition(0), slots(roundCapacity(capacity)), mask(slots.size() - 1), waiting(waiting)
+{
+    for(size_t i = 0; i < slots.size(); ++i)
+    {
+        slots.begin()[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief claims the next position for a producer and stores an element in its slot
+ *
+ * @param value - the element, copied or moved
+ * @return true - if the element was added
+ * @return false - if the queue is full
+ */
+template <class Type, class Wait>
+template <class Value>
+bool MpmcQueue<Type, Wait>::tryPushValue(Value&& value)
+{
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    for(;;)
+    {
+        slot = slots.begin() + (position & mask);
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = std::ptrdiff_t(sequence - position);
+
+        if(difference == 0)
+        {
+            if(enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if(difference < 0)
+            return false;
+        else
+            position = enqueuePosition.load(std::memory_order_relaxed);
+    }
+
+    slot->value = std::forward<Value>(value);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    waiting.notify(slot->sequence);
+    return true;
+}
+
+/**
+ * @brief adds an element to the queue if it isn't full
+ *
+ * @param value - the element
+ * @return true - if the element was added
+ * @return false - if the queue is full
+ */
+template <class Type, class Wait>
+bool MpmcQueue<Type, Wait>::try_push(const Type& value)
+{
+    return tryPushValue(value);
+}
+
+/**
+ * @brief moves an element into the queue if it isn't full
+ *
+ * @param value - the element
+ * @return true - if the element was added
+ * @return false - if the queue is full, the element is left unchanged
+ */
+template <class Type, class Wait>
+bool MpmcQueue<Type, Wait>::try_push(Type&& value)
+{
+    return tryPushValue(std::move(value));
+}
+
+/**
+ * @brief takes the first element of the queue if it isn't empty
+ *
+ * @param value - where to move the element
+ * @return true - if an element was taken
+ * @return false - if the queue is empty
+ */
+template <class Type, class Wait>
+bool MpmcQueue<Type, Wait>::try_pop(Type& value)
+{
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    for(;;)
+    {
+        slot = slots.begin() + (position & mask);
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = std::ptrdiff_t(sequence - (position + 1));
+
+        if(difference == 0)
+        {
+            if(dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if(difference < 0)
+            return false;
+        else
+            position = dequeuePosition.load(std::memory_order_relaxed);
+    }
+
+    value = std::move(slot->value);
+    slot->sequence.store(position + mask + 1, std::memory_order_release);
+    waiting.notify(slot->sequence);
+    return true;
+}
+
+/**
+ * @brief adds an element to the queue, waiting while it is full
+ *
+ *  The thread waits on the sequence of the slot at the enqueue position, which changes when the slot is emptied.
+ *
+ * @param value - the element
+ */
+template <class Type, class Wait>
+void MpmcQueue<Type, Wait>::push(const Type& value)
+{
+    for(;;)
+    {
+        Slot& slot = slots.begin()[enqueuePosition.load(std::memory_order_relaxed) & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if(try_push(value))
+            return;
+        waiting.wait(slot.sequence, sequence);
+    }
+}
+
+/**
+ * @brief takes the first element of the queue, waiting while it is empty
+ *
+ * @return Type
+ */
+template <class Type, class Wait>
+Type MpmcQueue<Type, Wait>::pop()
+{
+    Type value;
+    for(;;)
+    {
+        Slot& slot = slots.begin()[dequeuePosition.load(std::memory_order_relaxed) & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if(try_pop(value))
+            return value;
+        waiting.wait(slot.sequence, sequence);
+    }
+}
+
+/**
+ * @brief returns the number of the elements in the queue, it may be outdated when it is returned
+ *
+ * @return size_t
+ */
+template <class Type, class Wait>
+size_t MpmcQueue<Type, Wait>::size_approx()const
+{
+    size_t first = dequeuePosition.load(std::memory_order_acquire);
+    size_t last = enqueuePosition.load(std::memory_order_acquire);
+    return last > first ? last - first : 0;
+}
+
+/**
+ * @brief returns the number of the elements the queue can hold
+ *
+ * @return size_t
+ */
+template <class Type, class Wait>
+size_t MpmcQueue<Type, Wait>::capacity()const
+{
+    return slots.size();
+}
+
+/**
+ * @brief Construct a new Producer object without a batch, it takes one with its first element
+ *
+ * @param appender - the appender
+ */
+template <class Type, class Wait>
+BatchedAppender<Type, Wait>::Producer::Producer(BatchedAppender<Type, Wait>& appender) : appender(appender), batch(nullptr)
+{
+
+}
+
+/**
+ * @brief Destroy the Producer object and hand over its last batch
+ */
+template <class Type, class Wait>
+BatchedAppender<Type, Wait>::Producer::~Producer()
+{
+    flush();
+}
+
+/**
+ * @brief adds an element to the batch of the producer and hands the batch over once it is full,
+ *  waits for a free batch if all of them are full
+ *
+ * @param value - the element
+ */
+template <class Type, class Wait>
+void BatchedAppender<Type, Wait>::Producer::push_back(const Type& value)
+{
+    if(batch == nullptr)
+        batch = appender.spare.pop();
+
+    batch->push_back(value);
+    if(batch->size() == appender.batchSize)
+        flush();
+}
+
+/**
+ * @brief hands the batch of the producer over to the consumer even if it isn't full
+ */
+template <class Type, class Wait>
+void BatchedAppender<Type, Wait>::Producer::flush()
+{
+    if(batch == nullptr)
+        return;
+
+    if(batch->empty())
+        appender.spare.push(batch);
+    else
+        appender.full.push(batch);
+    batch = nullptr;
+}
+
+/**
+ * @brief checks a size of the constructor
+ *
+ * @param size - the size
+ * @return size_t - the size
+ */
+template <class Type, class Wait>
+size_t BatchedAppender<Type, Wait>::checkSize(size_t size)
+{
+    if(size == 0)
+        throw std::invalid_argument("The batches and their size must not be 0!");
+    return size;
+}
+
+/**
+ * @brief Construct a new Batched Appender object
+ *
+ * @param batchSize - number of the elements of a batch
+ * @param batches - number of the batches, the producers wait for a free one when all are in use
+ */
+template <class Type, class Wait>
+BatchedAppender<Type, Wait>::BatchedAppender(size_t batchSize, size_t batches)
+    : batchSize(checkSize(batchSize)), batches(checkSize(batches)), full(batches), spare(batches)
+{
+    for(DynamicArray<Type>* batch = this->batches.begin(); batch != this->batches.end(); ++batch)
+    {
+        batch->reserve(batchSize);
+        spare.push(batch);
+    }
+}
+
+/**
+ * @brief appends the elements of all handed over batches to an array, without waiting for more
+ *
+ *  The elements of one producer keep their order if there is only one consumer. The drained batches are emptied
+ *  without resetting their elements, which are overwritten when the batches are filled again, so giving a batch
+ *  back can't throw and doesn't cost a pass over it.
+ *
+ * @param out - the array
+ * @return size_t - number of the appended elements
+ */
+template <class Type, class Wait>
+size_t BatchedAppender<Type, Wait>::drain(DynamicArray<Type>& out)
+{
+    size_t drained = 0;
+    DynamicArray<Type>* batch;
+    while(full.try_pop(batch))
+    {
+        try
+        {
+            out.append(batch->data(), batch->size());
+        }
+        catch(...)
+        {
+            full.push(batch);
+            throw;
+        }
+
+        drained += batch->size();
+        batch->resize_default_init(0);
+        spare.push(batch);
+    }
+    return drained;
+}
+
+/**
+ * @brief returns the number of the elements of a batch
+ *
+ * @return size_t
+ */
+template <class Type, class Wait>
+size_t BatchedAppender<Type, Wait>::batch_size()const
+{
+    return batchSize;
+}
+
+#endif
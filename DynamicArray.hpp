@@ -1,37 +1,66 @@
 #ifndef _DYNAMIC_ARRAY_
 #define _DYNAMIC_ARRAY_
 
+#include <algorithm>
+#include <cstring>
+#include <span>
 #include <stdexcept>
-#include <cassert>
+#include <type_traits>
 
 #include "Buffer.hpp"
+#include "DynamicArraySlice.hpp"
+#include "Hardening.hpp"
 
 /**
  * @brief DynamicArray class is a class template that stores elements of a given type in a linear arrangement and
  *  gives access to any element
  * 
  * @tparam Type - type of data stored in the array
+ * @tparam Allocator - allocator of the memory, see Allocator.hpp
  */
-template <class Type>
+template <class Type, class Allocator = HeapAllocator>
 class DynamicArray {
+public:
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    typedef CheckedIterator<DynamicArray<Type, Allocator>, Type> iterator;
+    typedef CheckedIterator<const DynamicArray<Type, Allocator>, const Type> const_iterator;
+#else
+    typedef Type* iterator;
+    typedef const Type* const_iterator;
+#endif
+
 private:
-    Buffer<Type> buffer;
+    Buffer<Type, Allocator> buffer;
     size_t used;
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    size_t generation = 0;  ///changes whenever the iterators of the array are invalidated
+
+    template <class, class> friend class CheckedIterator;
+#endif
 
 private:
-    void resizeBuffer();
+    size_t grownCapacity()const;
     void resizeBuffer(size_t size);
+    void invalidate();
+    SliceOrigin sliceOrigin()const;
+    template <class Fill>
+    void appendWith(size_t, Fill);
 
 public:
     DynamicArray();
-    DynamicArray(size_t size);
-    DynamicArray(const DynamicArray<Type>&);
-    DynamicArray<Type>& operator=(const DynamicArray<Type>&);
+    explicit DynamicArray(const Allocator&);
+    DynamicArray(size_t size, const Allocator& allocator = Allocator());
+    DynamicArray(const DynamicArray<Type, Allocator>&);
+    DynamicArray<Type, Allocator>& operator=(const DynamicArray<Type, Allocator>&);
 
 public:
     void push_back(const Type&);
     void pop_back();
 
+    void append(const Type*, size_t);
+    void append_n(size_t, const Type&);
+    std::span<Type> append_uninitialized(size_t);
+
     Type& at(size_t);
     const Type& at(size_t)const;
 
@@ -44,30 +73,48 @@ public:
     Type& back();
     const Type& back()const;
 
+    Type* data();
+    const Type* data()const;
+
+    iterator begin();
+    const_iterator begin()const;
+
+    iterator end();
+    const_iterator end()const;
+
+    DynamicArraySlice<Type> slice();
+    DynamicArraySlice<const Type> slice()const;
+    DynamicArraySlice<Type> slice(size_t offset, size_t length);
+    DynamicArraySlice<const Type> slice(size_t offset, size_t length)const;
+
+    StridedSlice<Type> strided(size_t offset, size_t count, size_t stride);
+    StridedSlice<const Type> strided(size_t offset, size_t count, size_t stride)const;
+
+    SliceChunks<Type> chunks(size_t size);
+    SliceChunks<const Type> chunks(size_t size)const;
+
     size_t size()const;
     size_t capacity()const;
     bool empty()const;
 
+    const Allocator& get_allocator()const;
+
     void clear();
+    void release();
     void resize(size_t, Type value = Type());
+    void resize_default_init(size_t);
     void reserve(size_t);  
 };
 
 /**
- * @brief resizes the array by doublig the capacity if the array isn't empty and maiking it 4 otherwise
+ * @brief returns the capacity after growing - the doubled capacity if the array isn't empty and 4 otherwise
+ * 
+ * @return size_t 
  */
-template <class Type>
-void DynamicArray<Type>::resizeBuffer()
+template <class Type, class Allocator>
+size_t DynamicArray<Type, Allocator>::grownCapacity()const
 {
-    if(buffer.size() == 0)
-    {
-        Buffer<Type> temp(4);
-        buffer.swap(temp);
-        return;
-    }
-
-    Buffer<Type> temp(buffer.size() * 2, buffer);
-    buffer.swap(temp);
+    return buffer.size() > 0 ? buffer.size() * 2 : 4;
 }
 
 /**
@@ -75,11 +122,13 @@ void DynamicArray<Type>::resizeBuffer()
  *  - if the size is equal to the current capacity it does nothing
  *  - if it is smaller -  resizes to the specified size
  *  - if it is bigger - chooses the bigger value between the doubled capacity and the specified size
+ *  - the elements are copied to a new buffer, which replaces the old one only after all copies succeed,
+ *    so the array doesn't change if an exception is thrown
  * 
  * @param size - new size of the array
  */
-template <class Type>
-void DynamicArray<Type>::resizeBuffer(size_t size)
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::resizeBuffer(size_t size)
 {
     if(size == buffer.size())
         return;
@@ -87,17 +136,57 @@ void DynamicArray<Type>::resizeBuffer(size_t size)
     if(size < buffer.size() * 2 && size > buffer.size())
         size = buffer.size() * 2;
 
-    used = size < used ? size : used;
+    size_t kept = size < used ? size : used;
 
-    Buffer<Type> temp(size, used, buffer);
+    Buffer<Type, Allocator> temp(size, kept, buffer);
     buffer.swap(temp);
+
+    used = kept;
+    invalidate();
+}
+
+/**
+ * @brief marks all iterators of the array as invalid, it does nothing below hardening level 2
+ */
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::invalidate()
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    ++generation;
+#endif
+}
+
+/**
+ * @brief returns the origin of the slices of the array, it checks them only at hardening level 2
+ * 
+ * @return SliceOrigin 
+ */
+template <class Type, class Allocator>
+SliceOrigin DynamicArray<Type, Allocator>::sliceOrigin()const
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    return SliceOrigin(&generation);
+#else
+    return SliceOrigin();
+#endif
 }
 
 /**
  * @brief Construct a new Dynamic Array object
  */
-template <class Type>
-DynamicArray<Type>::DynamicArray() : used(0)
+template <class Type, class Allocator>
+DynamicArray<Type, Allocator>::DynamicArray() : used(0)
+{
+
+}
+
+/**
+ * @brief Construct a new Dynamic Array object with a specific allocator
+ * 
+ * @param allocator - allocator of the memory
+ */
+template <class Type, class Allocator>
+DynamicArray<Type, Allocator>::DynamicArray(const Allocator& allocator) : buffer(allocator), used(0)
 {
 
 }
@@ -106,9 +195,10 @@ DynamicArray<Type>::DynamicArray() : used(0)
  * @brief Construct a new Dynamic Array object with a specific size
  * 
  * @param size 
+ * @param allocator - allocator of the memory
  */
-template <class Type>
-DynamicArray<Type>::DynamicArray(size_t size) : buffer(size), used(0) 
+template <class Type, class Allocator>
+DynamicArray<Type, Allocator>::DynamicArray(size_t size, const Allocator& allocator) : buffer(size, allocator), used(0) 
 {
 
 }
@@ -118,50 +208,154 @@ DynamicArray<Type>::DynamicArray(size_t size) : buffer(size), used(0)
  * 
  * @param other - container from which to copy the elements
  */
-template <class Type>
-DynamicArray<Type>::DynamicArray(const DynamicArray<Type>& other) : buffer(other.capacity(), other.used, other.buffer), used(other.used)
+template <class Type, class Allocator>
+DynamicArray<Type, Allocator>::DynamicArray(const DynamicArray<Type, Allocator>& other) : buffer(other.capacity(), other.used, other.buffer), used(other.used)
 {
 
 }
 
 /**
  * @brief Assigns new content to the container, replacing the current elements and modifying its size
+ *  - the container keeps its own allocator
+ *  - the container doesn't change if an exception is thrown
  * 
  * @param other - container from which to copy the elements
- * @return DynamicArray<Type>& 
+ * @return DynamicArray<Type, Allocator>& 
  */
-template <class Type>
-DynamicArray<Type>& DynamicArray<Type>::operator=(const DynamicArray<Type>& other)
+template <class Type, class Allocator>
+DynamicArray<Type, Allocator>& DynamicArray<Type, Allocator>::operator=(const DynamicArray<Type, Allocator>& other)
 {
     if(this != &other) 
     {
-        Buffer<Type> temp(other.capacity(), other.used, other.buffer);
+        Buffer<Type, Allocator> temp(other.capacity(), other.used, other.buffer, buffer.get_allocator());
         buffer.swap(temp);
         
         used = other.used;
+        invalidate();
     }
     return *this;
 }
 
 /**
  * @brief adds a new item to the end of the container, modifying its size if necessary
+ *  - if the array grows, the element is copied to the new buffer before the old one is released,
+ *    so it can be an element of the array itself
+ *  - the array doesn't change if an exception is thrown
  * 
  * @param elem - element to be pushed
  */
-template <class Type>
-void DynamicArray<Type>::push_back(const Type& elem)
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::push_back(const Type& elem)
 {
-    if(used >= buffer.size())
-        resizeBuffer();
+    if(used < buffer.size())
+    {
+        buffer[used] = elem;
+        ++used;
+        return;
+    }
 
-    buffer[used++] = elem;
+    Buffer<Type, Allocator> temp(grownCapacity(), used, buffer);
+    temp[used] = elem;
+    buffer.swap(temp);
+
+    ++used;
+    invalidate();
+}
+
+/**
+ * @brief adds a number of elements to the end of the container with a single capacity check
+ *  - if the array grows, the elements are written to the new buffer before the old one is released,
+ *    so the fill can read elements of the array itself
+ *  - the array doesn't change if an exception is thrown
+ * 
+ * @param count - number of the elements
+ * @param fill - writes the elements to the pointer it gets
+ */
+template <class Type, class Allocator>
+template <class Fill>
+void DynamicArray<Type, Allocator>::appendWith(size_t count, Fill fill)
+{
+    if(count == 0)
+        return;
+
+    if(count > buffer.size() - used)
+    {
+        if(count > size_t(-1) - used)
+            throw std::length_error("The array is too long!");
+
+        size_t size = used + count;
+        Buffer<Type, Allocator> temp(size > grownCapacity() ? size : grownCapacity(), used, buffer);
+        fill(temp.begin() + used);
+        buffer.swap(temp);
+        invalidate();
+    }
+    else
+    {
+        fill(buffer.begin() + used);
+    }
+
+    used += count;
+}
+
+/**
+ * @brief adds copies of the elements of a range to the end of the container
+ *  - elements of trivially copyable types are copied with memcpy
+ *  - the range can be a part of the array itself
+ *  - the array doesn't change if an exception is thrown
+ * 
+ * @param first - pointer to the first element of the range
+ * @param count - number of the elements of the range
+ */
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::append(const Type* first, size_t count)
+{
+    appendWith(count, [first, count](Type* out)
+    {
+        if constexpr(std::is_trivially_copyable<Type>::value)
+            std::memcpy(static_cast<void*>(out), first, count * sizeof(Type));
+        else
+            std::copy(first, first + count, out);
+    });
+}
+
+/**
+ * @brief adds a number of copies of a value to the end of the container
+ *  - the value can be an element of the array itself
+ *  - the array doesn't change if an exception is thrown
+ * 
+ * @param count - number of the copies
+ * @param value - the value
+ */
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::append_n(size_t count, const Type& value)
+{
+    appendWith(count, [count, &value](Type* out)
+    {
+        std::fill_n(out, count, value);
+    });
+}
+
+/**
+ * @brief adds a number of elements to the end of the container without writing them and returns them
+ *  to be written by the caller, e.g. by a parser reading directly into the storage
+ *  - elements of trivial types have indeterminate values, others are default values or earlier elements
+ *  - the span is invalidated like the iterators
+ * 
+ * @param count - number of the elements
+ * @return std::span<Type> - the added elements
+ */
+template <class Type, class Allocator>
+std::span<Type> DynamicArray<Type, Allocator>::append_uninitialized(size_t count)
+{
+    appendWith(count, [](Type*) {});
+    return std::span<Type>(buffer.begin() + used - count, count);
 }
 
 /**
  * @brief deletes the element at the end of the vector
  */
-template <class Type>
-void DynamicArray<Type>::pop_back()
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::pop_back()
 {
     if(used > 0)
         --used;
@@ -173,8 +367,8 @@ void DynamicArray<Type>::pop_back()
  * @param index - index of the element to be returned
  * @return Type& 
  */
-template <class Type>
-Type& DynamicArray<Type>::at(size_t index)
+template <class Type, class Allocator>
+Type& DynamicArray<Type, Allocator>::at(size_t index)
 {
     if(index < used)
         return buffer[index];
@@ -187,10 +381,10 @@ Type& DynamicArray<Type>::at(size_t index)
  * @param index - index of the element to be returned
  * @return const Type& 
  */
-template <class Type>
-const Type& DynamicArray<Type>::at(size_t index)const
+template <class Type, class Allocator>
+const Type& DynamicArray<Type, Allocator>::at(size_t index)const
 {
-    return const_cast<DynamicArray<Type>*>(this)->at(index);
+    return const_cast<DynamicArray<Type, Allocator>*>(this)->at(index);
 }
 
 /**
@@ -199,11 +393,11 @@ const Type& DynamicArray<Type>::at(size_t index)const
  * @param index - index of the element to be returned
  * @return Type& 
  */
-template <class Type>
-Type& DynamicArray<Type>::operator[](size_t index)
+template <class Type, class Allocator>
+Type& DynamicArray<Type, Allocator>::operator[](size_t index)
 {
-    assert(index < used);
-    return buffer[index];
+    DYNAMIC_ARRAY_CHECK(index < used);
+    return buffer.begin()[index];
 }
 
 /**
@@ -212,10 +406,10 @@ Type& DynamicArray<Type>::operator[](size_t index)
  * @param index - index of the element to be returned
  * @return Type& 
  */
-template <class Type>
-const Type& DynamicArray<Type>::operator[](size_t index)const
+template <class Type, class Allocator>
+const Type& DynamicArray<Type, Allocator>::operator[](size_t index)const
 {
-    return const_cast<DynamicArray<Type>*>(this)->operator[](index);
+    return const_cast<DynamicArray<Type, Allocator>*>(this)->operator[](index);
 }
 
 /**
@@ -223,8 +417,8 @@ const Type& DynamicArray<Type>::operator[](size_t index)const
  * 
  * @return Type& 
  */
-template <class Type>
-Type& DynamicArray<Type>::front()
+template <class Type, class Allocator>
+Type& DynamicArray<Type, Allocator>::front()
 {
     if(!empty())
         return buffer[0];
@@ -236,10 +430,10 @@ Type& DynamicArray<Type>::front()
  * 
  * @return Type& 
  */
-template <class Type>
-const Type& DynamicArray<Type>::front()const
+template <class Type, class Allocator>
+const Type& DynamicArray<Type, Allocator>::front()const
 {
-    return const_cast<DynamicArray<Type>*>(this)->front();
+    return const_cast<DynamicArray<Type, Allocator>*>(this)->front();
 }
 
 /**
@@ -247,8 +441,8 @@ const Type& DynamicArray<Type>::front()const
  * 
  * @return Type& 
  */
-template <class Type>
-Type& DynamicArray<Type>::back()
+template <class Type, class Allocator>
+Type& DynamicArray<Type, Allocator>::back()
 {
     if(!empty())
         return buffer[used - 1];
@@ -260,10 +454,196 @@ Type& DynamicArray<Type>::back()
  * 
  * @return Type& 
  */
-template <class Type>
-const Type& DynamicArray<Type>::back()const
+template <class Type, class Allocator>
+const Type& DynamicArray<Type, Allocator>::back()const
 {
-    return const_cast<DynamicArray<Type>*>(this)->back();
+    return const_cast<DynamicArray<Type, Allocator>*>(this)->back();
+}
+
+/**
+ * @brief returns a pointer to the underlying storage
+ * 
+ * @return Type* 
+ */
+template <class Type, class Allocator>
+Type* DynamicArray<Type, Allocator>::data()
+{
+    return buffer.begin();
+}
+
+/**
+ * @brief returns a constant pointer to the underlying storage
+ * 
+ * @return const Type* 
+ */
+template <class Type, class Allocator>
+const Type* DynamicArray<Type, Allocator>::data()const
+{
+    return buffer.begin();
+}
+
+/**
+ * @brief returns an iterator to the first element
+ *  - it is a pointer below hardening level 2
+ * 
+ * @return iterator 
+ */
+template <class Type, class Allocator>
+typename DynamicArray<Type, Allocator>::iterator DynamicArray<Type, Allocator>::begin()
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    return iterator(this, 0);
+#else
+    return buffer.begin();
+#endif
+}
+
+/**
+ * @brief returns a constant iterator to the first element
+ * 
+ * @return const_iterator 
+ */
+template <class Type, class Allocator>
+typename DynamicArray<Type, Allocator>::const_iterator DynamicArray<Type, Allocator>::begin()const
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    return const_iterator(this, 0);
+#else
+    return buffer.begin();
+#endif
+}
+
+/**
+ * @brief returns an iterator past the last element
+ * 
+ * @return iterator 
+ */
+template <class Type, class Allocator>
+typename DynamicArray<Type, Allocator>::iterator DynamicArray<Type, Allocator>::end()
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    return iterator(this, used);
+#else
+    return buffer.begin() + used;
+#endif
+}
+
+/**
+ * @brief returns a constant iterator past the last element
+ * 
+ * @return const_iterator 
+ */
+template <class Type, class Allocator>
+typename DynamicArray<Type, Allocator>::const_iterator DynamicArray<Type, Allocator>::end()const
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    return const_iterator(this, used);
+#else
+    return buffer.begin() + used;
+#endif
+}
+
+/**
+ * @brief returns a slice of all elements, it borrows the storage and is invalidated like the iterators
+ * 
+ * @return DynamicArraySlice<Type> 
+ */
+template <class Type, class Allocator>
+DynamicArraySlice<Type> DynamicArray<Type, Allocator>::slice()
+{
+    return DynamicArraySlice<Type>(buffer.begin(), used, sliceOrigin());
+}
+
+/**
+ * @brief returns a read-only slice of all elements
+ * 
+ * @return DynamicArraySlice<const Type> 
+ */
+template <class Type, class Allocator>
+DynamicArraySlice<const Type> DynamicArray<Type, Allocator>::slice()const
+{
+    return DynamicArraySlice<const Type>(buffer.begin(), used, sliceOrigin());
+}
+
+/**
+ * @brief returns a slice of a part of the array
+ *  - throws std::out_of_range if the part isn't inside the array
+ * 
+ * @param offset - index of the first element of the part
+ * @param length - number of the elements of the part
+ * @return DynamicArraySlice<Type> 
+ */
+template <class Type, class Allocator>
+DynamicArraySlice<Type> DynamicArray<Type, Allocator>::slice(size_t offset, size_t length)
+{
+    return slice().slice(offset, length);
+}
+
+/**
+ * @brief returns a read-only slice of a part of the array
+ * 
+ * @param offset - index of the first element of the part
+ * @param length - number of the elements of the part
+ * @return DynamicArraySlice<const Type> 
+ */
+template <class Type, class Allocator>
+DynamicArraySlice<const Type> DynamicArray<Type, Allocator>::slice(size_t offset, size_t length)const
+{
+    return slice().slice(offset, length);
+}
+
+/**
+ * @brief returns a view of every stride-th element of the array
+ *  - throws std::out_of_range if the elements aren't inside the array and std::invalid_argument if the stride is 0
+ * 
+ * @param offset - index of the first element of the view
+ * @param count - number of the elements of the view
+ * @param stride - distance between the elements of the view
+ * @return StridedSlice<Type> 
+ */
+template <class Type, class Allocator>
+StridedSlice<Type> DynamicArray<Type, Allocator>::strided(size_t offset, size_t count, size_t stride)
+{
+    return slice().strided(offset, count, stride);
+}
+
+/**
+ * @brief returns a read-only view of every stride-th element of the array
+ * 
+ * @param offset - index of the first element of the view
+ * @param count - number of the elements of the view
+ * @param stride - distance between the elements of the view
+ * @return StridedSlice<const Type> 
+ */
+template <class Type, class Allocator>
+StridedSlice<const Type> DynamicArray<Type, Allocator>::strided(size_t offset, size_t count, size_t stride)const
+{
+    return slice().strided(offset, count, stride);
+}
+
+/**
+ * @brief returns the consecutive slices of the array with a given size, the last one may be shorter
+ *  - throws std::invalid_argument if the size is 0
+ * 
+ * @param size - number of the elements of a slice
+ * @return SliceChunks<Type> 
+ */
+template <class Type, class Allocator>
+SliceChunks<Type> DynamicArray<Type, Allocator>::chunks(size_t size)
+{
+    return slice().chunks(size);
+}
+
+/**
+ * @brief returns the consecutive read-only slices of the array with a given size
+ * 
+ * @param size - number of the elements of a slice
+ * @return SliceChunks<const Type> 
+ */
+template <class Type, class Allocator>
+SliceChunks<const Type> DynamicArray<Type, Allocator>::chunks(size_t size)const
+{
+    return slice().chunks(size);
 }
 
 /**
@@ -271,8 +651,8 @@ const Type& DynamicArray<Type>::back()const
  * 
  * @return size_t 
  */
-template <class Type>
-size_t DynamicArray<Type>::size()const
+template <class Type, class Allocator>
+size_t DynamicArray<Type, Allocator>::size()const
 {
     return used;
 }
@@ -282,8 +662,8 @@ size_t DynamicArray<Type>::size()const
  * 
  * @return size_t 
  */
-template <class Type>
-size_t DynamicArray<Type>::capacity()const
+template <class Type, class Allocator>
+size_t DynamicArray<Type, Allocator>::capacity()const
 {
     return buffer.size();
 }
@@ -294,21 +674,62 @@ size_t DynamicArray<Type>::capacity()const
  * @return true 
  * @return false 
  */
-template <class Type>
-bool DynamicArray<Type>::empty()const
+template <class Type, class Allocator>
+bool DynamicArray<Type, Allocator>::empty()const
 {
     return used == 0;
 }
 
 /**
- * @brief erases the elements of the container 
+ * @brief returns the allocator of the container
+ * 
+ * @return const Allocator& 
+ */
+template <class Type, class Allocator>
+const Allocator& DynamicArray<Type, Allocator>::get_allocator()const
+{
+    return buffer.get_allocator();
+}
+
+/**
+ * @brief erases the elements of the container, keeping its capacity
+ *  - elements of non-trivial types are replaced by default values from the last one, so they release
+ *    their resources, this takes linear time and may throw
+ *  - if an exception is thrown, the array keeps only the elements that weren't replaced yet
  */
-template <class Type>
-void DynamicArray<Type>::clear()
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::clear()
+{
+    if(!std::is_trivially_destructible<Type>::value)
+    {
+        try
+        {
+            for(; used > 0; --used)
+            {
+                buffer[used - 1] = Type();
+            }
+        }
+        catch(...)
+        {
+            invalidate();
+            throw;
+        }
+    }
+
+    used = 0;
+    invalidate();
+}
+
+/**
+ * @brief erases the elements of the container and releases its storage
+ */
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::release()
 {
     buffer.clear();
 
     used = 0;
+    invalidate();
 }
 
 /**
@@ -316,19 +737,34 @@ void DynamicArray<Type>::clear()
  *  - if the size is equal to the current capacity it does nothing
  *  - if it is smaller -  resizes to the specified size
  *  - if it is bigger - chooses the bigger value between the doubled capacity and the specified size
+ *  - if an exception is thrown, the capacity may be changed but none of the new elements are added
  *  
  * @param size - new size of the array
  * @param value - value with which to fill the array
  */
-template <class Type>
-void DynamicArray<Type>::resize(size_t size, Type value)
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::resize(size_t size, Type value)
 {
     resizeBuffer(size);
+    append_n(buffer.size() - used, value);
+}
 
-    for(size_t i = used; i < buffer.size(); ++i)
-    {
-        push_back(value);
-    }
+/**
+ * @brief changes the number of the elements to a specific size without writing the new elements,
+ *  so that they can be overwritten by the caller without paying for an extra pass over the memory
+ *  - unlike resize, the size becomes exactly the specified one and the capacity only grows
+ *  - new elements of trivial types are left uninitialized, others are default values or earlier elements
+ *  - the array doesn't change if an exception is thrown
+ * 
+ * @param size - new size of the array
+ */
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::resize_default_init(size_t size)
+{
+    if(size > used)
+        appendWith(size - used, [](Type*) {});
+    else
+        used = size;
 }
 
 /**
@@ -339,8 +775,8 @@ void DynamicArray<Type>::resize(size_t size, Type value)
  * 
  * @param size - new size of the array
  */
-template <class Type>
-void DynamicArray<Type>::reserve(size_t size)
+template <class Type, class Allocator>
+void DynamicArray<Type, Allocator>::reserve(size_t size)
 {
     resizeBuffer(size);
 }
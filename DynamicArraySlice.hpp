@@ -0,0 +1,882 @@
+#ifndef _DYNAMIC_ARRAY_SLICE_
+#define _DYNAMIC_ARRAY_SLICE_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Hardening.hpp"
+
+template <class, class> class DynamicArray;
+template <class> class StridedSlice;
+template <class> class SliceChunks;
+
+/**
+ * @brief SliceOrigin class remembers the array a view was made from
+ *
+ *  At hardening level 2 it keeps a pointer to the generation counter of the array and the value of the counter
+ *  when the view was made, so every access through the view can check that the array hasn't reallocated its storage
+ *  since then. At lower levels it is empty.
+ */
+class SliceOrigin
+{
+private:
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    const size_t* generation;   ///generation counter of the array, nullptr if the view isn't made from an array
+    size_t observed;            ///value of the counter when the view was made
+#endif
+
+public:
+    SliceOrigin();
+    explicit SliceOrigin(const size_t*);
+
+public:
+    void check()const;
+    bool valid()const;
+};
+
+/**
+ * @brief DynamicArraySlice class is a class template of views of consecutive elements of a DynamicArray
+ *  or of other storage
+ *
+ *  A slice borrows the elements instead of copying them, so it is as cheap to pass around as a pointer and a size.
+ *  It is invalidated like the iterators of its array. At hardening level 2 every access through a slice of
+ *  a DynamicArray checks that, and at level 1 the indices are checked.
+ *
+ * @tparam Type - type of the elements, const for read-only slices
+ */
+template <class Type>
+class DynamicArraySlice
+{
+public:
+    typedef typename std::remove_const<Type>::type value_type;
+    typedef Type* iterator;
+
+private:
+    Type* first;
+    size_t count;
+    [[no_unique_address]] SliceOrigin origin;
+
+    template <class> friend class DynamicArraySlice;
+    template <class, class> friend class DynamicArray;
+    template <class> friend class SliceChunks;
+
+private:
+    DynamicArraySlice(Type*, size_t, SliceOrigin);
+
+public:
+    DynamicArraySlice();
+    DynamicArraySlice(Type*, size_t);
+    DynamicArraySlice(std::span<Type>);
+
+    template <class Other, class = typename std::enable_if<std::is_convertible<Other*, Type*>::value>::type>
+    DynamicArraySlice(const DynamicArraySlice<Other>&);
+
+public:
+    Type& operator[](size_t)const;
+    Type& at(size_t)const;
+
+    Type& front()const;
+    Type& back()const;
+
+    Type* data()const;
+    iterator begin()const;
+    iterator end()const;
+
+    size_t size()const;
+    bool empty()const;
+    bool valid()const;
+
+    DynamicArraySlice<Type> slice(size_t offset, size_t length)const;
+    StridedSlice<Type> strided(size_t offset, size_t count, size_t stride)const;
+    SliceChunks<Type> chunks(size_t size)const;
+
+    std::span<Type> span()const;
+    operator std::span<Type>()const;
+};
+
+/**
+ * @brief StridedSlice class is a class template of views of every n-th element of a DynamicArraySlice,
+ *  e.g. of a column of a matrix stored by rows
+ *
+ * @tparam Type - type of the elements, const for read-only slices
+ */
+template <class Type>
+class StridedSlice
+{
+public:
+    typedef typename std::remove_const<Type>::type value_type;
+
+    class iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename std::remove_const<Type>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Type* pointer;
+        typedef Type& reference;
+
+    private:
+        Type* base;                 ///the first element of the view
+        difference_type index;      ///index of the element within the view, its address is only formed when accessed
+        difference_type stride;
+
+    public:
+        iterator();
+        iterator(Type*, size_t, size_t);
+
+    public:
+        reference operator*()const;
+        pointer operator->()const;
+        reference operator[](difference_type)const;
+
+        iterator& operator++();
+        iterator operator++(int);
+        iterator& operator--();
+        iterator operator--(int);
+
+        iterator& operator+=(difference_type);
+        iterator& operator-=(difference_type);
+        iterator operator+(difference_type)const;
+        iterator operator-(difference_type)const;
+        difference_type operator-(const iterator&)const;
+
+        bool operator==(const iterator&)const;
+        bool operator!=(const iterator&)const;
+        bool operator<(const iterator&)const;
+        bool operator>(const iterator&)const;
+        bool operator<=(const iterator&)const;
+        bool operator>=(const iterator&)const;
+
+        friend iterator operator+(difference_type offset, const iterator& other)
+        {
+            return other + offset;
+        }
+    };
+
+private:
+    Type* first;
+    size_t count;
+    size_t step;
+    [[no_unique_address]] SliceOrigin origin;
+
+public:
+    StridedSlice(Type*, size_t, size_t, SliceOrigin);
+
+public:
+    Type& operator[](size_t)const;
+    Type& at(size_t)const;
+
+    iterator begin()const;
+    iterator end()const;
+
+    size_t size()const;
+    size_t stride()const;
+    bool empty()const;
+    bool valid()const;
+};
+
+/**
+ * @brief SliceChunks class is a class template of the consecutive chunks of a slice with a given size,
+ *  the last one may be shorter
+ *
+ * @tparam Type - type of the elements, const for read-only slices
+ */
+template <class Type>
+class SliceChunks
+{
+public:
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef DynamicArraySlice<Type> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef DynamicArraySlice<Type> reference;
+
+    private:
+        const SliceChunks<Type>* chunks;
+        size_t index;
+
+    public:
+        iterator(const SliceChunks<Type>*, size_t);
+
+    public:
+        DynamicArraySlice<Type> operator*()const;
+        iterator& operator++();
+        iterator operator++(int);
+
+        bool operator==(const iterator&)const;
+        bool operator!=(const iterator&)const;
+    };
+
+private:
+    DynamicArraySlice<Type> whole;
+    size_t chunk;
+
+public:
+    SliceChunks(const DynamicArraySlice<Type>&, size_t);
+
+public:
+    DynamicArraySlice<Type> operator[](size_t)const;
+
+    iterator begin()const;
+    iterator end()const;
+
+    size_t size()const;
+    bool empty()const;
+};
+
+/**
+ * @brief checks if a pointer points into a range, e.g. into the storage of an array that is about to grow
+ *
+ * @param pointer - the pointer
+ * @param first - pointer to the first element of the range
+ * @param count - number of the elements of the range
+ * @return true - if the pointer points to an element of the range
+ * @return false - otherwise
+ */
+template <class Type>
+bool pointsInto(const Type* pointer, const Type* first, size_t count)
+{
+    return std::less_equal<const Type*>()(first, pointer) && std::less<const Type*>()(pointer, first + count);
+}
+
+/**
+ * @brief Construct a new Slice Origin object of a view that isn't made from an array
+ */
+inline SliceOrigin::SliceOrigin()
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    : generation(nullptr), observed(0)
+#endif
+{
+
+}
+
+/**
+ * @brief Construct a new Slice Origin object of a view of an array
+ *
+ * @param generation - the generation counter of the array
+ */
+inline SliceOrigin::SliceOrigin([[maybe_unused]] const size_t* generation)
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    : generation(generation), observed(generation ? *generation : 0)
+#endif
+{
+
+}
+
+/**
+ * @brief checks that the array of the view hasn't invalidated it
+ */
+inline void SliceOrigin::check()const
+{
+    DYNAMIC_ARRAY_CHECK(valid());
+}
+
+/**
+ * @brief checks if the array of the view hasn't invalidated it, always true below hardening level 2
+ *
+ * @return true - if the view is valid or it can't be checked
+ * @return false - if the array invalidated the view
+ */
+inline bool SliceOrigin::valid()const
+{
+#if DYNAMIC_ARRAY_HARDENING >= 2
+    return generation == nullptr || *generation == observed;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @brief Construct a new empty Dynamic Array Slice object
+ */
+template <class Type>
+DynamicArraySlice<Type>::DynamicArraySlice() : first(nullptr), count(0)
+{
+
+}
+
+/**
+ * @brief Construct a new Dynamic Array Slice object of other storage, it can't be checked for invalidation
+ *
+ * @param first - pointer to the first element
+ * @param count - number of the elements
+ */
+template <class Type>
+DynamicArraySlice<Type>::DynamicArraySlice(Type* first, size_t count) : first(first), count(count)
+{
+
+}
+
+/**
+ * @brief Construct a new Dynamic Array Slice object of the elements of a span
+ *
+ * @param elements - the span
+ */
+template <class Type>
+DynamicArraySlice<Type>::DynamicArraySlice(std::span<Type> elements) : first(elements.data()), count(elements.size())
+{
+
+}
+
+/**
+ * @brief Construct a new Dynamic Array Slice object that remembers the array it is made from
+ *
+ * @param first - pointer to the first element
+ * @param count - number of the elements
+ * @param origin - origin of the elements
+ */
+template <class Type>
+DynamicArraySlice<Type>::DynamicArraySlice(Type* first, size_t count, SliceOrigin origin) : first(first), count(count), origin(origin)
+{
+
+}
+
+/**
+ * @brief Construct a new read-only Dynamic Array Slice object from a mutable one
+ *
+ * @param other - the mutable slice
+ */
+template <class Type>
+template <class Other, class>
+DynamicArraySlice<Type>::DynamicArraySlice(const DynamicArraySlice<Other>& other) : first(other.first), count(other.count), origin(other.origin)
+{
+
+}
+
+/**
+ * @brief returns a reference to the element at an index
+ *
+ * @param index - the index
+ * @return Type&
+ */
+template <class Type>
+Type& DynamicArraySlice<Type>::operator[](size_t index)const
+{
+    origin.check();
+    DYNAMIC_ARRAY_CHECK(index < count);
+    return first[index];
+}
+
+/**
+ * @brief returns a reference to the element at an index with a bounds check
+ *
+ * @param index - the index
+ * @return Type&
+ */
+template <class Type>
+Type& DynamicArraySlice<Type>::at(size_t index)const
+{
+    if(index >= count)
+        throw std::out_of_range("The index is out of range!");
+    return (*this)[index];
+}
+
+/**
+ * @brief returns a reference to the first element
+ *
+ * @return Type&
+ */
+template <class Type>
+Type& DynamicArraySlice<Type>::front()const
+{
+    if(empty())
+        throw std::out_of_range("The slice is empty!");
+    return (*this)[0];
+}
+
+/**
+ * @brief returns a reference to the last element
+ *
+ * @return Type&
+ */
+template <class Type>
+Type& DynamicArraySlice<Type>::back()const
+{
+    if(empty())
+        throw std::out_of_range("The slice is empty!");
+    return (*this)[count - 1];
+}
+
+/**
+ * @brief returns a pointer to the first element
+ *
+ * @return Type*
+ */
+template <class Type>
+Type* DynamicArraySlice<Type>::data()const
+{
+    origin.check();
+    return first;
+}
+
+/**
+ * @brief returns an iterator to the first element, the iterators are plain pointers checked when they are made
+ *
+ * @return iterator
+ */
+template <class Type>
+typename DynamicArraySlice<Type>::iterator DynamicArraySlice<Type>::begin()const
+{
+    return data();
+}
+
+/**
+ * @brief returns an iterator past the last element
+ *
+ * @return iterator
+ */
+template <class Type>
+typename DynamicArraySlice<Type>::iterator DynamicArraySlice<Type>::end()const
+{
+    return data() + count;
+}
+
+/**
+ * @brief returns the number of the elements
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t DynamicArraySlice<Type>::size()const
+{
+    return count;
+}
+
+/**
+ * @brief checks if the slice has no elements
+ *
+ * @return true - if it is empty
+ * @return false - otherwise
+ */
+template <class Type>
+bool DynamicArraySlice<Type>::empty()const
+{
+    return count == 0;
+}
+
+/**
+ * @brief checks if the array of the slice hasn't invalidated it, always true below hardening level 2
+ *
+ * @return true - if the slice is valid or it can't be checked
+ * @return false - if it was invalidated
+ */
+template <class Type>
+bool DynamicArraySlice<Type>::valid()const
+{
+    return origin.valid();
+}
+
+/**
+ * @brief returns a slice of a part of the slice
+ *
+ * @param offset - index of the first element of the part
+ * @param length - number of the elements of the part
+ * @return DynamicArraySlice<Type>
+ */
+template <class Type>
+DynamicArraySlice<Type> DynamicArraySlice<Type>::slice(size_t offset, size_t length)const
+{
+    origin.check();
+    if(offset > count || length > count - offset)
+        throw std::out_of_range("The slice is out of range!");
+    return DynamicArraySlice<Type>(first + offset, length, origin);
+}
+
+/**
+ * @brief returns a view of every stride-th element of the slice
+ *
+ * @param offset - index of the first element of the view
+ * @param count - number of the elements of the view
+ * @param stride - distance between the elements of the view
+ * @return StridedSlice<Type>
+ */
+template <class Type>
+StridedSlice<Type> DynamicArraySlice<Type>::strided(size_t offset, size_t count, size_t stride)const
+{
+    origin.check();
+    if(stride == 0)
+        throw std::invalid_argument("The stride must not be 0!");
+    if(offset > this->count || (count > 0 && (offset == this->count || count - 1 > (this->count - offset - 1) / stride)))
+        throw std::out_of_range("The slice is out of range!");
+    return StridedSlice<Type>(first + offset, count, stride, origin);
+}
+
+/**
+ * @brief returns the consecutive chunks of the slice
+ *
+ * @param size - number of the elements of a chunk, the last one may be shorter
+ * @return SliceChunks<Type>
+ */
+template <class Type>
+SliceChunks<Type> DynamicArraySlice<Type>::chunks(size_t size)const
+{
+    return SliceChunks<Type>(*this, size);
+}
+
+/**
+ * @brief returns the elements as a span
+ *
+ * @return std::span<Type>
+ */
+template <class Type>
+std::span<Type> DynamicArraySlice<Type>::span()const
+{
+    return std::span<Type>(data(), count);
+}
+
+template <class Type>
+DynamicArraySlice<Type>::operator std::span<Type>()const
+{
+    return span();
+}
+
+/**
+ * @brief Construct a new Strided Slice object
+ *
+ * @param first - pointer to the first element
+ * @param count - number of the elements
+ * @param step - distance between the elements
+ * @param origin - origin of the elements
+ */
+template <class Type>
+StridedSlice<Type>::StridedSlice(Type* first, size_t count, size_t step, SliceOrigin origin)
+    : first(first), count(count), step(step), origin(origin)
+{
+
+}
+
+/**
+ * @brief returns a reference to the element at an index
+ *
+ * @param index - the index
+ * @return Type&
+ */
+template <class Type>
+Type& StridedSlice<Type>::operator[](size_t index)const
+{
+    origin.check();
+    DYNAMIC_ARRAY_CHECK(index < count);
+    return first[index * step];
+}
+
+/**
+ * @brief returns a reference to the element at an index with a bounds check
+ *
+ * @param index - the index
+ * @return Type&
+ */
+template <class Type>
+Type& StridedSlice<Type>::at(size_t index)const
+{
+    if(index >= count)
+        throw std::out_of_range("The index is out of range!");
+    return (*this)[index];
+}
+
+/**
+ * @brief returns an iterator to the first element
+ *
+ * @return iterator
+ */
+template <class Type>
+typename StridedSlice<Type>::iterator StridedSlice<Type>::begin()const
+{
+    origin.check();
+    return iterator(first, 0, step);
+}
+
+/**
+ * @brief returns an iterator past the last element, it doesn't form the address past the last element,
+ *  which can be beyond the end of the array if the stride doesn't divide the rest of the array
+ *
+ * @return iterator
+ */
+template <class Type>
+typename StridedSlice<Type>::iterator StridedSlice<Type>::end()const
+{
+    origin.check();
+    return iterator(first, count, step);
+}
+
+template <class Type>
+size_t StridedSlice<Type>::size()const
+{
+    return count;
+}
+
+template <class Type>
+size_t StridedSlice<Type>::stride()const
+{
+    return step;
+}
+
+template <class Type>
+bool StridedSlice<Type>::empty()const
+{
+    return count == 0;
+}
+
+/**
+ * @brief checks if the array of the view hasn't invalidated it, always true below hardening level 2
+ *
+ * @return true - if the view is valid or it can't be checked
+ * @return false - if it was invalidated
+ */
+template <class Type>
+bool StridedSlice<Type>::valid()const
+{
+    return origin.valid();
+}
+
+/**
+ * @brief Construct a new iterator object that doesn't point to any element
+ */
+template <class Type>
+StridedSlice<Type>::iterator::iterator() : base(nullptr), index(0), stride(1)
+{
+
+}
+
+/**
+ * @brief Construct a new iterator object
+ *
+ * @param base - pointer to the first element of the view
+ * @param index - index of the element within the view
+ * @param stride - distance between the elements
+ */
+template <class Type>
+StridedSlice<Type>::iterator::iterator(Type* base, size_t index, size_t stride)
+    : base(base), index(difference_type(index)), stride(difference_type(stride))
+{
+
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator::reference StridedSlice<Type>::iterator::operator*()const
+{
+    return base[index * stride];
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator::pointer StridedSlice<Type>::iterator::operator->()const
+{
+    return base + index * stride;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator::reference StridedSlice<Type>::iterator::operator[](difference_type offset)const
+{
+    return base[(index + offset) * stride];
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator& StridedSlice<Type>::iterator::operator++()
+{
+    ++index;
+    return *this;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator StridedSlice<Type>::iterator::operator++(int)
+{
+    iterator previous = *this;
+    ++index;
+    return previous;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator& StridedSlice<Type>::iterator::operator--()
+{
+    --index;
+    return *this;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator StridedSlice<Type>::iterator::operator--(int)
+{
+    iterator previous = *this;
+    --index;
+    return previous;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator& StridedSlice<Type>::iterator::operator+=(difference_type offset)
+{
+    index += offset;
+    return *this;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator& StridedSlice<Type>::iterator::operator-=(difference_type offset)
+{
+    index -= offset;
+    return *this;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator StridedSlice<Type>::iterator::operator+(difference_type offset)const
+{
+    iterator moved = *this;
+    return moved += offset;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator StridedSlice<Type>::iterator::operator-(difference_type offset)const
+{
+    iterator moved = *this;
+    return moved -= offset;
+}
+
+template <class Type>
+typename StridedSlice<Type>::iterator::difference_type StridedSlice<Type>::iterator::operator-(const iterator& other)const
+{
+    return index - other.index;
+}
+
+template <class Type>
+bool StridedSlice<Type>::iterator::operator==(const iterator& other)const
+{
+    return index == other.index;
+}
+
+template <class Type>
+bool StridedSlice<Type>::iterator::operator!=(const iterator& other)const
+{
+    return index != other.index;
+}
+
+template <class Type>
+bool StridedSlice<Type>::iterator::operator<(const iterator& other)const
+{
+    return index < other.index;
+}
+
+template <class Type>
+bool StridedSlice<Type>::iterator::operator>(const iterator& other)const
+{
+    return index > other.index;
+}
+
+template <class Type>
+bool StridedSlice<Type>::iterator::operator<=(const iterator& other)const
+{
+    return index <= other.index;
+}
+
+template <class Type>
+bool StridedSlice<Type>::iterator::operator>=(const iterator& other)const
+{
+    return index >= other.index;
+}
+
+/**
+ * @brief Construct a new Slice Chunks object
+ *
+ * @param whole - the slice to be split
+ * @param chunk - number of the elements of a chunk
+ */
+template <class Type>
+SliceChunks<Type>::SliceChunks(const DynamicArraySlice<Type>& whole, size_t chunk) : whole(whole), chunk(chunk)
+{
+    if(chunk == 0)
+        throw std::invalid_argument("The chunks must not be empty!");
+}
+
+/**
+ * @brief returns the chunk at an index
+ *
+ * @param index - the index
+ * @return DynamicArraySlice<Type>
+ */
+template <class Type>
+DynamicArraySlice<Type> SliceChunks<Type>::operator[](size_t index)const
+{
+    if(index >= size())
+        throw std::out_of_range("The index is out of range!");
+
+    size_t offset = index * chunk;
+    return whole.slice(offset, chunk < whole.size() - offset ? chunk : whole.size() - offset);
+}
+
+template <class Type>
+typename SliceChunks<Type>::iterator SliceChunks<Type>::begin()const
+{
+    return iterator(this, 0);
+}
+
+template <class Type>
+typename SliceChunks<Type>::iterator SliceChunks<Type>::end()const
+{
+    return iterator(this, size());
+}
+
+/**
+ * @brief returns the number of the chunks
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t SliceChunks<Type>::size()const
+{
+    return whole.size() / chunk + (whole.size() % chunk > 0 ? 1 : 0);
+}
+
+template <class Type>
+bool SliceChunks<Type>::empty()const
+{
+    return whole.empty();
+}
+
+/**
+ * @brief Construct a new iterator object
+ *
+ * @param chunks - the chunks
+ * @param index - index of the chunk
+ */
+template <class Type>
+SliceChunks<Type>::iterator::iterator(const SliceChunks<Type>* chunks, size_t index) : chunks(chunks), index(index)
+{
+
+}
+
+template <class Type>
+DynamicArraySlice<Type> SliceChunks<Type>::iterator::operator*()const
+{
+    return (*chunks)[index];
+}
+
+template <class Type>
+typename SliceChunks<Type>::iterator& SliceChunks<Type>::iterator::operator++()
+{
+    ++index;
+    return *this;
+}
+
+template <class Type>
+typename SliceChunks<Type>::iterator SliceChunks<Type>::iterator::operator++(int)
+{
+    iterator previous = *this;
+    ++index;
+    return previous;
+}
+
+template <class Type>
+bool SliceChunks<Type>::iterator::operator==(const iterator& other)const
+{
+    return index == other.index;
+}
+
+template <class Type>
+bool SliceChunks<Type>::iterator::operator!=(const iterator& other)const
+{
+    return index != other.index;
+}
+
+#endif
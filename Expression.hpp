@@ -0,0 +1,958 @@
+#ifndef _EXPRESSION_
+#define _EXPRESSION_
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "DynamicArray.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Lazy element-wise arithmetic over arrays of numbers. The operators and functions below don't compute anything,
+ * they build an expression that refers to its arrays. The expression is computed in a single loop over all
+ * operations when it is assigned to a DynamicArray or reduced, without temporary arrays:
+ *
+ *     DynamicArray<double> y = a * x + b - c;     // one pass over a, x and c, one allocation
+ *     assign(y, select(x > 0.0, sqrt(x), -x));    // reuses the storage of y
+ *     double total = sum(a * x);                  // no array at all
+ *
+ * The arrays of an expression must outlive it and have the same size. Equality is element-wise through equal and
+ * not_equal, so == keeps its usual meaning.
+ */
+
+/**
+ * @brief Expression class is the base of all expressions, it converts them into arrays
+ *
+ * @tparam Derived - type of the expression
+ */
+template <class Derived>
+class Expression
+{
+public:
+    const Derived& derived()const;
+
+    template <class Type, class Allocator>
+    operator DynamicArray<Type, Allocator>()const;
+};
+
+/**
+ * @brief ArrayOperand class is a class template of references to the arrays and slices of expressions
+ *
+ * @tparam Type - type of the elements
+ */
+template <class Type>
+class ArrayOperand
+{
+public:
+    typedef Type value_type;
+    static const bool SCALAR = false;
+
+private:
+    const Type* values;
+    size_t count;
+
+public:
+    template <class Allocator>
+    explicit ArrayOperand(const DynamicArray<Type, Allocator>&);
+    explicit ArrayOperand(DynamicArraySlice<const Type>);
+
+public:
+    Type operator[](size_t)const;
+    size_t size()const;
+
+    template <class Value>
+    bool overlaps(const Value*, size_t)const;
+};
+
+/**
+ * @brief ScalarOperand class is a class template of numbers used with every element of an expression
+ *
+ * @tparam Type - type of the number
+ */
+template <class Type>
+class ScalarOperand
+{
+public:
+    typedef Type value_type;
+    static const bool SCALAR = true;
+
+private:
+    Type value;
+
+public:
+    explicit ScalarOperand(Type);
+
+public:
+    Type operator[](size_t)const;
+    size_t size()const;
+
+    template <class Value>
+    bool overlaps(const Value*, size_t)const;
+};
+
+/**
+ * @brief ElementwiseExpression class is a class template of expressions that apply an operation to the elements
+ *  of their operands at the same index
+ *
+ * @tparam Operation - the operation, a function object
+ * @tparam Operands - the operands, arrays, numbers or other expressions
+ */
+template <class Operation, class... Operands>
+class ElementwiseExpression : public Expression<ElementwiseExpression<Operation, Operands...>>
+{
+public:
+    typedef decltype(Operation()(std::declval<typename Operands::value_type>()...)) value_type;
+    static const bool SCALAR = false;
+
+private:
+    std::tuple<Operands...> operands;
+    size_t count;
+
+private:
+    static size_t commonSize(const Operands&...);
+
+public:
+    explicit ElementwiseExpression(const Operands&...);
+
+public:
+    value_type operator[](size_t)const;
+    size_t size()const;
+
+    template <class Value>
+    bool overlaps(const Value*, size_t)const;
+};
+
+/**
+ * operations of the expressions
+ */
+struct AddOperation
+{
+    template <class Left, class Right>
+    auto operator()(Left left, Right right)const { return left + right; }
+};
+
+struct SubtractOperation
+{
+    template <class Left, class Right>
+    auto operator()(Left left, Right right)const { return left - right; }
+};
+
+struct MultiplyOperation
+{
+    template <class Left, class Right>
+    auto operator()(Left left, Right right)const { return left * right; }
+};
+
+struct DivideOperation
+{
+    template <class Left, class Right>
+    auto operator()(Left left, Right right)const { return left / right; }
+};
+
+struct NegateOperation
+{
+    template <class Value>
+    auto operator()(Value value)const { return -value; }
+};
+
+struct LessOperation
+{
+    template <class Left, class Right>
+    bool operator()(Left left, Right right)const { return left < right; }
+};
+
+struct LessEqualOperation
+{
+    template <class Left, class Right>
+    bool operator()(Left left, Right right)const { return left <= right; }
+};
+
+struct GreaterOperation
+{
+    template <class Left, class Right>
+    bool operator()(Left left, Right right)const { return left > right; }
+};
+
+struct GreaterEqualOperation
+{
+    template <class Left, class Right>
+    bool operator()(Left left, Right right)const { return left >= right; }
+};
+
+struct EqualOperation
+{
+    template <class Left, class Right>
+    bool operator()(Left left, Right right)const { return left == right; }
+};
+
+struct NotEqualOperation
+{
+    template <class Left, class Right>
+    bool operator()(Left left, Right right)const { return left != right; }
+};
+
+struct MinimumOperation
+{
+    template <class Left, class Right>
+    auto operator()(Left left, Right right)const { return right < left ? right : left; }
+};
+
+struct MaximumOperation
+{
+    template <class Left, class Right>
+    auto operator()(Left left, Right right)const { return left < right ? right : left; }
+};
+
+struct SquareRootOperation
+{
+    template <class Value>
+    auto operator()(Value value)const { return std::sqrt(value); }
+};
+
+struct AbsoluteOperation
+{
+    template <class Value>
+    auto operator()(Value value)const { return value < 0 ? -value : value; }
+};
+
+struct SelectOperation
+{
+    template <class Condition, class Left, class Right>
+    auto operator()(Condition condition, Left left, Right right)const { return condition ? left : right; }
+};
+
+/**
+ * @brief tells if a type can be an array operand of an expression - a DynamicArray or a slice of numbers
+ *  or an expression
+ */
+template <class Type>
+struct IsArrayOperand : std::is_base_of<Expression<Type>, Type>
+{
+
+};
+
+template <class Type, class Allocator>
+struct IsArrayOperand<DynamicArray<Type, Allocator>> : std::is_arithmetic<Type>
+{
+
+};
+
+template <class Type>
+struct IsArrayOperand<DynamicArraySlice<Type>> : std::is_arithmetic<typename std::remove_const<Type>::type>
+{
+
+};
+
+/**
+ * @brief tells if types can be operands of an operation - array operands or numbers, at least one of them an array
+ */
+template <class... Types>
+struct IsOperation : std::bool_constant<(... || IsArrayOperand<Types>::value) &&
+                                        (... && (IsArrayOperand<Types>::value || std::is_arithmetic<Types>::value))>
+{
+
+};
+
+/**
+ * @brief returns the operand of an array
+ *
+ * @param array - the array
+ * @return ArrayOperand<Type>
+ */
+template <class Type, class Allocator>
+ArrayOperand<Type> operandOf(const DynamicArray<Type, Allocator>& array)
+{
+    return ArrayOperand<Type>(array);
+}
+
+/**
+ * @brief returns the operand of a slice
+ *
+ * @param slice - the slice
+ * @return ArrayOperand
+ */
+template <class Type>
+ArrayOperand<typename std::remove_const<Type>::type> operandOf(DynamicArraySlice<Type> slice)
+{
+    return ArrayOperand<typename std::remove_const<Type>::type>(slice);
+}
+
+/**
+ * @brief returns the operand of an expression, the expression itself
+ *
+ * @param expression - the expression
+ * @return const Derived&
+ */
+template <class Derived>
+const Derived& operandOf(const Expression<Derived>& expression)
+{
+    return expression.derived();
+}
+
+/**
+ * @brief returns the operand of a number
+ *
+ * @param value - the number
+ * @return ScalarOperand<Type>
+ */
+template <class Type, class = typename std::enable_if<std::is_arithmetic<Type>::value>::type>
+ScalarOperand<Type> operandOf(Type value)
+{
+    return ScalarOperand<Type>(value);
+}
+
+template <class Type>
+using OperandType = typename std::decay<decltype(operandOf(std::declval<const Type&>()))>::type;
+
+/**
+ * @brief builds an element-wise expression of an operation and its arguments
+ *
+ * @param arguments - arrays, numbers or expressions
+ * @return ElementwiseExpression
+ */
+template <class Operation, class... Arguments>
+ElementwiseExpression<Operation, OperandType<Arguments>...> makeExpression(const Arguments&... arguments)
+{
+    return ElementwiseExpression<Operation, OperandType<Arguments>...>(operandOf(arguments)...);
+}
+
+/**
+ * @brief returns an expression of the sums of the elements
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator+(const Left& left, const Right& right)
+{
+    return makeExpression<AddOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the differences of the elements
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator-(const Left& left, const Right& right)
+{
+    return makeExpression<SubtractOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the products of the elements
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator*(const Left& left, const Right& right)
+{
+    return makeExpression<MultiplyOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the quotients of the elements
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator/(const Left& left, const Right& right)
+{
+    return makeExpression<DivideOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of if the left elements are smaller
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator<(const Left& left, const Right& right)
+{
+    return makeExpression<LessOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of if the left elements are smaller or equal
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator<=(const Left& left, const Right& right)
+{
+    return makeExpression<LessEqualOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of if the left elements are greater
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator>(const Left& left, const Right& right)
+{
+    return makeExpression<GreaterOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of if the left elements are greater or equal
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto operator>=(const Left& left, const Right& right)
+{
+    return makeExpression<GreaterEqualOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the negated elements
+ *
+ * @param operand - array or expression
+ * @return ElementwiseExpression
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+auto operator-(const Operand& operand)
+{
+    return makeExpression<NegateOperation>(operand);
+}
+
+/**
+ * @brief returns an expression of if the elements are equal
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto equal(const Left& left, const Right& right)
+{
+    return makeExpression<EqualOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of if the elements differ
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto not_equal(const Left& left, const Right& right)
+{
+    return makeExpression<NotEqualOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the smaller elements
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto min(const Left& left, const Right& right)
+{
+    return makeExpression<MinimumOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the larger elements
+ *
+ * @param left - array, number or expression
+ * @param right - array, number or expression
+ * @return ElementwiseExpression
+ */
+template <class Left, class Right, class = typename std::enable_if<IsOperation<Left, Right>::value>::type>
+auto max(const Left& left, const Right& right)
+{
+    return makeExpression<MaximumOperation>(left, right);
+}
+
+/**
+ * @brief returns an expression of the square roots of the elements
+ *
+ * @param operand - array or expression
+ * @return ElementwiseExpression
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+auto sqrt(const Operand& operand)
+{
+    return makeExpression<SquareRootOperation>(operand);
+}
+
+/**
+ * @brief returns an expression of the absolute values of the elements
+ *
+ * @param operand - array or expression
+ * @return ElementwiseExpression
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+auto abs(const Operand& operand)
+{
+    return makeExpression<AbsoluteOperation>(operand);
+}
+
+/**
+ * @brief returns an expression that chooses the elements of one of two operands by a condition,
+ *  both operands are computed for every element
+ *
+ * @param condition - array, number or expression, usually a comparison
+ * @param left - array, number or expression chosen where the condition is true
+ * @param right - array, number or expression chosen where the condition is false
+ * @return ElementwiseExpression
+ */
+template <class Condition, class Left, class Right,
+          class = typename std::enable_if<IsOperation<Condition, Left, Right>::value>::type>
+auto select(const Condition& condition, const Left& left, const Right& right)
+{
+    return makeExpression<SelectOperation>(condition, left, right);
+}
+
+/**
+ * @brief computes the elements of an expression at a range of indices in one loop, the target may be the same
+ *  range as an operand of the expression since every element only depends on the operands at the same index,
+ *  but it must not overlap an operand otherwise
+ *
+ * @param source - the expression
+ * @param target - pointer to the first element of the result
+ * @param first - the first index
+ * @param last - the index past the last one
+ */
+template <class Source, class Value>
+void evaluateRange(const Source& source, Value* target, size_t first, size_t last)
+{
+#if defined(__clang__)
+#pragma clang loop vectorize(assume_safety)
+#elif defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+    for(size_t i = first; i < last; ++i)
+    {
+        target[i] = source[i];
+    }
+}
+
+/**
+ * @brief computes an expression into a slice of the same size
+ *  - if the slice overlaps an operand without being the same slice, the expression is computed into
+ *    a temporary array first, so every element is computed from the operands before the assignment
+ *
+ * @param out - the slice, it may be the same slice as an operand of the expression
+ * @param expression - the expression
+ */
+template <class Type, class Derived>
+void assign(DynamicArraySlice<Type> out, const Expression<Derived>& expression)
+{
+    const Derived& source = expression.derived();
+    if(out.size() != source.size())
+        throw std::invalid_argument("The operands have different sizes!");
+
+    if(source.overlaps(out.data(), out.size()))
+    {
+        DynamicArray<Type> temporary;
+        assign(temporary, expression);
+        std::copy(temporary.begin(), temporary.end(), out.data());
+        return;
+    }
+
+    evaluateRange(source, out.data(), 0, source.size());
+}
+
+/**
+ * @brief computes an expression into an array, replacing its elements and reusing its storage if it is large enough
+ *
+ * @param out - the array, it may be one of the arrays of the expression
+ * @param expression - the expression
+ */
+template <class Type, class Allocator, class Derived>
+void assign(DynamicArray<Type, Allocator>& out, const Expression<Derived>& expression)
+{
+    out.resize_default_init(expression.derived().size());
+    assign(out.slice(), expression);
+}
+
+/**
+ * @brief computes an expression into a slice of the same size using several threads, every thread computes
+ *  one chunk of the elements, small expressions are computed by one thread
+ *  - if the slice overlaps an operand without being the same slice, the expression is computed into
+ *    a temporary array first, so every element is computed from the operands before the assignment
+ *
+ * @param out - the slice, it may be the same slice as an operand of the expression
+ * @param expression - the expression
+ * @param threads - number of threads to be used
+ */
+template <class Type, class Derived>
+void parallel_assign(DynamicArraySlice<Type> out, const Expression<Derived>& expression, size_t threads = parallelThreads())
+{
+    const Derived& source = expression.derived();
+    size_t size = source.size();
+    threads = limitThreads(size, threads);
+
+    if(threads <= 1)
+    {
+        assign(out, expression);
+        return;
+    }
+
+    if(out.size() != size)
+        throw std::invalid_argument("The operands have different sizes!");
+
+    if(source.overlaps(out.data(), out.size()))
+    {
+        DynamicArray<Type> temporary;
+        parallel_assign(temporary, expression, threads);
+        std::copy(temporary.begin(), temporary.end(), out.data());
+        return;
+    }
+
+    Type* target = out.data();
+    runParallelRanges(size, threads, [&](size_t first, size_t last)
+    {
+        evaluateRange(source, target, first, last);
+    });
+}
+
+/**
+ * @brief computes an expression into an array using several threads, every thread computes one chunk
+ *  of the elements, small expressions are computed by one thread
+ *
+ * @param out - the array, it may be one of the arrays of the expression
+ * @param expression - the expression
+ * @param threads - number of threads to be used
+ */
+template <class Type, class Allocator, class Derived>
+void parallel_assign(DynamicArray<Type, Allocator>& out, const Expression<Derived>& expression, size_t threads = parallelThreads())
+{
+    out.resize_default_init(expression.derived().size());
+    parallel_assign(out.slice(), expression, threads);
+}
+
+/**
+ * @brief number of the independent accumulators of the reductions, so that they are vectorized
+ *  without reordering the operations of one accumulator
+ */
+const size_t REDUCTION_LANES = 8;
+
+/**
+ * @brief combines the elements of an expression with a function in REDUCTION_LANES interleaved accumulators
+ *  and merges the accumulators in the end
+ *
+ * @param source - the expression
+ * @param initial - the initial value of every accumulator
+ * @param combine - function that combines an accumulator with an element
+ * @param merge - function that merges two accumulators
+ * @return Result
+ */
+template <class Result, class Source, class Combine, class Merge>
+Result reduceLanes(const Source& source, Result initial, Combine combine, Merge merge)
+{
+    Result lanes[REDUCTION_LANES];
+    for(size_t lane = 0; lane < REDUCTION_LANES; ++lane)
+    {
+        lanes[lane] = initial;
+    }
+
+    size_t size = source.size();
+    size_t i = 0;
+    for(; i + REDUCTION_LANES <= size; i += REDUCTION_LANES)
+    {
+        for(size_t lane = 0; lane < REDUCTION_LANES; ++lane)
+        {
+            lanes[lane] = combine(lanes[lane], source[i + lane]);
+        }
+    }
+    for(; i < size; ++i)
+    {
+        lanes[0] = combine(lanes[0], source[i]);
+    }
+
+    Result result = lanes[0];
+    for(size_t lane = 1; lane < REDUCTION_LANES; ++lane)
+    {
+        result = merge(result, lanes[lane]);
+    }
+    return result;
+}
+
+/**
+ * @brief returns the sum of the elements, the elements are added in REDUCTION_LANES interleaved sums,
+ *  so floating-point results may differ slightly from a sequential sum
+ *
+ * @param operand - array or expression
+ * @return the sum, 0 if there are no elements
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+auto sum(const Operand& operand)
+{
+    const OperandType<Operand>& source = operandOf(operand);
+    typedef typename OperandType<Operand>::value_type Value;
+    typedef decltype(std::declval<Value>() + std::declval<Value>()) Sum;
+
+    return reduceLanes(source, Sum(0), AddOperation(), AddOperation());
+}
+
+/**
+ * @brief returns the smallest element
+ *
+ * @param operand - array or expression, it must not be empty
+ * @return the element
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+auto min_of(const Operand& operand)
+{
+    const OperandType<Operand>& source = operandOf(operand);
+    if(source.size() == 0)
+        throw std::out_of_range("The expression is empty!");
+
+    return reduceLanes(source, source[0], MinimumOperation(), MinimumOperation());
+}
+
+/**
+ * @brief returns the largest element
+ *
+ * @param operand - array or expression, it must not be empty
+ * @return the element
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+auto max_of(const Operand& operand)
+{
+    const OperandType<Operand>& source = operandOf(operand);
+    if(source.size() == 0)
+        throw std::out_of_range("The expression is empty!");
+
+    return reduceLanes(source, source[0], MaximumOperation(), MaximumOperation());
+}
+
+/**
+ * @brief returns the number of the elements that aren't zero or false, e.g. of the true results of a comparison
+ *
+ * @param operand - array or expression
+ * @return size_t
+ */
+template <class Operand, class = typename std::enable_if<IsArrayOperand<Operand>::value>::type>
+size_t count_nonzero(const Operand& operand)
+{
+    const OperandType<Operand>& source = operandOf(operand);
+    auto countNonzero = [](size_t count, auto value) { return count + (value != 0 ? 1 : 0); };
+
+    return reduceLanes(source, size_t(0), countNonzero, AddOperation());
+}
+
+/**
+ * @brief returns the expression as its derived type
+ *
+ * @return const Derived&
+ */
+template <class Derived>
+const Derived& Expression<Derived>::derived()const
+{
+    return static_cast<const Derived&>(*this);
+}
+
+/**
+ * @brief computes the expression into a new array
+ *
+ * @return DynamicArray<Type, Allocator>
+ */
+template <class Derived>
+template <class Type, class Allocator>
+Expression<Derived>::operator DynamicArray<Type, Allocator>()const
+{
+    DynamicArray<Type, Allocator> array;
+    assign(array, *this);
+    return array;
+}
+
+/**
+ * @brief Construct a new Array Operand object
+ *
+ * @param array - the array
+ */
+template <class Type>
+template <class Allocator>
+ArrayOperand<Type>::ArrayOperand(const DynamicArray<Type, Allocator>& array) : values(array.data()), count(array.size())
+{
+
+}
+
+/**
+ * @brief Construct a new Array Operand object
+ *
+ * @param slice - the slice
+ */
+template <class Type>
+ArrayOperand<Type>::ArrayOperand(DynamicArraySlice<const Type> slice) : values(slice.data()), count(slice.size())
+{
+
+}
+
+template <class Type>
+Type ArrayOperand<Type>::operator[](size_t index)const
+{
+    return values[index];
+}
+
+template <class Type>
+size_t ArrayOperand<Type>::size()const
+{
+    return count;
+}
+
+/**
+ * @brief checks if the elements overlap a range without being the same range
+ *
+ * @param target - pointer to the first element of the range
+ * @param size - number of the elements of the range
+ * @return true
+ * @return false
+ */
+template <class Type>
+template <class Value>
+bool ArrayOperand<Type>::overlaps(const Value* target, size_t size)const
+{
+    const char* first = reinterpret_cast<const char*>(values);
+    const char* last = first + count * sizeof(Type);
+    const char* targetFirst = reinterpret_cast<const char*>(target);
+    const char* targetLast = targetFirst + size * sizeof(Value);
+
+    if(first == targetFirst && sizeof(Type) == sizeof(Value))
+        return false;
+
+    return std::less<const char*>()(first, targetLast) && std::less<const char*>()(targetFirst, last);
+}
+
+/**
+ * @brief Construct a new Scalar Operand object
+ *
+ * @param value - the number
+ */
+template <class Type>
+ScalarOperand<Type>::ScalarOperand(Type value) : value(value)
+{
+
+}
+
+template <class Type>
+Type ScalarOperand<Type>::operator[](size_t)const
+{
+    return value;
+}
+
+/**
+ * @brief returns 0, numbers don't limit the size of an expression
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t ScalarOperand<Type>::size()const
+{
+    return 0;
+}
+
+/**
+ * @brief returns false, numbers aren't stored in arrays
+ *
+ * @return false
+ */
+template <class Type>
+template <class Value>
+bool ScalarOperand<Type>::overlaps(const Value*, size_t)const
+{
+    return false;
+}
+
+/**
+ * @brief returns the size shared by all operands that aren't numbers
+ *
+ * @param operands - the operands
+ * @return size_t
+ */
+template <class Operation, class... Operands>
+size_t ElementwiseExpression<Operation, Operands...>::commonSize(const Operands&... operands)
+{
+    size_t size = 0;
+    bool sized = false;
+    bool matching = true;
+    auto check = [&](const auto& operand)
+    {
+        if constexpr(!std::decay<decltype(operand)>::type::SCALAR)
+        {
+            matching &= !sized || operand.size() == size;
+            size = operand.size();
+            sized = true;
+        }
+    };
+    (check(operands), ...);
+
+    if(!matching)
+        throw std::invalid_argument("The operands have different sizes!");
+    return size;
+}
+
+/**
+ * @brief Construct a new Elementwise Expression object
+ *
+ * @param operands - the operands
+ */
+template <class Operation, class... Operands>
+ElementwiseExpression<Operation, Operands...>::ElementwiseExpression(const Operands&... operands)
+    : operands(operands...), count(commonSize(operands...))
+{
+
+}
+
+/**
+ * @brief computes the element at an index
+ *
+ * @param index - the index
+ * @return value_type
+ */
+template <class Operation, class... Operands>
+typename ElementwiseExpression<Operation, Operands...>::value_type ElementwiseExpression<Operation, Operands...>::operator[](size_t index)const
+{
+    return std::apply([index](const Operands&... operand) { return Operation()(operand[index]...); }, operands);
+}
+
+template <class Operation, class... Operands>
+size_t ElementwiseExpression<Operation, Operands...>::size()const
+{
+    return count;
+}
+
+/**
+ * @brief checks if any array of the expression overlaps a range without being the same range
+ *
+ * @param target - pointer to the first element of the range
+ * @param size - number of the elements of the range
+ * @return true
+ * @return false
+ */
+template <class Operation, class... Operands>
+template <class Value>
+bool ElementwiseExpression<Operation, Operands...>::overlaps(const Value* target, size_t size)const
+{
+    return std::apply([target, size](const Operands&... operand) { return (false || ... || operand.overlaps(target, size)); }, operands);
+}
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef _EYTZINGER_INDEX_
+#define _EYTZINGER_INDEX_
+
+#include <functional>
+#include <stdexcept>
+
+#include "Buffer.hpp"
+#include "DynamicArray.hpp"
+
+/**
+ * @brief EytzingerIndex class is a class template that stores a read-only copy of a sorted array
+ *  in Eytzinger (breadth-first) order to speed up searching in it
+ *
+ *  The element at position k has its children at positions 2k and 2k + 1, so the first levels
+ *  of the search share a few cache lines and the nodes of the next levels are prefetched while
+ *  the current one is compared. The searches return indices in the original sorted array.
+ *
+ * @tparam Type - type of data stored in the index
+ * @tparam Compare - ordering by which the array is sorted
+ */
+template <class Type, class Compare = std::less<Type>>
+class EytzingerIndex
+{
+private:
+    static const size_t CACHE_LINE = 64;
+    static const size_t PREFETCH_STRIDE = CACHE_LINE / sizeof(Type) > 0 ? CACHE_LINE / sizeof(Type) : 1;
+    static const size_t BATCH = 16;
+
+    Buffer<Type> tree;      ///the elements in Eytzinger order, starting at position 1
+    Buffer<size_t> ranks;   ///index of every element of the tree in the sorted array
+    size_t count;
+    Compare compare;
+
+private:
+    size_t build(const Type*, size_t, size_t);
+    size_t search(const Type&)const;
+    size_t rankOf(size_t)const;
+    static size_t lastLeftTurn(size_t);
+    static void prefetch(const void*);
+
+public:
+    EytzingerIndex(const DynamicArray<Type>&, Compare compare = Compare());
+    EytzingerIndex(const Type*, size_t, Compare compare = Compare());
+
+public:
+    size_t lower_bound(const Type&)const;
+    void lower_bound(const Type*, size_t, size_t*)const;
+    void lower_bound(const DynamicArray<Type>&, DynamicArray<size_t>&)const;
+
+    size_t find(const Type&)const;
+    bool contains(const Type&)const;
+
+    const Type& at(size_t)const;
+    size_t size()const;
+    bool empty()const;
+};
+
+/**
+ * @brief places the elements of a sorted range in the subtree rooted at a specific position
+ *  by traversing it in order
+ *
+ * @param sorted - the sorted elements
+ * @param next - index of the next element to be placed
+ * @param position - root of the subtree
+ * @return size_t - index of the next element to be placed after the subtree
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::build(const Type* sorted, size_t next, size_t position)
+{
+    if(position > count)
+        return next;
+
+    next = build(sorted, next, 2 * position);
+    tree[position] = sorted[next];
+    ranks[position] = next;
+    return build(sorted, next + 1, 2 * position + 1);
+}
+
+/**
+ * @brief returns the position in the tree of the first element that is not less than a key
+ *
+ * @param key - the searched key
+ * @return size_t - the position or 0 if all elements are less than the key
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::search(const Type& key)const
+{
+    const Type* nodes = tree.begin();
+    size_t position = 1;
+
+    while(position <= count)
+    {
+        prefetch(nodes + PREFETCH_STRIDE * position);
+        position = 2 * position + compare(nodes[position], key);
+    }
+
+    return lastLeftTurn(position);
+}
+
+/**
+ * @brief converts a position in the tree to the index of its element in the sorted array
+ *
+ * @param position - the position or 0
+ * @return size_t - the index or size() if the position is 0
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::rankOf(size_t position)const
+{
+    return position == 0 ? count : ranks.begin()[position];
+}
+
+/**
+ * @brief returns the last node from which a search descended to the left
+ *  - the search descends right after every element less than the key, so the lower bound
+ *    is found by dropping the trailing right turns and one left turn from the final position
+ *
+ * @param position - the position past the leaves where the search ended
+ * @return size_t - the node or 0 if the search never descended left
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::lastLeftTurn(size_t position)
+{
+    return position >> __builtin_ffsll(~position);
+}
+
+/**
+ * @brief hints the processor to load the cache line that contains an address
+ *
+ * @param address - the address
+ */
+template <class Type, class Compare>
+void EytzingerIndex<Type, Compare>::prefetch(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+}
+
+/**
+ * @brief Construct a new Eytzinger Index object from a sorted array
+ *
+ * @param sorted - the sorted array
+ * @param compare - ordering by which the array is sorted
+ */
+template <class Type, class Compare>
+EytzingerIndex<Type, Compare>::EytzingerIndex(const DynamicArray<Type>& sorted, Compare compare)
+    : EytzingerIndex(sorted.data(), sorted.size(), compare)
+{
+
+}
+
+/**
+ * @brief Construct a new Eytzinger Index object from a sorted range
+ *
+ * @param sorted - pointer to the first element of the range
+ * @param size - number of the elements in the range
+ * @param compare - ordering by which the range is sorted
+ */
+template <class Type, class Compare>
+EytzingerIndex<Type, Compare>::EytzingerIndex(const Type* sorted, size_t size, Compare compare)
+    : tree(size + 1), ranks(size + 1), count(size), compare(compare)
+{
+    build(sorted, 0, 1);
+}
+
+/**
+ * @brief returns the index in the sorted array of the first element that is not less than a key
+ *
+ * @param key - the searched key
+ * @return size_t - the index or size() if all elements are less than the key
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::lower_bound(const Type& key)const
+{
+    return rankOf(search(key));
+}
+
+/**
+ * @brief searches many keys at once
+ *  - groups of keys descend the tree together, so the loads for different keys are issued
+ *    without waiting for each other and hide the memory latency
+ *
+ * @param keys - pointer to the first searched key
+ * @param size - number of the keys
+ * @param results - pointer to where to write the index of the lower bound of every key
+ */
+template <class Type, class Compare>
+void EytzingerIndex<Type, Compare>::lower_bound(const Type* keys, size_t size, size_t* results)const
+{
+    const Type* nodes = tree.begin();
+    size_t positions[BATCH];
+
+    for(size_t first = 0; first < size; first += BATCH)
+    {
+        size_t group = size - first < BATCH ? size - first : BATCH;
+
+        for(size_t i = 0; i < group; ++i)
+        {
+            positions[i] = 1;
+        }
+
+        bool active = count > 0;
+        while(active)
+        {
+            active = false;
+            for(size_t i = 0; i < group; ++i)
+            {
+                if(positions[i] > count)
+                    continue;
+
+                prefetch(nodes + PREFETCH_STRIDE * positions[i]);
+                positions[i] = 2 * positions[i] + compare(nodes[positions[i]], keys[first + i]);
+                active = active || positions[i] <= count;
+            }
+        }
+
+        for(size_t i = 0; i < group; ++i)
+        {
+            results[first + i] = rankOf(lastLeftTurn(positions[i]));
+        }
+    }
+}
+
+/**
+ * @brief searches all keys of an array at once
+ *
+ * @param keys - the searched keys
+ * @param results - array to which the index of the lower bound of every key is appended
+ */
+template <class Type, class Compare>
+void EytzingerIndex<Type, Compare>::lower_bound(const DynamicArray<Type>& keys, DynamicArray<size_t>& results)const
+{
+    size_t offset = results.size();
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+        results.push_back(0);
+    }
+
+    lower_bound(keys.data(), keys.size(), results.data() + offset);
+}
+
+/**
+ * @brief returns the index in the sorted array of the element equivalent to a key
+ *
+ * @param key - the searched key
+ * @return size_t - the index or size() if there is no such element
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::find(const Type& key)const
+{
+    size_t position = search(key);
+    if(position != 0 && !compare(key, tree[position]))
+        return ranks[position];
+    return count;
+}
+
+/**
+ * @brief checks if the index contains an element equivalent to a key
+ *
+ * @param key - the searched key
+ * @return true
+ * @return false
+ */
+template <class Type, class Compare>
+bool EytzingerIndex<Type, Compare>::contains(const Type& key)const
+{
+    return find(key) != count;
+}
+
+/**
+ * @brief returns the element at a specific index of the sorted array
+ *  - it takes O(log n) time, the index is meant for searching and not for iteration
+ *
+ * @param index - index of the element in the sorted array
+ * @return const Type&
+ */
+template <class Type, class Compare>
+const Type& EytzingerIndex<Type, Compare>::at(size_t index)const
+{
+    if(index >= count)
+        throw std::out_of_range("The index is out of range!");
+
+    size_t position = 1;
+    while(ranks[position] != index)
+    {
+        position = 2 * position + (ranks[position] < index);
+    }
+    return tree[position];
+}
+
+/**
+ * @brief returns the number of the elements in the index
+ *
+ * @return size_t
+ */
+template <class Type, class Compare>
+size_t EytzingerIndex<Type, Compare>::size()const
+{
+    return count;
+}
+
+/**
+ * @brief checks if the index is empty
+ *
+ * @return true
+ * @return false
+ */
+template <class Type, class Compare>
+bool EytzingerIndex<Type, Compare>::empty()const
+{
+    return count == 0;
+}
+
+#endif
@@ -0,0 +1,555 @@
+#ifndef _FILE_LOADER_
+#define _FILE_LOADER_
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(DYNAMIC_ARRAY_IO_URING) && __has_include(<liburing.h>)
+#include <liburing.h>
+#define DYNAMIC_ARRAY_HAS_IO_URING 1
+#else
+#define DYNAMIC_ARRAY_HAS_IO_URING 0
+#endif
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief FileLoader class loads binary files into arrays of trivially copyable elements in the background
+ *
+ *  A load grows the array once to the size of the file and reads the file in chunks straight into
+ *  the storage of the array. With DYNAMIC_ARRAY_IO_URING defined and liburing available the chunks
+ *  are read through io_uring, otherwise every chunk is read by pread on a thread of the loader.
+ *  A decode callback can process every chunk as soon as it is read, while other chunks are still
+ *  being read. Every load returns a future of the number of the loaded elements.
+ */
+class FileLoader
+{
+public:
+    static const size_t DEFAULT_CHUNK = size_t(4) << 20;
+    static const size_t MAX_CHUNK = size_t(1) << 30;
+    static const unsigned QUEUE_DEPTH = 32;
+
+private:
+    template <class Type, class Decode>
+    struct Load
+    {
+        int file;
+        Type* data;
+        size_t count;           ///number of the elements
+        size_t chunk;           ///number of the elements of a chunk
+        size_t chunks;
+        std::atomic<size_t> pending;
+        std::mutex mutex;
+        std::exception_ptr error;
+        std::promise<size_t> promise;
+        Decode decode;
+
+        Load(int, Type*, size_t, size_t, Decode);
+        ~Load();
+
+        size_t first(size_t)const;
+        size_t length(size_t)const;
+
+        void read(size_t);
+        void process(size_t);
+        void fail(std::exception_ptr);
+        void finish();
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping;
+    size_t chunk;
+
+private:
+    static void readFully(int, void*, size_t, size_t);
+
+    void work();
+    void submit(std::function<void()>);
+
+    template <class Type, class Decode>
+    void readChunks(std::shared_ptr<Load<Type, Decode>>);
+#if DYNAMIC_ARRAY_HAS_IO_URING
+    template <class Type, class Decode>
+    bool readChunksWithRing(const std::shared_ptr<Load<Type, Decode>>&);
+#endif
+
+public:
+    FileLoader(size_t threads = 4, size_t chunk = DEFAULT_CHUNK);
+    FileLoader(const FileLoader&) = delete;
+    FileLoader& operator=(const FileLoader&) = delete;
+    ~FileLoader();
+
+public:
+    template <class Type, class Allocator>
+    std::future<size_t> load(const std::string&, DynamicArray<Type, Allocator>&);
+
+    template <class Type, class Allocator, class Decode>
+    std::future<size_t> load(const std::string&, DynamicArray<Type, Allocator>&, Decode);
+
+    static bool uses_io_uring();
+};
+
+/**
+ * @brief Construct a new Load object
+ *
+ * @param file - descriptor of the file, it is closed by the load
+ * @param data - where to write the elements
+ * @param count - number of the elements
+ * @param chunk - number of the elements of a chunk
+ * @param decode - called with every chunk after it is read
+ */
+template <class Type, class Decode>
+FileLoader::Load<Type, Decode>::Load(int file, Type* data, size_t count, size_t chunk, Decode decode)
+    : file(file), data(data), count(count), chunk(chunk), chunks((count + chunk - 1) / chunk),
+      pending(chunks), decode(std::move(decode))
+{
+
+}
+
+/**
+ * @brief Destroy the Load object and close its file
+ */
+template <class Type, class Decode>
+FileLoader::Load<Type, Decode>::~Load()
+{
+    ::close(file);
+}
+
+/**
+ * @brief returns the index of the first element of a chunk
+ *
+ * @param index - index of the chunk
+ * @return size_t
+ */
+template <class Type, class Decode>
+size_t FileLoader::Load<Type, Decode>::first(size_t index)const
+{
+    return index * chunk;
+}
+
+/**
+ * @brief returns the number of the elements of a chunk
+ *
+ * @param index - index of the chunk
+ * @return size_t
+ */
+template <class Type, class Decode>
+size_t FileLoader::Load<Type, Decode>::length(size_t index)const
+{
+    return index + 1 < chunks ? chunk : count - first(index);
+}
+
+/**
+ * @brief reads a chunk with pread and processes it
+ *
+ * @param index - index of the chunk
+ */
+template <class Type, class Decode>
+void FileLoader::Load<Type, Decode>::read(size_t index)
+{
+    try
+    {
+        readFully(file, data + first(index), length(index) * sizeof(Type), first(index) * sizeof(Type));
+    }
+    catch(...)
+    {
+        fail(std::current_exception());
+        finish();
+        return;
+    }
+    process(index);
+}
+
+/**
+ * @brief calls the decode callback with a chunk that was read and marks it as done
+ *
+ * @param index - index of the chunk
+ */
+template <class Type, class Decode>
+void FileLoader::Load<Type, Decode>::process(size_t index)
+{
+    try
+    {
+        decode(std::span<Type>(data + first(index), length(index)), first(index));
+    }
+    catch(...)
+    {
+        fail(std::current_exception());
+    }
+    finish();
+}
+
+/**
+ * @brief keeps the first error of the load, it is reported when all chunks are done
+ *
+ * @param exception - the error
+ */
+template <class Type, class Decode>
+void FileLoader::Load<Type, Decode>::fail(std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!error)
+        error = exception;
+}
+
+/**
+ * @brief marks a chunk as done, the last one completes the future
+ */
+template <class Type, class Decode>
+void FileLoader::Load<Type, Decode>::finish()
+{
+    if(pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if(error)
+        promise.set_exception(error);
+    else
+        promise.set_value(count);
+}
+
+/**
+ * @brief Construct a new File Loader object with its own threads
+ *
+ * @param threads - number of the threads reading the chunks and calling the decode callbacks
+ * @param chunk - size of the chunks in bytes, at most MAX_CHUNK
+ */
+inline FileLoader::FileLoader(size_t threads, size_t chunk) : stopping(false), chunk(chunk > 0 ? chunk : DEFAULT_CHUNK)
+{
+    if(this->chunk > MAX_CHUNK)
+        this->chunk = MAX_CHUNK;
+
+    if(threads == 0)
+        threads = 1;
+
+    for(size_t i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([this]() { work(); });
+    }
+}
+
+/**
+ * @brief Destroy the File Loader object after finishing all started loads
+ */
+inline FileLoader::~FileLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief reads a number of bytes at an offset of a file, retrying interrupted and partial reads
+ *  - throws std::system_error if the read fails and std::runtime_error if the file ends early
+ *
+ * @param file - descriptor of the file
+ * @param out - where to write the bytes
+ * @param bytes - number of the bytes
+ * @param offset - offset of the first byte in the file
+ */
+inline void FileLoader::readFully(int file, void* out, size_t bytes, size_t offset)
+{
+    char* position = static_cast<char*>(out);
+    while(bytes > 0)
+    {
+        ssize_t result = ::pread(file, position, bytes, off_t(offset));
+        if(result < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "pread");
+        }
+        if(result == 0)
+            throw std::runtime_error("The file ended before the expected size!");
+
+        position += result;
+        offset += size_t(result);
+        bytes -= size_t(result);
+    }
+}
+
+/**
+ * @brief runs the tasks of the loader until it is destroyed and has no more tasks
+ */
+inline void FileLoader::work()
+{
+    for(;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            if(tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+/**
+ * @brief queues a task for the threads of the loader
+ *
+ * @param task - the task
+ */
+inline void FileLoader::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    ready.notify_one();
+}
+
+/**
+ * @brief starts reading all chunks of a load, through io_uring if it is available and otherwise
+ *  with one pread task per chunk
+ *
+ * @param load - the load
+ */
+template <class Type, class Decode>
+void FileLoader::readChunks(std::shared_ptr<Load<Type, Decode>> load)
+{
+#if DYNAMIC_ARRAY_HAS_IO_URING
+    submit([this, load]()
+    {
+        if(!readChunksWithRing(load))
+        {
+            for(size_t index = 0; index < load->chunks; ++index)
+            {
+                submit([load, index]() { load->read(index); });
+            }
+        }
+    });
+#else
+    for(size_t index = 0; index < load->chunks; ++index)
+    {
+        submit([load, index]() { load->read(index); });
+    }
+#endif
+}
+
+#if DYNAMIC_ARRAY_HAS_IO_URING
+/**
+ * @brief reads all chunks of a load through a ring with up to QUEUE_DEPTH reads in flight, the chunks
+ *  that were read are processed by the other threads of the loader while the ring waits for the next ones
+ *
+ * @param load - the load
+ * @return true - if the chunks were read or failed
+ * @return false - if the ring couldn't be created and nothing was read
+ */
+template <class Type, class Decode>
+bool FileLoader::readChunksWithRing(const std::shared_ptr<Load<Type, Decode>>& load)
+{
+    io_uring ring;
+    if(io_uring_queue_init(QUEUE_DEPTH, &ring, 0) < 0)
+        return false;
+
+    std::vector<size_t> done(load->chunks, 0);
+    size_t next = 0;
+    size_t inFlight = 0;
+    bool failed = false;
+
+    auto queueRead = [&](size_t index)
+    {
+        size_t bytes = load->length(index) * sizeof(Type);
+        size_t offset = load->first(index) * sizeof(Type) + done[index];
+
+        io_uring_sqe* entry = io_uring_get_sqe(&ring);
+        io_uring_prep_read(entry, load->file, reinterpret_cast<char*>(load->data) + offset, unsigned(bytes - done[index]), offset);
+        io_uring_sqe_set_data(entry, reinterpret_cast<void*>(uintptr_t(index)));
+        ++inFlight;
+    };
+
+    while(inFlight > 0 || (next < load->chunks && !failed))
+    {
+        while(!failed && next < load->chunks && inFlight < QUEUE_DEPTH)
+        {
+            queueRead(next++);
+        }
+        io_uring_submit(&ring);
+
+        // the reads in flight write into the array, so the ring can't be left before they complete
+        io_uring_cqe* completion;
+        if(io_uring_wait_cqe(&ring, &completion) < 0)
+            continue;
+
+        size_t index = size_t(uintptr_t(io_uring_cqe_get_data(completion)));
+        int bytes = completion->res;
+        io_uring_cqe_seen(&ring, completion);
+        --inFlight;
+
+        if(bytes == -EINTR || bytes == -EAGAIN)
+        {
+            queueRead(index);
+            continue;
+        }
+
+        if(bytes <= 0)
+        {
+            if(bytes < 0)
+                load->fail(std::make_exception_ptr(std::system_error(-bytes, std::generic_category(), "io_uring read")));
+            else
+                load->fail(std::make_exception_ptr(std::runtime_error("The file ended before the expected size!")));
+
+            failed = true;
+            load->finish();
+            continue;
+        }
+
+        done[index] += size_t(bytes);
+        if(done[index] < load->length(index) * sizeof(Type))
+        {
+            queueRead(index);
+            continue;
+        }
+
+        submit([load, index]() { load->process(index); });
+    }
+
+    io_uring_queue_exit(&ring);
+
+    for(; next < load->chunks; ++next)
+    {
+        load->finish();
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief appends the elements stored in a binary file to an array in the background
+ *  - the array is grown once to hold the whole file and must not be used until the future is ready
+ *  - throws std::system_error if the file can't be opened and std::invalid_argument if its size
+ *    isn't a multiple of the size of the elements, read errors are reported by the future
+ *  - the array keeps its size if the load throws, if the future reports an error the array stays grown
+ *    by the size of the file and the values of the appended elements are unspecified
+ *
+ * @param path - path of the file
+ * @param out - array to which the elements are appended
+ * @return std::future<size_t> - number of the appended elements
+ */
+template <class Type, class Allocator>
+std::future<size_t> FileLoader::load(const std::string& path, DynamicArray<Type, Allocator>& out)
+{
+    return load(path, out, [](std::span<Type>, size_t) {});
+}
+
+/**
+ * @brief appends the elements stored in a binary file to an array in the background and calls a callback
+ *  with every chunk as soon as it is read, so decoding overlaps with reading the rest of the file
+ *  - the callback gets a span of the chunk and the index of its first element within the file, it is
+ *    called concurrently for different chunks
+ *  - the array is grown once to hold the whole file and must not be used until the future is ready
+ *  - throws std::system_error if the file can't be opened and std::invalid_argument if its size
+ *    isn't a multiple of the size of the elements, read and callback errors are reported by the future
+ *  - the array keeps its size if the load throws, if the future reports an error the array stays grown
+ *    by the size of the file and the values of the appended elements are unspecified
+ *
+ * @param path - path of the file
+ * @param out - array to which the elements are appended
+ * @param decode - the callback
+ * @return std::future<size_t> - number of the appended elements
+ */
+template <class Type, class Allocator, class Decode>
+std::future<size_t> FileLoader::load(const std::string& path, DynamicArray<Type, Allocator>& out, Decode decode)
+{
+    static_assert(std::is_trivially_copyable<Type>::value, "Only trivially copyable elements can be loaded");
+
+    int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(file < 0)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    struct stat status;
+    if(::fstat(file, &status) < 0)
+    {
+        int error = errno;
+        ::close(file);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+
+    size_t bytes = size_t(status.st_size);
+    if(bytes % sizeof(Type) != 0)
+    {
+        ::close(file);
+        throw std::invalid_argument("The size of the file isn't a multiple of the size of the elements!");
+    }
+
+    size_t count = bytes / sizeof(Type);
+    size_t offset = out.size();
+    try
+    {
+        out.resize_default_init(offset + count);
+    }
+    catch(...)
+    {
+        ::close(file);
+        throw;
+    }
+
+    size_t chunkElements = chunk / sizeof(Type) > 0 ? chunk / sizeof(Type) : 1;
+    std::shared_ptr<Load<Type, Decode>> state;
+    try
+    {
+        state = std::make_shared<Load<Type, Decode>>(file, out.data() + offset, count, chunkElements, std::move(decode));
+    }
+    catch(...)
+    {
+        // the load owns the file only once it is constructed
+        ::close(file);
+        out.resize_default_init(offset);
+        throw;
+    }
+    std::future<size_t> result = state->promise.get_future();
+
+    if(count == 0)
+        state->promise.set_value(0);
+    else
+        readChunks(state);
+
+    return result;
+}
+
+/**
+ * @brief checks if the loads read the files through io_uring
+ *
+ * @return true
+ * @return false
+ */
+inline bool FileLoader::uses_io_uring()
+{
+    return DYNAMIC_ARRAY_HAS_IO_URING;
+}
+
+#endif
@@ -0,0 +1,384 @@
+#ifndef _FILTER_
+#define _FILTER_
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "Buffer.hpp"
+#include "DynamicArray.hpp"
+#include "Parallel.hpp"
+
+/**
+ * @brief CompressTable class holds the permutations that move the selected 32-bit lanes of an AVX2 register
+ *  to its beginning, indexed by the mask of the selected lanes
+ *  - with 4 lanes of 64 bits, every lane is moved as a pair of 32-bit lanes
+ *
+ * @tparam LANES - number of the lanes, 8 or 4
+ */
+template <size_t LANES>
+struct CompressTable
+{
+    uint64_t permutations[size_t(1) << LANES];
+
+    constexpr CompressTable() : permutations()
+    {
+        const size_t width = 8 / LANES;
+
+        for(size_t mask = 0; mask < (size_t(1) << LANES); ++mask)
+        {
+            uint64_t permutation = 0;
+            size_t next = 0;
+            for(size_t lane = 0; lane < LANES; ++lane)
+            {
+                if(mask & (size_t(1) << lane))
+                {
+                    for(size_t part = 0; part < width; ++part)
+                    {
+                        permutation |= uint64_t(lane * width + part) << (8 * next++);
+                    }
+                }
+            }
+            permutations[mask] = permutation;
+        }
+    }
+};
+
+/**
+ * @brief returns the mask of the elements of a group that satisfy a predicate
+ *
+ * @param first - pointer to the first element of the group
+ * @param predicate - the predicate
+ * @return uint32_t - bit i is set if the element i satisfies the predicate
+ */
+template <size_t LANES, class Type, class Predicate>
+uint32_t selectionMask(const Type* first, Predicate& predicate)
+{
+    uint32_t mask = 0;
+    for(size_t lane = 0; lane < LANES; ++lane)
+    {
+        mask |= uint32_t(bool(predicate(first[lane]))) << lane;
+    }
+    return mask;
+}
+
+/**
+ * @brief writes the elements that satisfy a predicate to the beginning of an output with the compress
+ *  instructions of AVX-512 or with permutation tables on AVX2
+ *  - the elements have to be 4 or 8 bytes long and trivially copyable
+ *  - whole registers are stored, so up to a register of elements after the written ones is overwritten,
+ *    the output has to be either the input itself or have room for them
+ *
+ * @param in - pointer to the first element of the input
+ * @param count - number of the elements of the input
+ * @param out - pointer to where to write the selected elements
+ * @param keep - returns true for the elements to be written
+ * @param written - number of the written elements, it is increased
+ * @return size_t - number of the elements read, the rest have to be processed by the caller
+ */
+template <class Type, class Predicate>
+size_t simdCompact(const Type* in, size_t count, Type* out, Predicate& keep, size_t& written)
+{
+    size_t i = 0;
+
+#if defined(__AVX512F__)
+    if constexpr(sizeof(Type) == 4)
+    {
+        for(; i + 16 <= count; i += 16)
+        {
+            __mmask16 mask = __mmask16(selectionMask<16>(in + i, keep));
+            __m512i values = _mm512_loadu_si512(in + i);
+            _mm512_storeu_si512(out + written, _mm512_maskz_compress_epi32(mask, values));
+            written += __builtin_popcount(mask);
+        }
+    }
+    else if constexpr(sizeof(Type) == 8)
+    {
+        for(; i + 8 <= count; i += 8)
+        {
+            __mmask8 mask = __mmask8(selectionMask<8>(in + i, keep));
+            __m512i values = _mm512_loadu_si512(in + i);
+            _mm512_storeu_si512(out + written, _mm512_maskz_compress_epi64(mask, values));
+            written += __builtin_popcount(mask);
+        }
+    }
+#elif defined(__AVX2__)
+    const size_t LANES = 32 / sizeof(Type);
+    static constexpr CompressTable<LANES> table;
+
+    for(; i + LANES <= count; i += LANES)
+    {
+        uint32_t mask = selectionMask<LANES>(in + i, keep);
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.permutations + mask)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), _mm256_permutevar8x32_epi32(values, permutation));
+        written += __builtin_popcount(mask);
+    }
+#else
+    (void)in;
+    (void)count;
+    (void)out;
+    (void)keep;
+    (void)written;
+#endif
+
+    return i;
+}
+
+/**
+ * @brief checks if elements of a type are compacted by simdCompact
+ *
+ * @return true
+ * @return false
+ */
+template <class Type>
+constexpr bool simdCompactable()
+{
+    return std::is_arithmetic<Type>::value && (sizeof(Type) == 4 || sizeof(Type) == 8);
+}
+
+/**
+ * @brief number of the elements that simdCompact may write past the selected ones
+ */
+const size_t COMPACT_SLACK = 16;
+
+/**
+ * @brief moves the elements of a range that satisfy a predicate to its beginning, keeping their order
+ *  - trivially copyable elements are copied without branches, and arithmetic ones with SIMD instructions
+ *
+ * @param first - pointer to the first element of the range
+ * @param count - number of the elements of the range
+ * @param keep - returns true for the elements to be kept
+ * @return size_t - number of the kept elements
+ */
+template <class Type, class Predicate>
+size_t compactRange(Type* first, size_t count, Predicate& keep)
+{
+    size_t written = 0;
+    size_t i = 0;
+
+    if constexpr(simdCompactable<Type>())
+        i = simdCompact(first, count, first, keep, written);
+
+    if constexpr(std::is_trivially_copyable<Type>::value)
+    {
+        for(; i < count; ++i)
+        {
+            Type value = first[i];
+            first[written] = value;
+            written += bool(keep(value));
+        }
+    }
+    else
+    {
+        for(; i < count; ++i)
+        {
+            if(!keep(first[i]))
+                continue;
+
+            if(written != i)
+                first[written] = std::move(first[i]);
+            ++written;
+        }
+    }
+
+    return written;
+}
+
+/**
+ * @brief copies the elements of a range that satisfy a predicate to an output, keeping their order
+ *  - the output must have room for count + COMPACT_SLACK elements
+ *
+ * @param in - pointer to the first element of the range
+ * @param count - number of the elements of the range
+ * @param out - pointer to where to copy the elements
+ * @param keep - returns true for the elements to be copied
+ * @return size_t - number of the copied elements
+ */
+template <class Type, class Predicate>
+size_t copyIfRange(const Type* in, size_t count, Type* out, Predicate& keep)
+{
+    size_t written = 0;
+    size_t i = 0;
+
+    if constexpr(simdCompactable<Type>())
+        i = simdCompact(in, count, out, keep, written);
+
+    if constexpr(std::is_trivially_copyable<Type>::value)
+    {
+        for(; i < count; ++i)
+        {
+            out[written] = in[i];
+            written += bool(keep(in[i]));
+        }
+    }
+    else
+    {
+        for(; i < count; ++i)
+        {
+            if(keep(in[i]))
+                out[written++] = in[i];
+        }
+    }
+
+    return written;
+}
+
+/**
+ * @brief moves the elements of a slice that don't satisfy a predicate to its beginning in a single pass,
+ *  keeping their order
+ *  - the elements after the kept ones are left in a valid but unspecified state
+ *
+ * @param slice - the slice
+ * @param predicate - returns true for the elements to be removed
+ * @return size_t - number of the kept elements
+ */
+template <class Type, class Predicate>
+size_t remove_if(DynamicArraySlice<Type> slice, Predicate predicate)
+{
+    auto keep = [&predicate](const Type& value) { return !predicate(value); };
+    return compactRange(slice.data(), slice.size(), keep);
+}
+
+/**
+ * @brief moves the elements of an array that don't satisfy a predicate to its beginning in a single pass,
+ *  keeping their order
+ *  - the size of the array doesn't change, the elements after the kept ones are left in a valid but unspecified state
+ *
+ * @param array - the array
+ * @param predicate - returns true for the elements to be removed
+ * @return size_t - number of the kept elements
+ */
+template <class Type, class Allocator, class Predicate>
+size_t remove_if(DynamicArray<Type, Allocator>& array, Predicate predicate)
+{
+    return remove_if(array.slice(), predicate);
+}
+
+/**
+ * @brief erases the elements of an array that satisfy a predicate in a single pass, keeping the order of the rest
+ *
+ * @param array - the array
+ * @param predicate - returns true for the elements to be erased
+ * @return size_t - number of the erased elements
+ */
+template <class Type, class Allocator, class Predicate>
+size_t erase_if(DynamicArray<Type, Allocator>& array, Predicate predicate)
+{
+    size_t size = array.size();
+    size_t kept = remove_if(array, predicate);
+    array.resize_default_init(kept);
+    return size - kept;
+}
+
+/**
+ * @brief appends the elements of a slice that satisfy a predicate to an array
+ *  - the slice may be a part of the array, it is found again after the array grows
+ *
+ * @param source - the slice to be filtered
+ * @param out - array to which the elements are appended
+ * @param predicate - returns true for the elements to be appended
+ * @return size_t - number of the appended elements
+ */
+template <class Type, class Allocator, class Predicate>
+size_t filter_into(std::type_identity_t<DynamicArraySlice<const Type>> source, DynamicArray<Type, Allocator>& out, Predicate predicate)
+{
+    size_t offset = out.size();
+    size_t count = source.size();
+    const Type* first = source.data();
+    bool aliased = pointsInto(first, static_cast<const Type*>(out.data()), offset);
+    size_t position = aliased ? first - out.data() : 0;
+
+    std::span<Type> added = out.append_uninitialized(count + COMPACT_SLACK);
+    if(aliased)
+        first = out.data() + position;
+
+    size_t written = copyIfRange(first, count, added.data(), predicate);
+    out.resize_default_init(offset + written);
+    return written;
+}
+
+/**
+ * @brief appends the elements of an array that satisfy a predicate to another array or to itself
+ *
+ * @param source - the array to be filtered
+ * @param out - array to which the elements are appended
+ * @param predicate - returns true for the elements to be appended
+ * @return size_t - number of the appended elements
+ */
+template <class Type, class SourceAllocator, class Allocator, class Predicate>
+size_t filter_into(const DynamicArray<Type, SourceAllocator>& source, DynamicArray<Type, Allocator>& out, Predicate predicate)
+{
+    return filter_into(source.slice(), out, predicate);
+}
+
+/**
+ * @brief erases the elements of an array that satisfy a predicate using several threads, keeping the order of the rest
+ *  - every thread compacts one chunk of the array, the prefix sums of the numbers of the kept elements
+ *    give the offsets of the chunks
+ *  - the kept elements of the chunks are moved to a scratch buffer at their offsets and back to the array,
+ *    both in parallel
+ *
+ * @param array - the array
+ * @param predicate - returns true for the elements to be erased, it is called concurrently
+ * @param threads - number of threads to be used
+ * @return size_t - number of the erased elements
+ */
+template <class Type, class Allocator, class Predicate>
+size_t parallel_erase_if(DynamicArray<Type, Allocator>& array, Predicate predicate, size_t threads = parallelThreads())
+{
+    size_t size = array.size();
+    threads = limitThreads(size, threads);
+
+    if(threads <= 1)
+        return erase_if(array, predicate);
+
+    Type* data = array.data();
+    std::vector<size_t> bounds(threads + 1);
+    for(size_t i = 0; i <= threads; ++i)
+    {
+        bounds[i] = size * i / threads;
+    }
+
+    std::vector<size_t> kept(threads);
+    runParallel(threads, [&](size_t i)
+    {
+        auto keep = [&predicate](const Type& value) { return !predicate(value); };
+        kept[i] = compactRange(data + bounds[i], bounds[i + 1] - bounds[i], keep);
+    });
+
+    std::vector<size_t> offsets(threads + 1, 0);
+    for(size_t i = 0; i < threads; ++i)
+    {
+        offsets[i + 1] = offsets[i] + kept[i];
+    }
+    size_t total = offsets[threads];
+
+    // the first chunk stays in place, the rest are staged in a scratch buffer because the destination of a chunk
+    // can overlap the kept elements of earlier chunks that are still being moved
+    size_t moved = total - kept[0];
+    Buffer<Type> scratch(moved);
+    Type* staged = scratch.begin();
+
+    runParallel(threads - 1, [&](size_t chunk)
+    {
+        size_t i = chunk + 1;
+        std::move(data + bounds[i], data + bounds[i] + kept[i], staged + offsets[i] - kept[0]);
+    });
+
+    runParallelRanges(moved, threads, [&](size_t first, size_t last)
+    {
+        std::move(staged + first, staged + last, data + kept[0] + first);
+    });
+
+    array.resize_default_init(total);
+    return size - total;
+}
+
+#endif
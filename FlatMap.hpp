@@ -0,0 +1,422 @@
+#ifndef _FLAT_MAP_
+#define _FLAT_MAP_
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "DynamicArray.hpp"
+#include "FlatSet.hpp"
+
+/**
+ * @brief FlatMap class is a class template that stores key-value pairs with unique keys
+ *  sorted in a DynamicArray
+ *
+ *  Lookups use a branchless binary search over contiguous memory. Bulk insertions sort the new
+ *  pairs and merge them with the old ones at once.
+ *
+ * @tparam Key - type of the keys
+ * @tparam Value - type of the mapped values
+ * @tparam Compare - strict weak ordering of the keys
+ */
+template <class Key, class Value, class Compare = std::less<Key>>
+class FlatMap
+{
+public:
+    typedef std::pair<Key, Value> Pair;
+
+private:
+    DynamicArray<Pair> elements;
+    Compare compare;
+
+private:
+    size_t insertAt(size_t, const Key&, const Value&);
+
+public:
+    FlatMap(Compare compare = Compare());
+    FlatMap(const DynamicArray<Pair>&, Compare compare = Compare());
+
+public:
+    bool insert(const Key&, const Value&);
+    void insert(const Pair*, size_t);
+    void insert(const DynamicArray<Pair>&);
+    void insert_or_assign(const Key&, const Value&);
+    bool erase(const Key&);
+
+    size_t lower_bound(const Key&)const;
+    size_t find(const Key&)const;
+    bool contains(const Key&)const;
+
+    Value& operator[](const Key&);
+
+    Value& at(const Key&);
+    const Value& at(const Key&)const;
+
+    const Key& key_at(size_t)const;
+    Value& value_at(size_t);
+    const Value& value_at(size_t)const;
+
+    const Pair* begin()const;
+    const Pair* end()const;
+
+    size_t size()const;
+    bool empty()const;
+
+    void clear();
+    void reserve(size_t);
+};
+
+/**
+ * @brief inserts a pair at a specific position, shifting the following pairs
+ *
+ * @param position - index of the new pair
+ * @param key - key of the pair
+ * @param value - value of the pair
+ * @return size_t - the position
+ */
+template <class Key, class Value, class Compare>
+size_t FlatMap<Key, Value, Compare>::insertAt(size_t position, const Key& key, const Value& value)
+{
+    Pair pair(key, value);
+
+    if(position == size())
+    {
+        elements.push_back(pair);
+        return position;
+    }
+
+    Pair last = elements.back();
+    elements.push_back(last);
+    std::copy_backward(elements.data() + position, elements.data() + size() - 2, elements.data() + size() - 1);
+    elements[position] = pair;
+    return position;
+}
+
+/**
+ * @brief Construct a new empty Flat Map object
+ *
+ * @param compare - ordering of the keys
+ */
+template <class Key, class Value, class Compare>
+FlatMap<Key, Value, Compare>::FlatMap(Compare compare) : compare(compare)
+{
+
+}
+
+/**
+ * @brief Construct a new Flat Map object with the pairs of an array
+ *  - if several pairs have the same key, the first one is kept
+ *
+ * @param other - container from which to copy the pairs
+ * @param compare - ordering of the keys
+ */
+template <class Key, class Value, class Compare>
+FlatMap<Key, Value, Compare>::FlatMap(const DynamicArray<Pair>& other, Compare compare) : compare(compare)
+{
+    insert(other);
+}
+
+/**
+ * @brief inserts a pair if the map doesn't contain its key
+ *
+ * @param key - key of the pair
+ * @param value - value of the pair
+ * @return true - if the pair was inserted
+ * @return false - if the key was already in the map
+ */
+template <class Key, class Value, class Compare>
+bool FlatMap<Key, Value, Compare>::insert(const Key& key, const Value& value)
+{
+    size_t position = lower_bound(key);
+    if(position < size() && !compare(key, elements[position].first))
+        return false;
+
+    insertAt(position, key, value);
+    return true;
+}
+
+/**
+ * @brief inserts many pairs at once
+ *  - the new pairs are appended, sorted and merged with the old ones in a single pass,
+ *    instead of shifting the array for every pair
+ *  - keys that are already in the map keep their values, and from several new pairs with the same key
+ *    the first one is inserted
+ *  - the removed duplicates are reset to default values, so they don't keep their resources
+ *
+ * @param first - pointer to the first pair to be inserted
+ * @param count - number of the pairs to be inserted
+ */
+template <class Key, class Value, class Compare>
+void FlatMap<Key, Value, Compare>::insert(const Pair* first, size_t count)
+{
+    if(count == 0)
+        return;
+
+    size_t oldSize = size();
+    elements.append(first, count);
+
+    Compare less = compare;
+    auto pairLess = [less](const Pair& lhs, const Pair& rhs)
+    {
+        return less(lhs.first, rhs.first);
+    };
+
+    Pair* begin = elements.data();
+    std::stable_sort(begin + oldSize, begin + oldSize + count, pairLess);
+    std::inplace_merge(begin, begin + oldSize, begin + oldSize + count, pairLess);
+
+    Pair* last = std::unique(begin, begin + oldSize + count, [less](const Pair& lhs, const Pair& rhs)
+    {
+        return !less(lhs.first, rhs.first);
+    });
+
+    Pair* end = begin + oldSize + count;
+    elements.resize_default_init(last - begin);
+
+    if(!std::is_trivially_destructible<Pair>::value)
+        std::fill(last, end, Pair());
+}
+
+/**
+ * @brief inserts all pairs of an array at once
+ *
+ * @param other - container from which to copy the pairs
+ */
+template <class Key, class Value, class Compare>
+void FlatMap<Key, Value, Compare>::insert(const DynamicArray<Pair>& other)
+{
+    insert(other.data(), other.size());
+}
+
+/**
+ * @brief inserts a pair or replaces the value of its key if the key is already in the map
+ *
+ * @param key - key of the pair
+ * @param value - value of the pair
+ */
+template <class Key, class Value, class Compare>
+void FlatMap<Key, Value, Compare>::insert_or_assign(const Key& key, const Value& value)
+{
+    size_t position = lower_bound(key);
+    if(position < size() && !compare(key, elements[position].first))
+    {
+        elements[position].second = value;
+        return;
+    }
+
+    insertAt(position, key, value);
+}
+
+/**
+ * @brief erases the pair with a specific key
+ *
+ * @param key - key of the pair to be erased
+ * @return true - if a pair was erased
+ * @return false - if the map doesn't contain the key
+ */
+template <class Key, class Value, class Compare>
+bool FlatMap<Key, Value, Compare>::erase(const Key& key)
+{
+    size_t position = find(key);
+    if(position == size())
+        return false;
+
+    std::copy(elements.data() + position + 1, elements.data() + size(), elements.data() + position);
+    elements.pop_back();
+    return true;
+}
+
+/**
+ * @brief returns the index of the first pair whose key is not less than a specific key
+ *
+ * @param key - the searched key
+ * @return size_t
+ */
+template <class Key, class Value, class Compare>
+size_t FlatMap<Key, Value, Compare>::lower_bound(const Key& key)const
+{
+    Compare less = compare;
+    const Pair* position = branchlessLowerBound(elements.data(), size(), key, [less](const Pair& pair, const Key& key)
+    {
+        return less(pair.first, key);
+    });
+
+    return position - elements.data();
+}
+
+/**
+ * @brief returns the index of the pair with a specific key or size() if there is no such pair
+ *
+ * @param key - the searched key
+ * @return size_t
+ */
+template <class Key, class Value, class Compare>
+size_t FlatMap<Key, Value, Compare>::find(const Key& key)const
+{
+    size_t position = lower_bound(key);
+    if(position < size() && !compare(key, elements[position].first))
+        return position;
+    return size();
+}
+
+/**
+ * @brief checks if the map contains a specific key
+ *
+ * @param key - the searched key
+ * @return true
+ * @return false
+ */
+template <class Key, class Value, class Compare>
+bool FlatMap<Key, Value, Compare>::contains(const Key& key)const
+{
+    return find(key) != size();
+}
+
+/**
+ * @brief returns a reference to the value of a key, inserting a default value if the key isn't in the map
+ *
+ * @param key - the searched key
+ * @return Value&
+ */
+template <class Key, class Value, class Compare>
+Value& FlatMap<Key, Value, Compare>::operator[](const Key& key)
+{
+    size_t position = lower_bound(key);
+    if(position == size() || compare(key, elements[position].first))
+        insertAt(position, key, Value());
+
+    return elements[position].second;
+}
+
+/**
+ * @brief returns a reference to the value of a key
+ *
+ * @param key - the searched key
+ * @return Value&
+ */
+template <class Key, class Value, class Compare>
+Value& FlatMap<Key, Value, Compare>::at(const Key& key)
+{
+    size_t position = find(key);
+    if(position < size())
+        return elements[position].second;
+    throw std::out_of_range("The key is not in the map!");
+}
+
+/**
+ * @brief returns a constant reference to the value of a key
+ *
+ * @param key - the searched key
+ * @return const Value&
+ */
+template <class Key, class Value, class Compare>
+const Value& FlatMap<Key, Value, Compare>::at(const Key& key)const
+{
+    return const_cast<FlatMap<Key, Value, Compare>*>(this)->at(key);
+}
+
+/**
+ * @brief returns the key of the pair at a specified position in the sorted order
+ *
+ * @param index - index of the pair
+ * @return const Key&
+ */
+template <class Key, class Value, class Compare>
+const Key& FlatMap<Key, Value, Compare>::key_at(size_t index)const
+{
+    return elements[index].first;
+}
+
+/**
+ * @brief returns a reference to the value of the pair at a specified position in the sorted order
+ *
+ * @param index - index of the pair
+ * @return Value&
+ */
+template <class Key, class Value, class Compare>
+Value& FlatMap<Key, Value, Compare>::value_at(size_t index)
+{
+    return elements[index].second;
+}
+
+/**
+ * @brief returns a constant reference to the value of the pair at a specified position in the sorted order
+ *
+ * @param index - index of the pair
+ * @return const Value&
+ */
+template <class Key, class Value, class Compare>
+const Value& FlatMap<Key, Value, Compare>::value_at(size_t index)const
+{
+    return elements[index].second;
+}
+
+/**
+ * @brief returns a constant pointer to the pair with the smallest key
+ *
+ * @return const Pair*
+ */
+template <class Key, class Value, class Compare>
+const typename FlatMap<Key, Value, Compare>::Pair* FlatMap<Key, Value, Compare>::begin()const
+{
+    return elements.data();
+}
+
+/**
+ * @brief returns a constant pointer past the pair with the largest key
+ *
+ * @return const Pair*
+ */
+template <class Key, class Value, class Compare>
+const typename FlatMap<Key, Value, Compare>::Pair* FlatMap<Key, Value, Compare>::end()const
+{
+    return elements.data() + size();
+}
+
+/**
+ * @brief returns the number of the pairs in the map
+ *
+ * @return size_t
+ */
+template <class Key, class Value, class Compare>
+size_t FlatMap<Key, Value, Compare>::size()const
+{
+    return elements.size();
+}
+
+/**
+ * @brief checks if the map is empty
+ *
+ * @return true
+ * @return false
+ */
+template <class Key, class Value, class Compare>
+bool FlatMap<Key, Value, Compare>::empty()const
+{
+    return elements.empty();
+}
+
+/**
+ * @brief erases the pairs of the map
+ */
+template <class Key, class Value, class Compare>
+void FlatMap<Key, Value, Compare>::clear()
+{
+    elements.clear();
+}
+
+/**
+ * @brief reserves storage for a specific number of pairs
+ *
+ * @param size - number of the pairs
+ */
+template <class Key, class Value, class Compare>
+void FlatMap<Key, Value, Compare>::reserve(size_t size)
+{
+    if(size > elements.capacity())
+        elements.reserve(size);
+}
+
+#endif
@@ -0,0 +1,328 @@
+#ifndef _FLAT_SET_
+#define _FLAT_SET_
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief returns a pointer to the first element of a sorted range that is not less than a key
+ *  - the loop has no data dependent branches, so the comparison compiles to a conditional move
+ *    and the search doesn't suffer from branch mispredictions
+ *
+ * @param first - pointer to the first element of the range
+ * @param count - number of the elements in the range
+ * @param key - the searched key
+ * @param less - compares an element with the key
+ * @return const Type*
+ */
+template <class Type, class Key, class Less>
+const Type* branchlessLowerBound(const Type* first, size_t count, const Key& key, Less less)
+{
+    if(count == 0)
+        return first;
+
+    while(count > 1)
+    {
+        size_t half = count / 2;
+        first = less(first[half - 1], key) ? first + half : first;
+        count -= half;
+    }
+
+    return first + less(*first, key);
+}
+
+/**
+ * @brief FlatSet class is a class template that stores unique elements sorted in a DynamicArray
+ *
+ *  Lookups use a branchless binary search over contiguous memory. Single insertions shift the
+ *  following elements, so bulk insertions should be used for many elements - they sort the new
+ *  elements and merge them with the old ones at once.
+ *
+ * @tparam Type - type of data stored in the set
+ * @tparam Compare - strict weak ordering of the elements
+ */
+template <class Type, class Compare = std::less<Type>>
+class FlatSet
+{
+private:
+    DynamicArray<Type> elements;
+    Compare compare;
+
+private:
+    bool equal(const Type&, const Type&)const;
+
+public:
+    FlatSet(Compare compare = Compare());
+    FlatSet(const DynamicArray<Type>&, Compare compare = Compare());
+
+public:
+    bool insert(const Type&);
+    void insert(const Type*, size_t);
+    void insert(const DynamicArray<Type>&);
+    bool erase(const Type&);
+
+    size_t lower_bound(const Type&)const;
+    size_t find(const Type&)const;
+    bool contains(const Type&)const;
+
+    const Type& operator[](size_t)const;
+
+    const Type* begin()const;
+    const Type* end()const;
+
+    size_t size()const;
+    bool empty()const;
+
+    void clear();
+    void reserve(size_t);
+};
+
+/**
+ * @brief checks if two elements are equivalent according to the ordering
+ *
+ * @return true
+ * @return false
+ */
+template <class Type, class Compare>
+bool FlatSet<Type, Compare>::equal(const Type& lhs, const Type& rhs)const
+{
+    return !compare(lhs, rhs) && !compare(rhs, lhs);
+}
+
+/**
+ * @brief Construct a new empty Flat Set object
+ *
+ * @param compare - ordering of the elements
+ */
+template <class Type, class Compare>
+FlatSet<Type, Compare>::FlatSet(Compare compare) : compare(compare)
+{
+
+}
+
+/**
+ * @brief Construct a new Flat Set object with the unique elements of an array
+ *
+ * @param other - container from which to copy the elements
+ * @param compare - ordering of the elements
+ */
+template <class Type, class Compare>
+FlatSet<Type, Compare>::FlatSet(const DynamicArray<Type>& other, Compare compare) : compare(compare)
+{
+    insert(other);
+}
+
+/**
+ * @brief inserts an element if the set doesn't contain an equivalent one
+ *
+ * @param elem - element to be inserted
+ * @return true - if the element was inserted
+ * @return false - if an equivalent element was already in the set
+ */
+template <class Type, class Compare>
+bool FlatSet<Type, Compare>::insert(const Type& elem)
+{
+    size_t position = lower_bound(elem);
+    if(position < size() && equal(elements[position], elem))
+        return false;
+
+    if(position == size())
+    {
+        elements.push_back(elem);
+        return true;
+    }
+
+    Type last = elements.back();
+    elements.push_back(last);
+    std::copy_backward(elements.data() + position, elements.data() + size() - 2, elements.data() + size() - 1);
+    elements[position] = elem;
+    return true;
+}
+
+/**
+ * @brief inserts many elements at once
+ *  - the new elements are appended, sorted and merged with the old ones in a single pass,
+ *    instead of shifting the array for every element
+ *  - the removed duplicates are reset to default values, so they don't keep their resources
+ *
+ * @param first - pointer to the first element to be inserted
+ * @param count - number of the elements to be inserted
+ */
+template <class Type, class Compare>
+void FlatSet<Type, Compare>::insert(const Type* first, size_t count)
+{
+    if(count == 0)
+        return;
+
+    size_t oldSize = size();
+    elements.append(first, count);
+
+    Type* begin = elements.data();
+    std::sort(begin + oldSize, begin + oldSize + count, compare);
+    std::inplace_merge(begin, begin + oldSize, begin + oldSize + count, compare);
+
+    Compare less = compare;
+    Type* last = std::unique(begin, begin + oldSize + count, [less](const Type& lhs, const Type& rhs)
+    {
+        return !less(lhs, rhs);
+    });
+
+    Type* end = begin + oldSize + count;
+    elements.resize_default_init(last - begin);
+
+    if(!std::is_trivially_destructible<Type>::value)
+        std::fill(last, end, Type());
+}
+
+/**
+ * @brief inserts all elements of an array at once
+ *
+ * @param other - container from which to copy the elements
+ */
+template <class Type, class Compare>
+void FlatSet<Type, Compare>::insert(const DynamicArray<Type>& other)
+{
+    insert(other.data(), other.size());
+}
+
+/**
+ * @brief erases the element equivalent to a key
+ *
+ * @param key - the element to be erased
+ * @return true - if an element was erased
+ * @return false - if the set doesn't contain such element
+ */
+template <class Type, class Compare>
+bool FlatSet<Type, Compare>::erase(const Type& key)
+{
+    size_t position = find(key);
+    if(position == size())
+        return false;
+
+    std::copy(elements.data() + position + 1, elements.data() + size(), elements.data() + position);
+    elements.pop_back();
+    return true;
+}
+
+/**
+ * @brief returns the index of the first element that is not less than a key
+ *
+ * @param key - the searched key
+ * @return size_t
+ */
+template <class Type, class Compare>
+size_t FlatSet<Type, Compare>::lower_bound(const Type& key)const
+{
+    return branchlessLowerBound(elements.data(), size(), key, compare) - elements.data();
+}
+
+/**
+ * @brief returns the index of the element equivalent to a key or size() if there is no such element
+ *
+ * @param key - the searched key
+ * @return size_t
+ */
+template <class Type, class Compare>
+size_t FlatSet<Type, Compare>::find(const Type& key)const
+{
+    size_t position = lower_bound(key);
+    if(position < size() && !compare(key, elements[position]))
+        return position;
+    return size();
+}
+
+/**
+ * @brief checks if the set contains an element equivalent to a key
+ *
+ * @param key - the searched key
+ * @return true
+ * @return false
+ */
+template <class Type, class Compare>
+bool FlatSet<Type, Compare>::contains(const Type& key)const
+{
+    return find(key) != size();
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified position in the sorted order
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type, class Compare>
+const Type& FlatSet<Type, Compare>::operator[](size_t index)const
+{
+    return elements[index];
+}
+
+/**
+ * @brief returns a constant pointer to the smallest element
+ *
+ * @return const Type*
+ */
+template <class Type, class Compare>
+const Type* FlatSet<Type, Compare>::begin()const
+{
+    return elements.data();
+}
+
+/**
+ * @brief returns a constant pointer past the largest element
+ *
+ * @return const Type*
+ */
+template <class Type, class Compare>
+const Type* FlatSet<Type, Compare>::end()const
+{
+    return elements.data() + size();
+}
+
+/**
+ * @brief returns the number of the elements in the set
+ *
+ * @return size_t
+ */
+template <class Type, class Compare>
+size_t FlatSet<Type, Compare>::size()const
+{
+    return elements.size();
+}
+
+/**
+ * @brief checks if the set is empty
+ *
+ * @return true
+ * @return false
+ */
+template <class Type, class Compare>
+bool FlatSet<Type, Compare>::empty()const
+{
+    return elements.empty();
+}
+
+/**
+ * @brief erases the elements of the set
+ */
+template <class Type, class Compare>
+void FlatSet<Type, Compare>::clear()
+{
+    elements.clear();
+}
+
+/**
+ * @brief reserves storage for a specific number of elements
+ *
+ * @param size - number of the elements
+ */
+template <class Type, class Compare>
+void FlatSet<Type, Compare>::reserve(size_t size)
+{
+    if(size > elements.capacity())
+        elements.reserve(size);
+}
+
+#endif
@@ -0,0 +1,420 @@
+#ifndef _GATHER_
+#define _GATHER_
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief number of elements ahead of the current one whose memory is prefetched by default
+ */
+const size_t GATHER_PREFETCH_DISTANCE = 16;
+
+/**
+ * @brief hints the processor to load the cache line that contains an address
+ *
+ * @param address - the address
+ * @param write - whether the line is going to be written
+ */
+inline void prefetchAddress(const void* address, bool write)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if(write)
+        __builtin_prefetch(address, 1);
+    else
+        __builtin_prefetch(address, 0);
+#endif
+}
+
+/**
+ * @brief checks that all indices are smaller than a size
+ *
+ * @param indices - pointer to the first index
+ * @param count - number of the indices
+ * @param size - the size
+ * @return uint64_t - the largest index or 0 if there are no indices
+ */
+template <class Index>
+uint64_t checkIndices(const Index* indices, size_t count, size_t size)
+{
+    static_assert(std::is_integral<Index>::value, "The indices have to be integers");
+
+    uint64_t largest = 0;
+    bool negative = false;
+    for(size_t i = 0; i < count; ++i)
+    {
+        if constexpr(std::is_signed<Index>::value)
+            negative |= indices[i] < 0;
+        largest = uint64_t(indices[i]) > largest ? uint64_t(indices[i]) : largest;
+    }
+
+    if(negative || (count > 0 && largest >= size))
+        throw std::out_of_range("The index is out of range!");
+    return largest;
+}
+
+/**
+ * @brief copies the elements at some indices with the gather instructions of the processor
+ *  - the elements have to be 4 or 8 bytes long and the indices have to be 4 or 8 bytes long integers
+ *  - 4 bytes long indices are read as signed numbers, so they have to be smaller than 2^31
+ *
+ * @param source - pointer to the first element of the source
+ * @param indices - pointer to the first index
+ * @param count - number of the indices
+ * @param out - pointer to where to write the elements
+ * @return size_t - number of the elements copied, the rest have to be copied by the caller
+ */
+template <class Type, class Index>
+size_t simdGather(const Type* source, const Index* indices, size_t count, Type* out)
+{
+    const void* base = source;
+    size_t i = 0;
+
+#if defined(__AVX512F__)
+    if constexpr(sizeof(Type) == 4 && sizeof(Index) == 4)
+    {
+        for(; i + 16 <= count; i += 16)
+        {
+            __m512i positions = _mm512_loadu_si512(indices + i);
+            _mm512_storeu_si512(out + i, _mm512_i32gather_epi32(positions, base, 4));
+        }
+    }
+    else if constexpr(sizeof(Type) == 8 && sizeof(Index) == 4)
+    {
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i positions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            _mm512_storeu_si512(out + i, _mm512_i32gather_epi64(positions, base, 8));
+        }
+    }
+    else if constexpr(sizeof(Type) == 8 && sizeof(Index) == 8)
+    {
+        for(; i + 8 <= count; i += 8)
+        {
+            __m512i positions = _mm512_loadu_si512(indices + i);
+            _mm512_storeu_si512(out + i, _mm512_i64gather_epi64(positions, base, 8));
+        }
+    }
+    else if constexpr(sizeof(Type) == 4 && sizeof(Index) == 8)
+    {
+        for(; i + 8 <= count; i += 8)
+        {
+            __m512i positions = _mm512_loadu_si512(indices + i);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_i64gather_epi32(positions, base, 4));
+        }
+    }
+#elif defined(__AVX2__)
+    const int* base32 = static_cast<const int*>(base);
+    const long long* base64 = static_cast<const long long*>(base);
+
+    if constexpr(sizeof(Type) == 4 && sizeof(Index) == 4)
+    {
+        for(; i + 8 <= count; i += 8)
+        {
+            __m256i positions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_i32gather_epi32(base32, positions, 4));
+        }
+    }
+    else if constexpr(sizeof(Type) == 8 && sizeof(Index) == 4)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            __m128i positions = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_i32gather_epi64(base64, positions, 8));
+        }
+    }
+    else if constexpr(sizeof(Type) == 8 && sizeof(Index) == 8)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            __m256i positions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_i64gather_epi64(base64, positions, 8));
+        }
+    }
+    else if constexpr(sizeof(Type) == 4 && sizeof(Index) == 8)
+    {
+        for(; i + 4 <= count; i += 4)
+        {
+            __m256i positions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_i64gather_epi32(base32, positions, 4));
+        }
+    }
+#else
+    (void)base;
+    (void)source;
+    (void)indices;
+    (void)count;
+    (void)out;
+#endif
+
+    return i;
+}
+
+/**
+ * @brief copies the elements of a source at some indices
+ *  - arithmetic elements are copied with the gather instructions of the processor if it has them
+ *  - otherwise the element a specific distance ahead is prefetched while the current one is copied
+ *
+ * @param source - pointer to the first element of the source
+ * @param size - number of the elements of the source
+ * @param indices - pointer to the first index, all indices have to be smaller than size
+ * @param count - number of the indices
+ * @param out - pointer to where to write the elements
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index>
+void gatherRange(const Type* source, size_t size, const Index* indices, size_t count, Type* out, size_t distance)
+{
+    size_t i = 0;
+
+    if constexpr(std::is_arithmetic<Type>::value && (sizeof(Type) == 4 || sizeof(Type) == 8) &&
+                 std::is_integral<Index>::value && (sizeof(Index) == 4 || sizeof(Index) == 8))
+    {
+        if(sizeof(Index) == 8 || size <= size_t(INT32_MAX))
+            i = simdGather(source, indices, count, out);
+    }
+
+    size_t prefetched = count > distance ? count - distance : 0;
+    for(; i < prefetched; ++i)
+    {
+        prefetchAddress(source + indices[i + distance], false);
+        out[i] = source[indices[i]];
+    }
+    for(; i < count; ++i)
+    {
+        out[i] = source[indices[i]];
+    }
+}
+
+/**
+ * @brief writes values to a target at some indices
+ *  - 4 and 8 bytes long arithmetic values are written with the scatter instructions of AVX-512 if the processor has them
+ *  - if several values are written to the same index, the last one is kept
+ *
+ * @param values - pointer to the first value
+ * @param indices - pointer to the first index, all indices have to be smaller than size
+ * @param count - number of the values
+ * @param target - pointer to the first element of the target
+ * @param size - number of the elements of the target
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index>
+void scatterRange(const Type* values, const Index* indices, size_t count, Type* target, size_t size, size_t distance)
+{
+    size_t i = 0;
+
+#if defined(__AVX512F__)
+    if constexpr(std::is_arithmetic<Type>::value && std::is_integral<Index>::value && sizeof(Type) == sizeof(Index))
+    {
+        void* base = target;
+        if constexpr(sizeof(Type) == 4)
+        {
+            if(size <= size_t(INT32_MAX))
+            {
+                for(; i + 16 <= count; i += 16)
+                {
+                    __m512i positions = _mm512_loadu_si512(indices + i);
+                    _mm512_i32scatter_epi32(base, positions, _mm512_loadu_si512(values + i), 4);
+                }
+            }
+        }
+        else if constexpr(sizeof(Type) == 8)
+        {
+            for(; i + 8 <= count; i += 8)
+            {
+                __m512i positions = _mm512_loadu_si512(indices + i);
+                _mm512_i64scatter_epi64(base, positions, _mm512_loadu_si512(values + i), 8);
+            }
+        }
+    }
+#endif
+    (void)size;
+
+    size_t prefetched = count > distance ? count - distance : 0;
+    for(; i < prefetched; ++i)
+    {
+        prefetchAddress(target + indices[i + distance], true);
+        target[indices[i]] = values[i];
+    }
+    for(; i < count; ++i)
+    {
+        target[indices[i]] = values[i];
+    }
+}
+
+/**
+ * @brief calls a function for the elements of a source at some indices, prefetching the element
+ *  a specific distance ahead
+ *
+ * @param source - pointer to the first element of the source
+ * @param indices - pointer to the first index
+ * @param count - number of the indices
+ * @param function - called with a reference to every element
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Element, class Index, class Function>
+void indexedForEachRange(Element* source, const Index* indices, size_t count, Function& function, size_t distance)
+{
+    size_t i = 0;
+    size_t prefetched = count > distance ? count - distance : 0;
+    for(; i < prefetched; ++i)
+    {
+        prefetchAddress(source + indices[i + distance], !std::is_const<Element>::value);
+        function(source[indices[i]]);
+    }
+    for(; i < count; ++i)
+    {
+        function(source[indices[i]]);
+    }
+}
+
+/**
+ * @brief appends the elements of a slice at the indices in another slice to an array
+ *  - the source and the indices may be parts of the array, they are found again after it grows
+ *  - if an index is out of range, it throws before appending anything
+ *
+ * @param source - the source
+ * @param indices - indices of the elements to be copied
+ * @param out - array to which the elements are appended
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index, class Allocator>
+void gather(std::type_identity_t<DynamicArraySlice<const Type>> source, DynamicArraySlice<Index> indices, DynamicArray<Type, Allocator>& out,
+            size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    checkIndices(indices.data(), indices.size(), source.size());
+
+    size_t offset = out.size();
+    const Type* first = source.data();
+    Index* positions = indices.data();
+    bool sourceAliased = pointsInto(first, static_cast<const Type*>(out.data()), offset);
+    size_t sourcePosition = sourceAliased ? first - out.data() : 0;
+    bool indicesAliased = false;
+    size_t indicesPosition = 0;
+    if constexpr(std::is_same<std::remove_const_t<Index>, Type>::value)
+    {
+        indicesAliased = pointsInto(static_cast<const Type*>(positions), static_cast<const Type*>(out.data()), offset);
+        indicesPosition = indicesAliased ? positions - out.data() : 0;
+    }
+
+    std::span<Type> added = out.append_uninitialized(indices.size());
+    if(sourceAliased)
+        first = out.data() + sourcePosition;
+    if constexpr(std::is_same<std::remove_const_t<Index>, Type>::value)
+    {
+        if(indicesAliased)
+            positions = out.data() + indicesPosition;
+    }
+    gatherRange(first, source.size(), positions, indices.size(), added.data(), distance);
+}
+
+/**
+ * @brief appends the elements of a source at some indices to an array, e.g. the rows of a table
+ *  matched by a join
+ *  - if an index is out of range, it throws before appending anything
+ *
+ * @param source - the source
+ * @param indices - indices of the elements to be copied
+ * @param out - array to which the elements are appended
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index, class SourceAllocator, class IndexAllocator, class Allocator>
+void gather(const DynamicArray<Type, SourceAllocator>& source, const DynamicArray<Index, IndexAllocator>& indices, DynamicArray<Type, Allocator>& out,
+            size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    gather(source.slice(), indices.slice(), out, distance);
+}
+
+/**
+ * @brief writes values to a slice at some indices
+ *  - if several values are written to the same index, the last one is kept
+ *  - if an index is out of range, it throws before writing anything
+ *
+ * @param values - the values
+ * @param indices - index in the target of every value
+ * @param target - the slice to be written
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index>
+void scatter(std::type_identity_t<DynamicArraySlice<const Type>> values, DynamicArraySlice<Index> indices, DynamicArraySlice<Type> target,
+             size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    if(values.size() != indices.size())
+        throw std::invalid_argument("The number of the values and of the indices differ");
+
+    checkIndices(indices.data(), indices.size(), target.size());
+    scatterRange(values.data(), indices.data(), values.size(), target.data(), target.size(), distance);
+}
+
+/**
+ * @brief writes values to an array at some indices
+ *  - if several values are written to the same index, the last one is kept
+ *  - if an index is out of range, it throws before writing anything
+ *
+ * @param values - the values
+ * @param indices - index in the target of every value
+ * @param target - the array to be written
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index, class ValueAllocator, class IndexAllocator, class Allocator>
+void scatter(const DynamicArray<Type, ValueAllocator>& values, const DynamicArray<Index, IndexAllocator>& indices, DynamicArray<Type, Allocator>& target,
+             size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    scatter(values.slice(), indices.slice(), target.slice(), distance);
+}
+
+/**
+ * @brief calls a function for the elements of a slice at the indices in another slice, prefetching the elements ahead
+ *  - if an index is out of range, it throws before calling the function
+ *
+ * @param source - the slice, its elements are constant if it is read-only
+ * @param indices - indices of the elements
+ * @param function - called with a reference to every element
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index, class Function>
+void indexed_for_each(DynamicArraySlice<Type> source, DynamicArraySlice<Index> indices, Function function, size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    checkIndices(indices.data(), indices.size(), source.size());
+    indexedForEachRange(source.data(), indices.data(), indices.size(), function, distance);
+}
+
+/**
+ * @brief calls a function for the elements of an array at some indices, prefetching the elements ahead
+ *  - if an index is out of range, it throws before calling the function
+ *
+ * @param source - the array
+ * @param indices - indices of the elements
+ * @param function - called with a reference to every element
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index, class Allocator, class IndexAllocator, class Function>
+void indexed_for_each(DynamicArray<Type, Allocator>& source, const DynamicArray<Index, IndexAllocator>& indices, Function function,
+                      size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    indexed_for_each(source.slice(), indices.slice(), function, distance);
+}
+
+/**
+ * @brief calls a function for the constant elements of an array at some indices, prefetching the elements ahead
+ *  - if an index is out of range, it throws before calling the function
+ *
+ * @param source - the array
+ * @param indices - indices of the elements
+ * @param function - called with a constant reference to every element
+ * @param distance - how many elements ahead to prefetch
+ */
+template <class Type, class Index, class Allocator, class IndexAllocator, class Function>
+void indexed_for_each(const DynamicArray<Type, Allocator>& source, const DynamicArray<Index, IndexAllocator>& indices, Function function,
+                      size_t distance = GATHER_PREFETCH_DISTANCE)
+{
+    indexed_for_each(source.slice(), indices.slice(), function, distance);
+}
+
+#endif
@@ -0,0 +1,420 @@
+#ifndef _HARDENING_
+#define _HARDENING_
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * DYNAMIC_ARRAY_HARDENING selects the run-time checks of the containers at compile time:
+ *  - 0 - no checks, operator[] and the iterators compile to plain pointer accesses
+ *  - 1 - bounds checks of operator[]
+ *  - 2 - full checks, the iterators are additionally checked against the bounds of the array and
+ *    against invalidation by generation counters
+ *
+ * It defaults to 1 if assertions are enabled and to 0 if NDEBUG is defined. Level 2 changes the layout
+ * of DynamicArray, so all translation units of a program have to use the same level.
+ */
+#ifndef DYNAMIC_ARRAY_HARDENING
+#ifdef NDEBUG
+#define DYNAMIC_ARRAY_HARDENING 0
+#else
+#define DYNAMIC_ARRAY_HARDENING 1
+#endif
+#endif
+
+/**
+ * @brief HardeningHandler is called with the failed condition and its location when a check fails
+ *  - the program is aborted if the handler returns
+ */
+typedef void (*HardeningHandler)(const char*, const char*, int);
+
+/**
+ * @brief prints a failed check to the standard error
+ *
+ * @param condition - the failed condition
+ * @param file - file of the check
+ * @param line - line of the check
+ */
+inline void printHardeningFailure(const char* condition, const char* file, int line)
+{
+    std::fprintf(stderr, "%s:%d: hardening check failed: %s\n", file, line, condition);
+}
+
+/**
+ * @brief returns the handler called by failed checks
+ *
+ * @return HardeningHandler&
+ */
+inline HardeningHandler& hardeningHandler()
+{
+    static HardeningHandler handler = printHardeningFailure;
+    return handler;
+}
+
+/**
+ * @brief replaces the handler called by failed checks, e.g. with one that throws in tests
+ *
+ * @param handler - the new handler
+ * @return HardeningHandler - the previous handler
+ */
+inline HardeningHandler set_hardening_handler(HardeningHandler handler)
+{
+    HardeningHandler previous = hardeningHandler();
+    hardeningHandler() = handler ? handler : printHardeningFailure;
+    return previous;
+}
+
+/**
+ * @brief reports a failed check to the handler and aborts the program if the handler returns
+ *
+ * @param condition - the failed condition
+ * @param file - file of the check
+ * @param line - line of the check
+ */
+[[noreturn]] inline void hardeningFailure(const char* condition, const char* file, int line)
+{
+    hardeningHandler()(condition, file, line);
+    std::abort();
+}
+
+#if DYNAMIC_ARRAY_HARDENING >= 1
+#define DYNAMIC_ARRAY_CHECK(condition) \
+    (__builtin_expect(!(condition), 0) ? hardeningFailure(#condition, __FILE__, __LINE__) : (void)0)
+#else
+#define DYNAMIC_ARRAY_CHECK(condition) ((void)0)
+#endif
+
+/**
+ * @brief CheckedIterator class is a class template of random access iterators used by the containers
+ *  at hardening level 2
+ *
+ *  The iterator remembers its container, the index of its element and the generation of the container
+ *  when it was created. Every access checks that the container hasn't invalidated its iterators since then
+ *  and that the element is within the container.
+ *
+ * @tparam Container - type of the container, const for constant iterators
+ * @tparam Value - type of the elements, const for constant iterators
+ */
+template <class Container, class Value>
+class CheckedIterator
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const<Value>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+private:
+    Container* container;
+    size_t index;
+    size_t generation;
+
+    template <class, class> friend class CheckedIterator;
+
+private:
+    void checkValid()const;
+    void checkAccess(difference_type)const;
+    void checkComparable(const CheckedIterator&)const;
+
+public:
+    CheckedIterator();
+    CheckedIterator(Container*, size_t);
+
+    template <class OtherContainer, class OtherValue,
+              class = typename std::enable_if<std::is_convertible<OtherValue*, Value*>::value>::type>
+    CheckedIterator(const CheckedIterator<OtherContainer, OtherValue>&);
+
+public:
+    reference operator*()const;
+    pointer operator->()const;
+    reference operator[](difference_type)const;
+
+    CheckedIterator& operator++();
+    CheckedIterator operator++(int);
+    CheckedIterator& operator--();
+    CheckedIterator operator--(int);
+
+    CheckedIterator& operator+=(difference_type);
+    CheckedIterator& operator-=(difference_type);
+    CheckedIterator operator+(difference_type)const;
+    CheckedIterator operator-(difference_type)const;
+    difference_type operator-(const CheckedIterator&)const;
+
+    bool operator==(const CheckedIterator&)const;
+    bool operator!=(const CheckedIterator&)const;
+    bool operator<(const CheckedIterator&)const;
+    bool operator>(const CheckedIterator&)const;
+    bool operator<=(const CheckedIterator&)const;
+    bool operator>=(const CheckedIterator&)const;
+
+    friend CheckedIterator operator+(difference_type offset, const CheckedIterator& iterator)
+    {
+        return iterator + offset;
+    }
+};
+
+/**
+ * @brief checks that the iterator belongs to a container that hasn't invalidated it
+ */
+template <class Container, class Value>
+void CheckedIterator<Container, Value>::checkValid()const
+{
+    DYNAMIC_ARRAY_CHECK(container != nullptr);
+    DYNAMIC_ARRAY_CHECK(generation == container->generation);
+}
+
+/**
+ * @brief checks that the element at an offset from the iterator can be accessed
+ *
+ * @param offset - the offset
+ */
+template <class Container, class Value>
+void CheckedIterator<Container, Value>::checkAccess(difference_type offset)const
+{
+    checkValid();
+    DYNAMIC_ARRAY_CHECK(difference_type(index) + offset >= 0 && size_t(difference_type(index) + offset) < container->size());
+}
+
+/**
+ * @brief checks that two iterators belong to the same container
+ *
+ * @param other - the other iterator
+ */
+template <class Container, class Value>
+void CheckedIterator<Container, Value>::checkComparable(const CheckedIterator& other)const
+{
+    DYNAMIC_ARRAY_CHECK(container == other.container);
+}
+
+/**
+ * @brief Construct a new Checked Iterator object that doesn't belong to any container
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value>::CheckedIterator() : container(nullptr), index(0), generation(0)
+{
+
+}
+
+/**
+ * @brief Construct a new Checked Iterator object pointing to an element of a container
+ *
+ * @param container - the container
+ * @param index - index of the element
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value>::CheckedIterator(Container* container, size_t index)
+    : container(container), index(index), generation(container->generation)
+{
+
+}
+
+/**
+ * @brief Construct a new constant Checked Iterator object from a mutable one
+ *
+ * @param other - the mutable iterator
+ */
+template <class Container, class Value>
+template <class OtherContainer, class OtherValue, class>
+CheckedIterator<Container, Value>::CheckedIterator(const CheckedIterator<OtherContainer, OtherValue>& other)
+    : container(other.container), index(other.index), generation(other.generation)
+{
+
+}
+
+/**
+ * @brief returns a reference to the element of the iterator
+ *
+ * @return reference
+ */
+template <class Container, class Value>
+typename CheckedIterator<Container, Value>::reference CheckedIterator<Container, Value>::operator*()const
+{
+    checkAccess(0);
+    return container->data()[index];
+}
+
+/**
+ * @brief returns a pointer to the element of the iterator
+ *
+ * @return pointer
+ */
+template <class Container, class Value>
+typename CheckedIterator<Container, Value>::pointer CheckedIterator<Container, Value>::operator->()const
+{
+    checkAccess(0);
+    return container->data() + index;
+}
+
+/**
+ * @brief returns a reference to the element at an offset from the iterator
+ *
+ * @param offset - the offset
+ * @return reference
+ */
+template <class Container, class Value>
+typename CheckedIterator<Container, Value>::reference CheckedIterator<Container, Value>::operator[](difference_type offset)const
+{
+    checkAccess(offset);
+    return container->data()[index + offset];
+}
+
+/**
+ * @brief moves the iterator to the next element
+ *
+ * @return CheckedIterator&
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value>& CheckedIterator<Container, Value>::operator++()
+{
+    return *this += 1;
+}
+
+/**
+ * @brief moves the iterator to the next element
+ *
+ * @return CheckedIterator - the iterator before moving
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value> CheckedIterator<Container, Value>::operator++(int)
+{
+    CheckedIterator previous = *this;
+    *this += 1;
+    return previous;
+}
+
+/**
+ * @brief moves the iterator to the previous element
+ *
+ * @return CheckedIterator&
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value>& CheckedIterator<Container, Value>::operator--()
+{
+    return *this -= 1;
+}
+
+/**
+ * @brief moves the iterator to the previous element
+ *
+ * @return CheckedIterator - the iterator before moving
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value> CheckedIterator<Container, Value>::operator--(int)
+{
+    CheckedIterator previous = *this;
+    *this -= 1;
+    return previous;
+}
+
+/**
+ * @brief moves the iterator by an offset, it must stay between the first element and the end of the container
+ *
+ * @param offset - the offset
+ * @return CheckedIterator&
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value>& CheckedIterator<Container, Value>::operator+=(difference_type offset)
+{
+    checkValid();
+    DYNAMIC_ARRAY_CHECK(difference_type(index) + offset >= 0 && size_t(difference_type(index) + offset) <= container->size());
+
+    index += offset;
+    return *this;
+}
+
+/**
+ * @brief moves the iterator back by an offset
+ *
+ * @param offset - the offset
+ * @return CheckedIterator&
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value>& CheckedIterator<Container, Value>::operator-=(difference_type offset)
+{
+    return *this += -offset;
+}
+
+/**
+ * @brief returns an iterator moved by an offset
+ *
+ * @param offset - the offset
+ * @return CheckedIterator
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value> CheckedIterator<Container, Value>::operator+(difference_type offset)const
+{
+    CheckedIterator moved = *this;
+    moved += offset;
+    return moved;
+}
+
+/**
+ * @brief returns an iterator moved back by an offset
+ *
+ * @param offset - the offset
+ * @return CheckedIterator
+ */
+template <class Container, class Value>
+CheckedIterator<Container, Value> CheckedIterator<Container, Value>::operator-(difference_type offset)const
+{
+    CheckedIterator moved = *this;
+    moved -= offset;
+    return moved;
+}
+
+/**
+ * @brief returns the distance between two iterators of the same container
+ *
+ * @param other - the other iterator
+ * @return difference_type
+ */
+template <class Container, class Value>
+typename CheckedIterator<Container, Value>::difference_type CheckedIterator<Container, Value>::operator-(const CheckedIterator& other)const
+{
+    checkComparable(other);
+    return difference_type(index) - difference_type(other.index);
+}
+
+template <class Container, class Value>
+bool CheckedIterator<Container, Value>::operator==(const CheckedIterator& other)const
+{
+    checkComparable(other);
+    return index == other.index;
+}
+
+template <class Container, class Value>
+bool CheckedIterator<Container, Value>::operator!=(const CheckedIterator& other)const
+{
+    return !(*this == other);
+}
+
+template <class Container, class Value>
+bool CheckedIterator<Container, Value>::operator<(const CheckedIterator& other)const
+{
+    checkComparable(other);
+    return index < other.index;
+}
+
+template <class Container, class Value>
+bool CheckedIterator<Container, Value>::operator>(const CheckedIterator& other)const
+{
+    return other < *this;
+}
+
+template <class Container, class Value>
+bool CheckedIterator<Container, Value>::operator<=(const CheckedIterator& other)const
+{
+    return !(other < *this);
+}
+
+template <class Container, class Value>
+bool CheckedIterator<Container, Value>::operator>=(const CheckedIterator& other)const
+{
+    return !(*this < other);
+}
+
+#endif
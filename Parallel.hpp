@@ -0,0 +1,117 @@
+#ifndef _PARALLEL_
+#define _PARALLEL_
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * Fork-join helpers of the parallel algorithms - the parallel sorts, parallel_erase_if, parallel_assign and the merge
+ * of ShardedDynamicArray. Every algorithm splits its work into tasks, runs every task in a thread of its own and waits
+ * for all of them before it goes on.
+ */
+
+/**
+ * @brief minimum number of the elements of one thread of the algorithms that pass over their elements once,
+ *  smaller inputs are split between fewer threads
+ */
+const size_t PARALLEL_MINIMUM_CHUNK = size_t(1) << 16;
+
+/**
+ * @brief returns the number of threads used by the parallel algorithms by default - the number of hardware threads
+ *
+ * @return size_t
+ */
+inline size_t parallelThreads()
+{
+    size_t threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * @brief limits a number of threads so that every thread gets at least a minimum number of elements,
+ *  0 or 1 means that the elements should be processed by the calling thread
+ *
+ * @param size - number of the elements
+ * @param threads - the requested number of threads
+ * @param minimumChunk - minimum number of the elements of a thread
+ * @return size_t
+ */
+inline size_t limitThreads(size_t size, size_t threads, size_t minimumChunk = PARALLEL_MINIMUM_CHUNK)
+{
+    return threads > size / minimumChunk ? size / minimumChunk : threads;
+}
+
+/**
+ * @brief calls a function with every index of a number of tasks, each in a thread of its own, and waits for all of them
+ *  - if calls throw, the exception of the first of them is rethrown after all threads are joined
+ *  - if a thread can't be started, the started ones are joined and the error is rethrown
+ *
+ * @param tasks - number of the tasks
+ * @param task - called with the index of a task
+ */
+template <class Task>
+void runParallel(size_t tasks, Task task)
+{
+    std::vector<std::exception_ptr> errors(tasks);
+    std::vector<std::thread> workers;
+    workers.reserve(tasks);
+
+    auto join = [&workers]()
+    {
+        for(std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    };
+
+    try
+    {
+        for(size_t i = 0; i < tasks; ++i)
+        {
+            workers.emplace_back([&task, &errors, i]()
+            {
+                try
+                {
+                    task(i);
+                }
+                catch(...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+    }
+    catch(...)
+    {
+        join();
+        throw;
+    }
+    join();
+
+    for(std::exception_ptr& error : errors)
+    {
+        if(error)
+            std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief splits a range of indices evenly into parts and calls a function with the bounds of every part,
+ *  each in a thread of its own, like runParallel
+ *
+ * @param size - number of the indices
+ * @param parts - number of the parts
+ * @param task - called with the first index of a part and the index past its last one
+ */
+template <class Task>
+void runParallelRanges(size_t size, size_t parts, Task task)
+{
+    runParallel(parts, [&task, size, parts](size_t i)
+    {
+        task(size * i / parts, size * (i + 1) / parts);
+    });
+}
+
+#endif
@@ -0,0 +1,819 @@
+#ifndef _PERSISTENT_VECTOR_
+#define _PERSISTENT_VECTOR_
+
+#include <atomic>
+#include <stdexcept>
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief PersistentVector class is a class template that stores an immutable sequence of elements in a
+ *  32-way bitmapped trie with a tail buffer
+ *
+ *  set and push_back don't change the vector, but return a new version of it that shares all unchanged
+ *  nodes with the old one, so they take O(log32 n) time and memory. The nodes are reference counted
+ *  atomically, so versions can be shared between threads. Many changes can be batched with a Transient,
+ *  which modifies the nodes it owns in place.
+ *
+ * @tparam Type - type of data stored in the vector
+ */
+template <class Type>
+class PersistentVector
+{
+private:
+    static const unsigned BITS = 5;
+    static const size_t WIDTH = size_t(1) << BITS;
+    static const size_t MASK = WIDTH - 1;
+
+    struct Node
+    {
+        std::atomic<size_t> references;
+        size_t owner;       ///id of the transient allowed to modify the node in place, 0 if none
+        bool leaf;
+
+        Node(size_t, bool);
+    };
+
+    struct Branch : Node
+    {
+        Node* children[WIDTH];
+
+        Branch(size_t);
+    };
+
+    struct Leaf : Node
+    {
+        Type values[WIDTH];
+
+        Leaf(size_t);
+    };
+
+public:
+    class Transient;
+
+private:
+    size_t count;
+    unsigned shift;
+    Node* root;
+    Leaf* tail;
+
+private:
+    PersistentVector(size_t, unsigned, Node*, Leaf*);
+
+    size_t tailOffset()const;
+    const Leaf* leafFor(size_t)const;
+
+    static size_t nextOwner();
+    static Node* retain(Node*);
+    static void release(Node*);
+    static Branch* copyBranch(const Node*, size_t);
+    static Leaf* copyLeaf(const Node*, size_t);
+    static Node* newPath(unsigned, Node*, size_t);
+
+    Node* pushTail(unsigned, const Node*, Leaf*)const;
+    static Node* assign(unsigned, const Node*, size_t, const Type&);
+
+public:
+    PersistentVector();
+    PersistentVector(const DynamicArray<Type>&);
+    PersistentVector(const PersistentVector<Type>&);
+    PersistentVector<Type>& operator=(const PersistentVector<Type>&);
+    ~PersistentVector();
+
+public:
+    PersistentVector<Type> push_back(const Type&)const;
+    PersistentVector<Type> set(size_t, const Type&)const;
+
+    const Type& at(size_t)const;
+    const Type& operator[](size_t)const;
+
+    size_t size()const;
+    bool empty()const;
+
+    Transient transient()const;
+    DynamicArray<Type> to_dynamic_array()const;
+};
+
+/**
+ * @brief Transient class is a mutable builder of a PersistentVector
+ *
+ *  It modifies the nodes it has created or copied in place, so a batch of changes copies every node
+ *  at most once. After persistent() is called the transient can't be used anymore.
+ */
+template <class Type>
+class PersistentVector<Type>::Transient
+{
+private:
+    size_t count;
+    unsigned shift;
+    Node* root;
+    Leaf* tail;
+    size_t owner;
+
+private:
+    void ensureValid()const;
+    Node* editable(Node*)const;
+    Node* pushTail(unsigned, Node*, Leaf*);
+    Node* assign(unsigned, Node*, size_t, const Type&);
+
+public:
+    Transient(const PersistentVector<Type>&);
+    Transient(const Transient&) = delete;
+    Transient& operator=(const Transient&) = delete;
+    ~Transient();
+
+public:
+    void push_back(const Type&);
+    void set(size_t, const Type&);
+
+    const Type& at(size_t)const;
+    const Type& operator[](size_t)const;
+
+    size_t size()const;
+
+    PersistentVector<Type> persistent();
+};
+
+/**
+ * @brief Construct a new Node object
+ *
+ * @param owner - id of the transient that owns the node
+ * @param leaf - whether the node stores elements
+ */
+template <class Type>
+PersistentVector<Type>::Node::Node(size_t owner, bool leaf) : references(1), owner(owner), leaf(leaf)
+{
+
+}
+
+/**
+ * @brief Construct a new Branch object without children
+ *
+ * @param owner - id of the transient that owns the node
+ */
+template <class Type>
+PersistentVector<Type>::Branch::Branch(size_t owner) : Node(owner, false), children()
+{
+
+}
+
+/**
+ * @brief Construct a new Leaf object
+ *
+ * @param owner - id of the transient that owns the node
+ */
+template <class Type>
+PersistentVector<Type>::Leaf::Leaf(size_t owner) : Node(owner, true)
+{
+
+}
+
+/**
+ * @brief Construct a new Persistent Vector object that takes over the given references
+ */
+template <class Type>
+PersistentVector<Type>::PersistentVector(size_t count, unsigned shift, Node* root, Leaf* tail)
+    : count(count), shift(shift), root(root), tail(tail)
+{
+
+}
+
+/**
+ * @brief returns the index of the first element stored in the tail
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t PersistentVector<Type>::tailOffset()const
+{
+    return count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+}
+
+/**
+ * @brief returns the leaf that contains the element at a specified index
+ *
+ * @param index - index of the element
+ * @return const Leaf*
+ */
+template <class Type>
+const typename PersistentVector<Type>::Leaf* PersistentVector<Type>::leafFor(size_t index)const
+{
+    if(index >= tailOffset())
+        return tail;
+
+    const Node* node = root;
+    for(unsigned level = shift; level > 0; level -= BITS)
+    {
+        node = static_cast<const Branch*>(node)->children[(index >> level) & MASK];
+    }
+    return static_cast<const Leaf*>(node);
+}
+
+/**
+ * @brief returns a new unique id for a transient
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t PersistentVector<Type>::nextOwner()
+{
+    static std::atomic<size_t> owners(0);
+    return owners.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * @brief adds a reference to a node
+ *
+ * @param node - the node, may be nullptr
+ * @return Node* - the same node
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::retain(Node* node)
+{
+    if(node)
+        node->references.fetch_add(1, std::memory_order_relaxed);
+    return node;
+}
+
+/**
+ * @brief drops a reference to a node and deletes the node with its children if it was the last one
+ *
+ * @param node - the node, may be nullptr
+ */
+template <class Type>
+void PersistentVector<Type>::release(Node* node)
+{
+    if(!node || node->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if(node->leaf)
+    {
+        delete static_cast<Leaf*>(node);
+        return;
+    }
+
+    Branch* branch = static_cast<Branch*>(node);
+    for(size_t i = 0; i < WIDTH; ++i)
+    {
+        release(branch->children[i]);
+    }
+    delete branch;
+}
+
+/**
+ * @brief creates a copy of a branch that references the same children
+ *
+ * @param node - the branch to be copied, nullptr creates an empty branch
+ * @param owner - id of the transient that owns the copy
+ * @return Branch*
+ */
+template <class Type>
+typename PersistentVector<Type>::Branch* PersistentVector<Type>::copyBranch(const Node* node, size_t owner)
+{
+    Branch* copy = new Branch(owner);
+    if(node)
+    {
+        const Branch* branch = static_cast<const Branch*>(node);
+        for(size_t i = 0; i < WIDTH; ++i)
+        {
+            copy->children[i] = retain(branch->children[i]);
+        }
+    }
+    return copy;
+}
+
+/**
+ * @brief creates a copy of a leaf
+ *
+ * @param node - the leaf to be copied, nullptr creates a new leaf
+ * @param owner - id of the transient that owns the copy
+ * @return Leaf*
+ */
+template <class Type>
+typename PersistentVector<Type>::Leaf* PersistentVector<Type>::copyLeaf(const Node* node, size_t owner)
+{
+    Leaf* copy = new Leaf(owner);
+    if(node)
+    {
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        for(size_t i = 0; i < WIDTH; ++i)
+        {
+            copy->values[i] = leaf->values[i];
+        }
+    }
+    return copy;
+}
+
+/**
+ * @brief creates a chain of branches from a specific level down to a node
+ *
+ * @param level - level of the top branch
+ * @param node - the node at the bottom, its reference is taken over
+ * @param owner - id of the transient that owns the new branches
+ * @return Node*
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::newPath(unsigned level, Node* node, size_t owner)
+{
+    if(level == 0)
+        return node;
+
+    Branch* branch = new Branch(owner);
+    branch->children[0] = newPath(level - BITS, node, owner);
+    return branch;
+}
+
+/**
+ * @brief returns a copy of the path to the last leaf of the trie with the full tail appended
+ *
+ * @param level - level of the current branch
+ * @param parent - the current branch, may be nullptr
+ * @param tailNode - the full tail, its reference is taken over
+ * @return Node*
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::pushTail(unsigned level, const Node* parent, Leaf* tailNode)const
+{
+    Branch* result = copyBranch(parent, 0);
+    size_t subindex = ((count - 1) >> level) & MASK;
+
+    if(level == BITS)
+    {
+        result->children[subindex] = tailNode;
+        return result;
+    }
+
+    Node* child = result->children[subindex];
+    result->children[subindex] = child ? pushTail(level - BITS, child, tailNode) : newPath(level - BITS, tailNode, 0);
+    release(child);
+    return result;
+}
+
+/**
+ * @brief returns a copy of the path to a specific element with the element replaced
+ *
+ * @param level - level of the current node
+ * @param node - the current node
+ * @param index - index of the element
+ * @param elem - the new value of the element
+ * @return Node*
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::assign(unsigned level, const Node* node, size_t index, const Type& elem)
+{
+    if(level == 0)
+    {
+        Leaf* leaf = copyLeaf(node, 0);
+        leaf->values[index & MASK] = elem;
+        return leaf;
+    }
+
+    Branch* branch = copyBranch(node, 0);
+    size_t subindex = (index >> level) & MASK;
+    Node* child = branch->children[subindex];
+    branch->children[subindex] = assign(level - BITS, child, index, elem);
+    release(child);
+    return branch;
+}
+
+/**
+ * @brief Construct a new empty Persistent Vector object
+ */
+template <class Type>
+PersistentVector<Type>::PersistentVector() : count(0), shift(BITS), root(nullptr), tail(nullptr)
+{
+
+}
+
+/**
+ * @brief Construct a new Persistent Vector object with a copy of each of the elements in an array
+ *
+ * @param other - container from which to copy the elements
+ */
+template <class Type>
+PersistentVector<Type>::PersistentVector(const DynamicArray<Type>& other) : PersistentVector()
+{
+    Transient builder(*this);
+    for(size_t i = 0; i < other.size(); ++i)
+    {
+        builder.push_back(other[i]);
+    }
+    *this = builder.persistent();
+}
+
+/**
+ * @brief Construct a new Persistent Vector object that shares all nodes with other
+ *
+ * @param other - vector whose nodes are shared
+ */
+template <class Type>
+PersistentVector<Type>::PersistentVector(const PersistentVector<Type>& other)
+    : count(other.count), shift(other.shift), root(retain(other.root)), tail(static_cast<Leaf*>(retain(other.tail)))
+{
+
+}
+
+/**
+ * @brief Shares the nodes of other, releasing the current ones
+ *
+ * @param other - vector whose nodes are shared
+ * @return PersistentVector<Type>&
+ */
+template <class Type>
+PersistentVector<Type>& PersistentVector<Type>::operator=(const PersistentVector<Type>& other)
+{
+    if(this != &other)
+    {
+        retain(other.root);
+        retain(other.tail);
+        release(root);
+        release(tail);
+
+        count = other.count;
+        shift = other.shift;
+        root = other.root;
+        tail = other.tail;
+    }
+    return *this;
+}
+
+/**
+ * @brief Destroy the Persistent Vector object
+ */
+template <class Type>
+PersistentVector<Type>::~PersistentVector()
+{
+    release(root);
+    release(tail);
+}
+
+/**
+ * @brief returns a new version of the vector with an element added to its end
+ *
+ * @param elem - element to be pushed
+ * @return PersistentVector<Type>
+ */
+template <class Type>
+PersistentVector<Type> PersistentVector<Type>::push_back(const Type& elem)const
+{
+    if(count - tailOffset() < WIDTH)
+    {
+        Leaf* newTail = copyLeaf(tail, 0);
+        newTail->values[count & MASK] = elem;
+        return PersistentVector<Type>(count + 1, shift, retain(root), newTail);
+    }
+
+    Leaf* newTail = new Leaf(0);
+    newTail->values[0] = elem;
+
+    retain(tail);
+    if((count >> BITS) > (size_t(1) << shift))
+    {
+        Branch* newRoot = new Branch(0);
+        newRoot->children[0] = retain(root);
+        newRoot->children[1] = newPath(shift, tail, 0);
+        return PersistentVector<Type>(count + 1, shift + BITS, newRoot, newTail);
+    }
+
+    return PersistentVector<Type>(count + 1, shift, pushTail(shift, root, tail), newTail);
+}
+
+/**
+ * @brief returns a new version of the vector with the element at a specified index replaced
+ *
+ * @param index - index of the element to be replaced
+ * @param elem - the new value of the element
+ * @return PersistentVector<Type>
+ */
+template <class Type>
+PersistentVector<Type> PersistentVector<Type>::set(size_t index, const Type& elem)const
+{
+    if(index >= count)
+        throw std::out_of_range("The index is out of range!");
+
+    if(index >= tailOffset())
+    {
+        Leaf* newTail = copyLeaf(tail, 0);
+        newTail->values[index & MASK] = elem;
+        return PersistentVector<Type>(count, shift, retain(root), newTail);
+    }
+
+    return PersistentVector<Type>(count, shift, assign(shift, root, index, elem), static_cast<Leaf*>(retain(tail)));
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified index.
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type>
+const Type& PersistentVector<Type>::at(size_t index)const
+{
+    if(index < count)
+        return leafFor(index)->values[index & MASK];
+    throw std::out_of_range("The index is out of range!");
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified index.
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type>
+const Type& PersistentVector<Type>::operator[](size_t index)const
+{
+    DYNAMIC_ARRAY_CHECK(index < count);
+    return leafFor(index)->values[index & MASK];
+}
+
+/**
+ * @brief returns the number of the elements in the vector
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t PersistentVector<Type>::size()const
+{
+    return count;
+}
+
+/**
+ * @brief checks if the vector is empty
+ *
+ * @return true
+ * @return false
+ */
+template <class Type>
+bool PersistentVector<Type>::empty()const
+{
+    return count == 0;
+}
+
+/**
+ * @brief returns a builder that starts with the elements of the vector
+ *
+ * @return Transient
+ */
+template <class Type>
+typename PersistentVector<Type>::Transient PersistentVector<Type>::transient()const
+{
+    return Transient(*this);
+}
+
+/**
+ * @brief copies the elements of the vector into a DynamicArray
+ *
+ * @return DynamicArray<Type>
+ */
+template <class Type>
+DynamicArray<Type> PersistentVector<Type>::to_dynamic_array()const
+{
+    DynamicArray<Type> result(count);
+    for(size_t first = 0; first < count; first += WIDTH)
+    {
+        const Leaf* leaf = leafFor(first);
+        size_t last = count - first < WIDTH ? count - first : WIDTH;
+        for(size_t i = 0; i < last; ++i)
+        {
+            result.push_back(leaf->values[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Construct a new Transient object that starts with the elements of a vector
+ *
+ * @param vector - the initial content of the builder
+ */
+template <class Type>
+PersistentVector<Type>::Transient::Transient(const PersistentVector<Type>& vector)
+    : count(vector.count), shift(vector.shift), root(retain(vector.root)), tail(nullptr), owner(nextOwner())
+{
+    tail = copyLeaf(vector.tail, owner);
+}
+
+/**
+ * @brief Destroy the Transient object
+ */
+template <class Type>
+PersistentVector<Type>::Transient::~Transient()
+{
+    release(root);
+    release(tail);
+}
+
+/**
+ * @brief throws if persistent() has already been called
+ */
+template <class Type>
+void PersistentVector<Type>::Transient::ensureValid()const
+{
+    if(owner == 0)
+        throw std::logic_error("The transient is used after persistent() was called!");
+}
+
+/**
+ * @brief returns a version of a node that the transient can modify, copying the node if necessary
+ *
+ * @param node - the node, its reference is taken over; nullptr creates an empty branch
+ * @return Node*
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::Transient::editable(Node* node)const
+{
+    if(node && node->owner == owner)
+        return node;
+
+    Node* copy = node && node->leaf ? static_cast<Node*>(copyLeaf(node, owner)) : static_cast<Node*>(copyBranch(node, owner));
+    release(node);
+    return copy;
+}
+
+/**
+ * @brief appends the full tail to the last leaf of the trie, modifying the path in place
+ *
+ * @param level - level of the current branch
+ * @param parent - the current branch, its reference is taken over; may be nullptr
+ * @param tailNode - the full tail, its reference is taken over
+ * @return Node*
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::Transient::pushTail(unsigned level, Node* parent, Leaf* tailNode)
+{
+    Branch* result = static_cast<Branch*>(editable(parent));
+    size_t subindex = ((count - 1) >> level) & MASK;
+
+    if(level == BITS)
+    {
+        result->children[subindex] = tailNode;
+        return result;
+    }
+
+    Node* child = result->children[subindex];
+    result->children[subindex] = child ? pushTail(level - BITS, child, tailNode) : newPath(level - BITS, tailNode, owner);
+    return result;
+}
+
+/**
+ * @brief replaces an element, modifying the path to it in place
+ *
+ * @param level - level of the current node
+ * @param node - the current node, its reference is taken over
+ * @param index - index of the element
+ * @param elem - the new value of the element
+ * @return Node*
+ */
+template <class Type>
+typename PersistentVector<Type>::Node* PersistentVector<Type>::Transient::assign(unsigned level, Node* node, size_t index, const Type& elem)
+{
+    node = editable(node);
+
+    if(level == 0)
+    {
+        static_cast<Leaf*>(node)->values[index & MASK] = elem;
+        return node;
+    }
+
+    Branch* branch = static_cast<Branch*>(node);
+    size_t subindex = (index >> level) & MASK;
+    branch->children[subindex] = assign(level - BITS, branch->children[subindex], index, elem);
+    return branch;
+}
+
+/**
+ * @brief adds a new item to the end of the builder
+ *
+ * @param elem - element to be pushed
+ */
+template <class Type>
+void PersistentVector<Type>::Transient::push_back(const Type& elem)
+{
+    ensureValid();
+
+    size_t tailStart = count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+    if(count - tailStart < WIDTH)
+    {
+        tail->values[count & MASK] = elem;
+        ++count;
+        return;
+    }
+
+    Leaf* fullTail = tail;
+    tail = new Leaf(owner);
+    tail->values[0] = elem;
+
+    if((count >> BITS) > (size_t(1) << shift))
+    {
+        Branch* newRoot = new Branch(owner);
+        newRoot->children[0] = root;
+        newRoot->children[1] = newPath(shift, fullTail, owner);
+        root = newRoot;
+        shift += BITS;
+    }
+    else
+    {
+        root = pushTail(shift, root, fullTail);
+    }
+
+    ++count;
+}
+
+/**
+ * @brief replaces the element at a specified index
+ *
+ * @param index - index of the element to be replaced
+ * @param elem - the new value of the element
+ */
+template <class Type>
+void PersistentVector<Type>::Transient::set(size_t index, const Type& elem)
+{
+    ensureValid();
+
+    if(index >= count)
+        throw std::out_of_range("The index is out of range!");
+
+    size_t tailStart = count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+    if(index >= tailStart)
+    {
+        tail->values[index & MASK] = elem;
+        return;
+    }
+
+    root = assign(shift, root, index, elem);
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified index.
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type>
+const Type& PersistentVector<Type>::Transient::at(size_t index)const
+{
+    ensureValid();
+
+    if(index >= count)
+        throw std::out_of_range("The index is out of range!");
+
+    return (*this)[index];
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified index.
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type>
+const Type& PersistentVector<Type>::Transient::operator[](size_t index)const
+{
+    DYNAMIC_ARRAY_CHECK(index < count);
+
+    size_t tailStart = count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+    if(index >= tailStart)
+        return tail->values[index & MASK];
+
+    const Node* node = root;
+    for(unsigned level = shift; level > 0; level -= BITS)
+    {
+        node = static_cast<const Branch*>(node)->children[(index >> level) & MASK];
+    }
+    return static_cast<const Leaf*>(node)->values[index & MASK];
+}
+
+/**
+ * @brief returns the number of the elements in the builder
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t PersistentVector<Type>::Transient::size()const
+{
+    return count;
+}
+
+/**
+ * @brief returns a vector with the elements of the builder and invalidates the builder
+ *
+ * @return PersistentVector<Type>
+ */
+template <class Type>
+PersistentVector<Type> PersistentVector<Type>::Transient::persistent()
+{
+    ensureValid();
+
+    PersistentVector<Type> result(count, shift, root, tail);
+
+    count = 0;
+    root = nullptr;
+    tail = nullptr;
+    owner = 0;
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef _PUBLISHED_ARRAY_
+#define _PUBLISHED_ARRAY_
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "Buffer.hpp"
+#include "DynamicArray.hpp"
+
+/**
+ * @brief PublishedArray class is a class template of read-mostly arrays shared between threads in the style of
+ *  read-copy-update
+ *
+ *  Readers take snapshots of the current version without locks and writers publish a whole new version with
+ *  one atomic exchange. The replaced versions are freed with epoch-based reclamation: every reader announces
+ *  the global epoch in a slot on its own cache line while it holds a snapshot, a replaced version is tagged
+ *  with the epoch of its replacement and it is freed once every reader announces a later epoch or nothing.
+ *  Taking a snapshot is wait-free - two loads and a store - and readers never write a shared cache line.
+ *
+ * @tparam Type - type of the elements
+ */
+template <class Type>
+class PublishedArray
+{
+public:
+    static const size_t CACHE_LINE = 64;
+    static const size_t IDLE = size_t(-1);    ///epoch announced by readers without a snapshot
+
+private:
+    struct alignas(CACHE_LINE) ReaderSlot
+    {
+        std::atomic<size_t> epoch;
+        std::atomic<bool> taken;
+    };
+
+    struct Retired
+    {
+        DynamicArray<Type>* array;
+        size_t epoch;
+    };
+
+public:
+    class Snapshot;
+
+    /**
+     * @brief Reader class registers a reading thread, it must not be shared between threads
+     */
+    class Reader
+    {
+    private:
+        PublishedArray<Type>& published;
+        ReaderSlot& slot;
+        size_t depth;   ///number of the snapshots held by the reader
+
+        friend class Snapshot;
+
+    public:
+        explicit Reader(PublishedArray<Type>&);
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        ~Reader();
+
+    public:
+        Snapshot read();
+    };
+
+    /**
+     * @brief Snapshot class keeps a version of the array alive while it exists
+     */
+    class Snapshot
+    {
+    private:
+        Reader& reader;
+        const DynamicArray<Type>* version;
+
+    public:
+        explicit Snapshot(Reader&);
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        ~Snapshot();
+
+    public:
+        const DynamicArray<Type>& operator*()const;
+        const DynamicArray<Type>* operator->()const;
+        const DynamicArray<Type>& array()const;
+    };
+
+private:
+    alignas(CACHE_LINE) std::atomic<DynamicArray<Type>*> current;
+    alignas(CACHE_LINE) std::atomic<size_t> epoch;
+
+    Buffer<ReaderSlot> slots;
+
+    std::mutex writing;
+    DynamicArray<Retired> retiredVersions;
+
+private:
+    ReaderSlot& takeSlot();
+    size_t oldestEpoch()const;
+    void publishVersion(DynamicArray<Type>*);
+    size_t reclaimVersions();
+
+public:
+    explicit PublishedArray(size_t readers = 64);
+    explicit PublishedArray(const DynamicArray<Type>&, size_t readers = 64);
+    PublishedArray(const PublishedArray&) = delete;
+    PublishedArray& operator=(const PublishedArray&) = delete;
+    ~PublishedArray();
+
+public:
+    void publish(const DynamicArray<Type>&);
+    template <class Update>
+    void update(Update);
+
+    size_t reclaim();
+    void synchronize();
+    size_t retired();
+};
+
+/**
+ * @brief Construct a new Published Array object with an empty array
+ *
+ * @param readers - the largest number of readers at a time
+ */
+template <class Type>
+PublishedArray<Type>::PublishedArray(size_t readers) : PublishedArray(DynamicArray<Type>(), readers)
+{
+
+}
+
+/**
+ * @brief Construct a new Published Array object with a copy of an array as the first version
+ *
+ * @param array - the array
+ * @param readers - the largest number of readers at a time
+ */
+template <class Type>
+PublishedArray<Type>::PublishedArray(const DynamicArray<Type>& array, size_t readers)
+    : current(new DynamicArray<Type>(array)), epoch(0), slots(readers)
+{
+    for(ReaderSlot* slot = slots.begin(); slot != slots.end(); ++slot)
+    {
+        slot->epoch.store(IDLE, std::memory_order_relaxed);
+        slot->taken.store(false, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destroy the Published Array object with all of its versions, there must be no readers left
+ */
+template <class Type>
+PublishedArray<Type>::~PublishedArray()
+{
+    for(Retired& retired : retiredVersions)
+    {
+        delete retired.array;
+    }
+    delete current.load();
+}
+
+/**
+ * @brief takes a free reader slot
+ *
+ * @return ReaderSlot&
+ */
+template <class Type>
+typename PublishedArray<Type>::ReaderSlot& PublishedArray<Type>::takeSlot()
+{
+    for(ReaderSlot* slot = slots.begin(); slot != slots.end(); ++slot)
+    {
+        bool taken = false;
+        if(!slot->taken.load(std::memory_order_relaxed) && slot->taken.compare_exchange_strong(taken, true))
+            return *slot;
+    }
+    throw std::length_error("There are too many readers!");
+}
+
+/**
+ * @brief returns the oldest epoch announced by a reader, IDLE if no reader holds a snapshot
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t PublishedArray<Type>::oldestEpoch()const
+{
+    size_t oldest = IDLE;
+    for(const ReaderSlot* slot = slots.begin(); slot != slots.end(); ++slot)
+    {
+        size_t announced = slot->epoch.load();
+        oldest = announced < oldest ? announced : oldest;
+    }
+    return oldest;
+}
+
+/**
+ * @brief replaces the current version and retires the replaced one, the writing mutex must be locked
+ *
+ * @param version - the new version
+ */
+template <class Type>
+void PublishedArray<Type>::publishVersion(DynamicArray<Type>* version)
+{
+    try
+    {
+        retiredVersions.push_back(Retired{nullptr, 0});
+    }
+    catch(...)
+    {
+        delete version;
+        throw;
+    }
+
+    DynamicArray<Type>* replaced = current.exchange(version);
+    retiredVersions.back() = Retired{replaced, epoch.fetch_add(1)};
+    reclaimVersions();
+}
+
+/**
+ * @brief frees the retired versions no reader can hold anymore, the writing mutex must be locked
+ *
+ * @return size_t - number of the freed versions
+ */
+template <class Type>
+size_t PublishedArray<Type>::reclaimVersions()
+{
+    size_t oldest = oldestEpoch();
+    size_t kept = 0;
+    for(size_t i = 0; i < retiredVersions.size(); ++i)
+    {
+        if(retiredVersions[i].epoch < oldest)
+            delete retiredVersions[i].array;
+        else
+            retiredVersions[kept++] = retiredVersions[i];
+    }
+
+    size_t freed = retiredVersions.size() - kept;
+    retiredVersions.resize_default_init(kept);
+    return freed;
+}
+
+/**
+ * @brief publishes a copy of an array as the new version, readers see it with their next snapshot
+ *
+ * @param array - the array
+ */
+template <class Type>
+void PublishedArray<Type>::publish(const DynamicArray<Type>& array)
+{
+    DynamicArray<Type>* version = new DynamicArray<Type>(array);
+    std::lock_guard<std::mutex> lock(writing);
+    publishVersion(version);
+}
+
+/**
+ * @brief publishes a changed copy of the current version, the updates of several writers are serialized
+ *
+ * @param change - function that changes the copy, if it throws nothing is published
+ */
+template <class Type>
+template <class Update>
+void PublishedArray<Type>::update(Update change)
+{
+    std::lock_guard<std::mutex> lock(writing);
+    DynamicArray<Type>* version = new DynamicArray<Type>(*current.load());
+    try
+    {
+        change(*version);
+    }
+    catch(...)
+    {
+        delete version;
+        throw;
+    }
+    publishVersion(version);
+}
+
+/**
+ * @brief frees the retired versions no reader can hold anymore, publishing does this too
+ *
+ * @return size_t - number of the freed versions
+ */
+template <class Type>
+size_t PublishedArray<Type>::reclaim()
+{
+    std::lock_guard<std::mutex> lock(writing);
+    return reclaimVersions();
+}
+
+/**
+ * @brief waits until all retired versions are freed, it must not be called by a thread holding a snapshot
+ */
+template <class Type>
+void PublishedArray<Type>::synchronize()
+{
+    while(reclaim(), retired() > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief returns the number of the replaced versions that aren't freed yet
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t PublishedArray<Type>::retired()
+{
+    std::lock_guard<std::mutex> lock(writing);
+    return retiredVersions.size();
+}
+
+/**
+ * @brief Construct a new Reader object in a free reader slot
+ *
+ * @param published - the published array
+ */
+template <class Type>
+PublishedArray<Type>::Reader::Reader(PublishedArray<Type>& published) : published(published), slot(published.takeSlot()), depth(0)
+{
+
+}
+
+/**
+ * @brief Destroy the Reader object and free its slot, it must not hold snapshots
+ */
+template <class Type>
+PublishedArray<Type>::Reader::~Reader()
+{
+    slot.epoch.store(IDLE);
+    slot.taken.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief takes a snapshot of the current version
+ *
+ * @return Snapshot
+ */
+template <class Type>
+typename PublishedArray<Type>::Snapshot PublishedArray<Type>::Reader::read()
+{
+    return Snapshot(*this);
+}
+
+/**
+ * @brief Construct a new Snapshot object - announces the global epoch and loads the current version,
+ *  a nested snapshot of the same reader keeps the announcement of the outer one
+ *
+ * @param reader - the reader
+ */
+template <class Type>
+PublishedArray<Type>::Snapshot::Snapshot(Reader& reader) : reader(reader)
+{
+    if(reader.depth++ == 0)
+        reader.slot.epoch.store(reader.published.epoch.load());
+    version = reader.published.current.load();
+}
+
+/**
+ * @brief Destroy the Snapshot object, the version may be freed afterwards
+ */
+template <class Type>
+PublishedArray<Type>::Snapshot::~Snapshot()
+{
+    if(--reader.depth == 0)
+        reader.slot.epoch.store(IDLE, std::memory_order_release);
+}
+
+template <class Type>
+const DynamicArray<Type>& PublishedArray<Type>::Snapshot::operator*()const
+{
+    return *version;
+}
+
+template <class Type>
+const DynamicArray<Type>* PublishedArray<Type>::Snapshot::operator->()const
+{
+    return version;
+}
+
+/**
+ * @brief returns the version of the array held by the snapshot
+ *
+ * @return const DynamicArray<Type>&
+ */
+template <class Type>
+const DynamicArray<Type>& PublishedArray<Type>::Snapshot::array()const
+{
+    return *version;
+}
+
+#endif
@@ -0,0 +1,474 @@
+#ifndef _SHARDED_DYNAMIC_ARRAY_
+#define _SHARDED_DYNAMIC_ARRAY_
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "Buffer.hpp"
+#include "DynamicArray.hpp"
+#include "Parallel.hpp"
+
+/**
+ * @brief ShardedDynamicArray class is a class template of arrays built by many threads at once
+ *
+ *  Every thread fills a shard of its own with the usual functions of DynamicArray and the shards are merged
+ *  into one array in the end. The shards are on separate cache lines, so the threads don't slow each other
+ *  down by writing their sizes. The elements are in the order of the shards.
+ *
+ * @tparam Type - type of the elements
+ */
+template <class Type>
+class ShardedDynamicArray
+{
+public:
+    static const size_t CACHE_LINE = 64;
+
+private:
+    struct alignas(CACHE_LINE) Shard
+    {
+        DynamicArray<Type> array;
+    };
+
+public:
+    /**
+     * @brief View class is a read-only concatenation of the shards that doesn't copy them,
+     *  it is invalidated by any change of the shards
+     */
+    class View
+    {
+    public:
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Type* pointer;
+            typedef const Type& reference;
+
+        private:
+            const Shard* shards;
+            size_t shardCount;
+            size_t shard;
+            size_t index;
+
+        private:
+            void skipEmpty();
+
+        public:
+            iterator();
+            iterator(const Shard*, size_t, size_t);
+
+        public:
+            reference operator*()const;
+            pointer operator->()const;
+
+            iterator& operator++();
+            iterator operator++(int);
+
+            bool operator==(const iterator&)const;
+            bool operator!=(const iterator&)const;
+        };
+
+    private:
+        const Shard* shards;
+        DynamicArray<size_t> offsets;   ///index of the first element of every shard and the size in the end
+
+    public:
+        View(const Shard*, const DynamicArray<size_t>&);
+
+    public:
+        const Type& operator[](size_t)const;
+        const Type& at(size_t)const;
+
+        iterator begin()const;
+        iterator end()const;
+
+        size_t size()const;
+        bool empty()const;
+    };
+
+private:
+    Buffer<Shard> shards;
+
+private:
+    static size_t checkShards(size_t);
+    DynamicArray<size_t> offsets()const;
+
+public:
+    explicit ShardedDynamicArray(size_t shards = parallelThreads());
+    ShardedDynamicArray(const ShardedDynamicArray&) = delete;
+    ShardedDynamicArray& operator=(const ShardedDynamicArray&) = delete;
+
+public:
+    DynamicArray<Type>& shard(size_t);
+    const DynamicArray<Type>& shard(size_t)const;
+    size_t shard_count()const;
+
+    size_t size()const;
+    bool empty()const;
+    void clear();
+
+    void merge_into(DynamicArray<Type>&, size_t threads = parallelThreads())const;
+    DynamicArray<Type> merge(size_t threads = parallelThreads())const;
+    View view()const;
+};
+
+/**
+ * @brief checks the number of shards of the constructor
+ *
+ * @param shards - number of the shards
+ * @return size_t - number of the shards
+ */
+template <class Type>
+size_t ShardedDynamicArray<Type>::checkShards(size_t shards)
+{
+    if(shards == 0)
+        throw std::invalid_argument("There must be at least one shard!");
+    return shards;
+}
+
+/**
+ * @brief Construct a new Sharded Dynamic Array object with empty shards
+ *
+ * @param shards - number of the shards, usually the number of the threads filling them
+ */
+template <class Type>
+ShardedDynamicArray<Type>::ShardedDynamicArray(size_t shards) : shards(checkShards(shards))
+{
+
+}
+
+/**
+ * @brief returns the prefix sums of the sizes of the shards - the index of the first element of every shard
+ *  in the merged array and the size of the merged array in the end
+ *
+ * @return DynamicArray<size_t>
+ */
+template <class Type>
+DynamicArray<size_t> ShardedDynamicArray<Type>::offsets()const
+{
+    DynamicArray<size_t> offsets(shards.size() + 1);
+    offsets.push_back(0);
+    for(const Shard* shard = shards.begin(); shard != shards.end(); ++shard)
+    {
+        offsets.push_back(offsets.back() + shard->array.size());
+    }
+    return offsets;
+}
+
+/**
+ * @brief returns a shard, every shard must be used by one thread at a time
+ *
+ * @param index - index of the shard
+ * @return DynamicArray<Type>&
+ */
+template <class Type>
+DynamicArray<Type>& ShardedDynamicArray<Type>::shard(size_t index)
+{
+    if(index >= shards.size())
+        throw std::out_of_range("The index of the shard is out of range!");
+    return shards.begin()[index].array;
+}
+
+/**
+ * @brief returns a shard
+ *
+ * @param index - index of the shard
+ * @return const DynamicArray<Type>&
+ */
+template <class Type>
+const DynamicArray<Type>& ShardedDynamicArray<Type>::shard(size_t index)const
+{
+    if(index >= shards.size())
+        throw std::out_of_range("The index of the shard is out of range!");
+    return shards.begin()[index].array;
+}
+
+/**
+ * @brief returns the number of the shards
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t ShardedDynamicArray<Type>::shard_count()const
+{
+    return shards.size();
+}
+
+/**
+ * @brief returns the number of the elements of all shards
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t ShardedDynamicArray<Type>::size()const
+{
+    size_t size = 0;
+    for(const Shard* shard = shards.begin(); shard != shards.end(); ++shard)
+    {
+        size += shard->array.size();
+    }
+    return size;
+}
+
+/**
+ * @brief checks if all shards are empty
+ *
+ * @return true - if they are
+ * @return false - otherwise
+ */
+template <class Type>
+bool ShardedDynamicArray<Type>::empty()const
+{
+    return size() == 0;
+}
+
+/**
+ * @brief clears all shards, keeping their capacities for the next round
+ */
+template <class Type>
+void ShardedDynamicArray<Type>::clear()
+{
+    for(Shard* shard = shards.begin(); shard != shards.end(); ++shard)
+    {
+        shard->array.clear();
+    }
+}
+
+/**
+ * @brief appends the elements of all shards to an array
+ *  - the offsets of the shards are computed first, so the array grows only once
+ *  - the copying is split evenly between the threads, regardless of the sizes of the shards
+ *  - if copying an element throws, the array is truncated to its old size and the exception is rethrown
+ *
+ * @param out - the array, it must not be one of the shards
+ * @param threads - number of threads to be used, small merges use one thread
+ */
+template <class Type>
+void ShardedDynamicArray<Type>::merge_into(DynamicArray<Type>& out, size_t threads)const
+{
+    DynamicArray<size_t> bounds = offsets();
+    size_t total = bounds.back();
+    size_t start = out.size();
+    Type* target = out.append_uninitialized(total).data();
+
+    auto copyRange = [&](size_t first, size_t last)
+    {
+        size_t shard = std::upper_bound(bounds.data(), bounds.data() + bounds.size(), first) - bounds.data() - 1;
+        while(first < last)
+        {
+            size_t end = std::min(last, bounds[shard + 1]);
+            const Type* source = shards.begin()[shard].array.data();
+            std::copy(source + (first - bounds[shard]), source + (end - bounds[shard]), target + first);
+            first = end;
+            ++shard;
+        }
+    };
+
+    threads = limitThreads(total, threads);
+
+    try
+    {
+        if(threads <= 1)
+        {
+            copyRange(0, total);
+            return;
+        }
+
+        runParallelRanges(total, threads, copyRange);
+    }
+    catch(...)
+    {
+        out.resize_default_init(start);
+        throw;
+    }
+}
+
+/**
+ * @brief returns a new array with the elements of all shards, see merge_into
+ *
+ * @param threads - number of threads to be used
+ * @return DynamicArray<Type>
+ */
+template <class Type>
+DynamicArray<Type> ShardedDynamicArray<Type>::merge(size_t threads)const
+{
+    DynamicArray<Type> out;
+    merge_into(out, threads);
+    return out;
+}
+
+/**
+ * @brief returns a view of the shards as one array
+ *
+ * @return View
+ */
+template <class Type>
+typename ShardedDynamicArray<Type>::View ShardedDynamicArray<Type>::view()const
+{
+    return View(shards.begin(), offsets());
+}
+
+/**
+ * @brief Construct a new View object
+ *
+ * @param shards - pointer to the first shard
+ * @param offsets - the prefix sums of the sizes of the shards
+ */
+template <class Type>
+ShardedDynamicArray<Type>::View::View(const Shard* shards, const DynamicArray<size_t>& offsets) : shards(shards), offsets(offsets)
+{
+
+}
+
+/**
+ * @brief returns the element at an index of the concatenation, finding its shard by a binary search
+ *
+ * @param index - the index
+ * @return const Type&
+ */
+template <class Type>
+const Type& ShardedDynamicArray<Type>::View::operator[](size_t index)const
+{
+    size_t shard = std::upper_bound(offsets.data(), offsets.data() + offsets.size(), index) - offsets.data() - 1;
+    return shards[shard].array[index - offsets[shard]];
+}
+
+/**
+ * @brief returns the element at an index of the concatenation with a bounds check
+ *
+ * @param index - the index
+ * @return const Type&
+ */
+template <class Type>
+const Type& ShardedDynamicArray<Type>::View::at(size_t index)const
+{
+    if(index >= size())
+        throw std::out_of_range("The index is out of range!");
+    return (*this)[index];
+}
+
+/**
+ * @brief returns an iterator to the first element
+ *
+ * @return iterator
+ */
+template <class Type>
+typename ShardedDynamicArray<Type>::View::iterator ShardedDynamicArray<Type>::View::begin()const
+{
+    return iterator(shards, offsets.size() - 1, 0);
+}
+
+/**
+ * @brief returns an iterator past the last element
+ *
+ * @return iterator
+ */
+template <class Type>
+typename ShardedDynamicArray<Type>::View::iterator ShardedDynamicArray<Type>::View::end()const
+{
+    return iterator(shards, offsets.size() - 1, offsets.size() - 1);
+}
+
+/**
+ * @brief returns the number of the elements
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t ShardedDynamicArray<Type>::View::size()const
+{
+    return offsets.back();
+}
+
+/**
+ * @brief checks if there are no elements
+ *
+ * @return true - if there are none
+ * @return false - otherwise
+ */
+template <class Type>
+bool ShardedDynamicArray<Type>::View::empty()const
+{
+    return size() == 0;
+}
+
+/**
+ * @brief Construct a new iterator object that doesn't point to any element
+ */
+template <class Type>
+ShardedDynamicArray<Type>::View::iterator::iterator() : shards(nullptr), shardCount(0), shard(0), index(0)
+{
+
+}
+
+/**
+ * @brief Construct a new iterator object at the first element of a shard or of the next non-empty one
+ *
+ * @param shards - pointer to the first shard
+ * @param count - number of the shards
+ * @param shard - index of the shard, count for the end
+ */
+template <class Type>
+ShardedDynamicArray<Type>::View::iterator::iterator(const Shard* shards, size_t count, size_t shard)
+    : shards(shards), shardCount(count), shard(shard), index(0)
+{
+    skipEmpty();
+}
+
+/**
+ * @brief moves to the next shard while the iterator is past the end of its shard
+ */
+template <class Type>
+void ShardedDynamicArray<Type>::View::iterator::skipEmpty()
+{
+    while(shard < shardCount && index == shards[shard].array.size())
+    {
+        ++shard;
+        index = 0;
+    }
+}
+
+template <class Type>
+typename ShardedDynamicArray<Type>::View::iterator::reference ShardedDynamicArray<Type>::View::iterator::operator*()const
+{
+    return shards[shard].array[index];
+}
+
+template <class Type>
+typename ShardedDynamicArray<Type>::View::iterator::pointer ShardedDynamicArray<Type>::View::iterator::operator->()const
+{
+    return &shards[shard].array[index];
+}
+
+template <class Type>
+typename ShardedDynamicArray<Type>::View::iterator& ShardedDynamicArray<Type>::View::iterator::operator++()
+{
+    ++index;
+    skipEmpty();
+    return *this;
+}
+
+template <class Type>
+typename ShardedDynamicArray<Type>::View::iterator ShardedDynamicArray<Type>::View::iterator::operator++(int)
+{
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+template <class Type>
+bool ShardedDynamicArray<Type>::View::iterator::operator==(const iterator& other)const
+{
+    return shard == other.shard && index == other.index;
+}
+
+template <class Type>
+bool ShardedDynamicArray<Type>::View::iterator::operator!=(const iterator& other)const
+{
+    return !(*this == other);
+}
+
+#endif
@@ -0,0 +1,410 @@
+#ifndef _SHARED_DYNAMIC_ARRAY_
+#define _SHARED_DYNAMIC_ARRAY_
+
+#include <atomic>
+#include <stdexcept>
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief SharedDynamicArray class is a class template that shares one DynamicArray between all of its copies
+ *  and copies the elements only when a shared array is modified (copy-on-write)
+ *
+ *  Copies and snapshots take O(1) time. The reference counter is atomic, so different
+ *  SharedDynamicArray objects that share the same elements can be read and modified from different
+ *  threads - a writer detaches its own copy and never changes elements visible to the readers.
+ *  A single object must not be modified while another thread accesses the same object.
+ *
+ * @tparam Type - type of data stored in the array
+ */
+template <class Type>
+class SharedDynamicArray
+{
+private:
+    struct Shared
+    {
+        std::atomic<size_t> references;
+        DynamicArray<Type> array;
+
+        Shared();
+        Shared(size_t);
+        Shared(const DynamicArray<Type>&);
+    };
+
+    Shared* shared;
+
+private:
+    void release();
+    void detach();
+
+public:
+    SharedDynamicArray();
+    SharedDynamicArray(size_t size);
+    SharedDynamicArray(const DynamicArray<Type>&);
+    SharedDynamicArray(const SharedDynamicArray<Type>&);
+    SharedDynamicArray<Type>& operator=(const SharedDynamicArray<Type>&);
+    ~SharedDynamicArray();
+
+public:
+    SharedDynamicArray<Type> snapshot()const;
+    const DynamicArray<Type>& array()const;
+
+    size_t use_count()const;
+    bool unique()const;
+
+    void push_back(const Type&);
+    void pop_back();
+    void set(size_t, const Type&);
+
+    const Type& at(size_t)const;
+    const Type& operator[](size_t)const;
+
+    const Type& front()const;
+    const Type& back()const;
+
+    size_t size()const;
+    size_t capacity()const;
+    bool empty()const;
+
+    void clear();
+    void resize(size_t, Type value = Type());
+    void reserve(size_t);
+};
+
+/**
+ * @brief Construct a new Shared object with an empty array and one reference
+ */
+template <class Type>
+SharedDynamicArray<Type>::Shared::Shared() : references(1)
+{
+
+}
+
+/**
+ * @brief Construct a new Shared object with an empty array with a specific capacity and one reference
+ *
+ * @param size - capacity of the array
+ */
+template <class Type>
+SharedDynamicArray<Type>::Shared::Shared(size_t size) : references(1), array(size)
+{
+
+}
+
+/**
+ * @brief Construct a new Shared object with a copy of an array and one reference
+ *
+ * @param other - array from which to copy the elements
+ */
+template <class Type>
+SharedDynamicArray<Type>::Shared::Shared(const DynamicArray<Type>& other) : references(1), array(other)
+{
+
+}
+
+/**
+ * @brief drops the reference to the shared array and deletes it if it was the last one
+ */
+template <class Type>
+void SharedDynamicArray<Type>::release()
+{
+    if(shared->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete shared;
+
+    shared = nullptr;
+}
+
+/**
+ * @brief makes the object the only owner of its elements, copying them if they are shared
+ */
+template <class Type>
+void SharedDynamicArray<Type>::detach()
+{
+    if(shared->references.load(std::memory_order_acquire) == 1)
+        return;
+
+    Shared* copy = new Shared(shared->array);
+    release();
+    shared = copy;
+}
+
+/**
+ * @brief Construct a new Shared Dynamic Array object
+ */
+template <class Type>
+SharedDynamicArray<Type>::SharedDynamicArray() : shared(new Shared())
+{
+
+}
+
+/**
+ * @brief Construct a new Shared Dynamic Array object with a specific capacity
+ *
+ * @param size - capacity of the array
+ */
+template <class Type>
+SharedDynamicArray<Type>::SharedDynamicArray(size_t size) : shared(new Shared(size))
+{
+
+}
+
+/**
+ * @brief Construct a new Shared Dynamic Array object with a copy of the elements of a DynamicArray
+ *
+ * @param other - container from which to copy the elements
+ */
+template <class Type>
+SharedDynamicArray<Type>::SharedDynamicArray(const DynamicArray<Type>& other) : shared(new Shared(other))
+{
+
+}
+
+/**
+ * @brief Construct a new Shared Dynamic Array object that shares the elements of other
+ *
+ * @param other - container whose elements are shared
+ */
+template <class Type>
+SharedDynamicArray<Type>::SharedDynamicArray(const SharedDynamicArray<Type>& other) : shared(other.shared)
+{
+    shared->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Shares the elements of other, releasing the current ones
+ *
+ * @param other - container whose elements are shared
+ * @return SharedDynamicArray<Type>&
+ */
+template <class Type>
+SharedDynamicArray<Type>& SharedDynamicArray<Type>::operator=(const SharedDynamicArray<Type>& other)
+{
+    if(shared != other.shared)
+    {
+        other.shared->references.fetch_add(1, std::memory_order_relaxed);
+        release();
+        shared = other.shared;
+    }
+    return *this;
+}
+
+/**
+ * @brief Destroy the Shared Dynamic Array object
+ */
+template <class Type>
+SharedDynamicArray<Type>::~SharedDynamicArray()
+{
+    release();
+}
+
+/**
+ * @brief returns a read-only copy of the container in O(1)
+ *
+ * @return SharedDynamicArray<Type>
+ */
+template <class Type>
+SharedDynamicArray<Type> SharedDynamicArray<Type>::snapshot()const
+{
+    return SharedDynamicArray<Type>(*this);
+}
+
+/**
+ * @brief returns a constant reference to the underlying array
+ *
+ * @return const DynamicArray<Type>&
+ */
+template <class Type>
+const DynamicArray<Type>& SharedDynamicArray<Type>::array()const
+{
+    return shared->array;
+}
+
+/**
+ * @brief returns the number of objects that share the elements
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t SharedDynamicArray<Type>::use_count()const
+{
+    return shared->references.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief checks if the object is the only owner of its elements
+ *
+ * @return true
+ * @return false
+ */
+template <class Type>
+bool SharedDynamicArray<Type>::unique()const
+{
+    return use_count() == 1;
+}
+
+/**
+ * @brief adds a new item to the end of the container, copying the shared elements first
+ *
+ * @param elem - element to be pushed
+ */
+template <class Type>
+void SharedDynamicArray<Type>::push_back(const Type& elem)
+{
+    detach();
+    shared->array.push_back(elem);
+}
+
+/**
+ * @brief deletes the element at the end of the container, copying the shared elements first
+ */
+template <class Type>
+void SharedDynamicArray<Type>::pop_back()
+{
+    if(empty())
+        return;
+
+    detach();
+    shared->array.pop_back();
+}
+
+/**
+ * @brief replaces the element at a specified index, copying the shared elements first
+ *
+ * @param index - index of the element to be replaced
+ * @param elem - the new value of the element
+ */
+template <class Type>
+void SharedDynamicArray<Type>::set(size_t index, const Type& elem)
+{
+    if(index >= size())
+        throw std::out_of_range("The index is out of range!");
+
+    detach();
+    shared->array[index] = elem;
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified index.
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type>
+const Type& SharedDynamicArray<Type>::at(size_t index)const
+{
+    return array().at(index);
+}
+
+/**
+ * @brief returns a constant reference to the element at a specified index.
+ *
+ * @param index - index of the element to be returned
+ * @return const Type&
+ */
+template <class Type>
+const Type& SharedDynamicArray<Type>::operator[](size_t index)const
+{
+    return array()[index];
+}
+
+/**
+ * @brief return a constant reference to the first element
+ *
+ * @return const Type&
+ */
+template <class Type>
+const Type& SharedDynamicArray<Type>::front()const
+{
+    return array().front();
+}
+
+/**
+ * @brief return a constant reference to the last element
+ *
+ * @return const Type&
+ */
+template <class Type>
+const Type& SharedDynamicArray<Type>::back()const
+{
+    return array().back();
+}
+
+/**
+ * @brief returns the number of the elements in the container
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t SharedDynamicArray<Type>::size()const
+{
+    return array().size();
+}
+
+/**
+ * @brief returns the capacity of the container
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t SharedDynamicArray<Type>::capacity()const
+{
+    return array().capacity();
+}
+
+/**
+ * @brief checks of the container is empty
+ *
+ * @return true
+ * @return false
+ */
+template <class Type>
+bool SharedDynamicArray<Type>::empty()const
+{
+    return array().empty();
+}
+
+/**
+ * @brief erases the elements of the container
+ *  - if the elements are shared, only the reference to them is dropped and nothing is copied
+ */
+template <class Type>
+void SharedDynamicArray<Type>::clear()
+{
+    if(unique())
+    {
+        shared->array.clear();
+        return;
+    }
+
+    Shared* empty = new Shared();
+    release();
+    shared = empty;
+}
+
+/**
+ * @brief resizes the array with a spesific size and fills it with a specific value,
+ *  copying the shared elements first
+ *
+ * @param size - new size of the array
+ * @param value - value with which to fill the array
+ */
+template <class Type>
+void SharedDynamicArray<Type>::resize(size_t size, Type value)
+{
+    detach();
+    shared->array.resize(size, value);
+}
+
+/**
+ * @brief resizes the array with a spesific size, copying the shared elements first
+ *
+ * @param size - new size of the array
+ */
+template <class Type>
+void SharedDynamicArray<Type>::reserve(size_t size)
+{
+    detach();
+    shared->array.reserve(size);
+}
+
+#endif
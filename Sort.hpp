@@ -0,0 +1,499 @@
+#ifndef _SORT_
+#define _SORT_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Buffer.hpp"
+#include "DynamicArray.hpp"
+#include "Parallel.hpp"
+
+/**
+ * @brief RadixTraits is a class template that converts arithmetic values to unsigned integers
+ *  whose order is the same as the order of the values, so they can be sorted digit by digit
+ *
+ * @tparam Type - an integral or floating point type
+ */
+template <class Type, class Enable = void>
+struct RadixTraits
+{
+    static const bool sortable = false;
+};
+
+template <class Type>
+struct RadixTraits<Type, typename std::enable_if<std::is_integral<Type>::value && !std::is_same<Type, bool>::value>::type>
+{
+    typedef typename std::make_unsigned<Type>::type Unsigned;
+
+    static const bool sortable = true;
+
+    /**
+     * @brief flips the sign bit of signed values, so negative values come before positive ones
+     */
+    static Unsigned key(Type value)
+    {
+        Unsigned key = static_cast<Unsigned>(value);
+        if(std::is_signed<Type>::value)
+            key ^= Unsigned(1) << (sizeof(Type) * 8 - 1);
+        return key;
+    }
+};
+
+template <class Type>
+struct RadixTraits<Type, typename std::enable_if<std::is_floating_point<Type>::value && (sizeof(Type) == 4 || sizeof(Type) == 8)>::type>
+{
+    typedef typename std::conditional<sizeof(Type) == 4, uint32_t, uint64_t>::type Unsigned;
+
+    static const bool sortable = true;
+
+    /**
+     * @brief flips all bits of negative values and the sign bit of positive ones,
+     *  so the bit patterns are ordered as the values
+     */
+    static Unsigned key(Type value)
+    {
+        Unsigned key;
+        std::memcpy(&key, &value, sizeof(Type));
+
+        const Unsigned sign = Unsigned(1) << (sizeof(Type) * 8 - 1);
+        return key & sign ? ~key : key | sign;
+    }
+};
+
+/**
+ * @brief RadixOrder is a class template of comparisons of values by their radix keys, a total order
+ *  in which -0.0 comes before 0.0 and NaNs come first or last by their sign bit
+ *
+ * @tparam Type - an integral or floating point type
+ */
+template <class Type>
+struct RadixOrder
+{
+    bool operator()(Type lhs, Type rhs)const
+    {
+        return RadixTraits<Type>::key(lhs) < RadixTraits<Type>::key(rhs);
+    }
+};
+
+/**
+ * @brief sorts a range by the keys of its elements with a least significant digit radix sort
+ *  - every pass distributes the elements by one byte of their keys, and passes in which
+ *    all keys have the same byte are skipped
+ *  - the sort is stable
+ *
+ * @param first - pointer to the first element of the range
+ * @param size - number of the elements in the range
+ * @param scratch - storage for at least size elements
+ * @param key - returns the key of an element
+ */
+template <class Type, class KeyFunction>
+void radixSortRange(Type* first, size_t size, Type* scratch, KeyFunction key)
+{
+    typedef typename std::decay<decltype(key(*first))>::type Key;
+    typedef RadixTraits<Key> Traits;
+    typedef typename Traits::Unsigned Unsigned;
+
+    static_assert(Traits::sortable, "Radix sort requires integral or floating point keys");
+
+    const size_t passes = sizeof(Unsigned);
+    std::vector<size_t> counts(passes * 256, 0);
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        Unsigned digits = Traits::key(key(first[i]));
+        for(size_t pass = 0; pass < passes; ++pass)
+        {
+            ++counts[pass * 256 + ((digits >> (pass * 8)) & 0xFF)];
+        }
+    }
+
+    Type* from = first;
+    Type* to = scratch;
+
+    for(size_t pass = 0; pass < passes; ++pass)
+    {
+        size_t* count = counts.data() + pass * 256;
+        Unsigned firstDigit = (Traits::key(key(from[0])) >> (pass * 8)) & 0xFF;
+        if(count[firstDigit] == size)
+            continue;
+
+        size_t offset = 0;
+        for(size_t digit = 0; digit < 256; ++digit)
+        {
+            size_t current = count[digit];
+            count[digit] = offset;
+            offset += current;
+        }
+
+        for(size_t i = 0; i < size; ++i)
+        {
+            Unsigned digit = (Traits::key(key(from[i])) >> (pass * 8)) & 0xFF;
+            to[count[digit]++] = from[i];
+        }
+
+        std::swap(from, to);
+    }
+
+    if(from != first)
+        std::copy(from, from + size, first);
+}
+
+/**
+ * @brief sorts a slice of integral or floating point values with a radix sort
+ *
+ * @param slice - the slice to be sorted
+ * @param scratch - storage reused between sorts, it must have at least slice.size() elements
+ */
+template <class Type>
+void radix_sort(DynamicArraySlice<Type> slice, Buffer<Type>& scratch)
+{
+    if(scratch.size() < slice.size())
+        throw std::invalid_argument("The scratch buffer is smaller than the array");
+
+    if(slice.size() > 1)
+        radixSortRange(slice.data(), slice.size(), scratch.begin(), [](const Type& value) { return value; });
+}
+
+/**
+ * @brief sorts an array of integral or floating point values with a radix sort
+ *
+ * @param array - the array to be sorted
+ * @param scratch - storage reused between sorts, it must have at least array.size() elements
+ */
+template <class Type>
+void radix_sort(DynamicArray<Type>& array, Buffer<Type>& scratch)
+{
+    radix_sort(array.slice(), scratch);
+}
+
+/**
+ * @brief sorts a slice of integral or floating point values with a radix sort
+ *
+ * @param slice - the slice to be sorted
+ */
+template <class Type>
+void radix_sort(DynamicArraySlice<Type> slice)
+{
+    Buffer<Type> scratch(slice.size());
+    radix_sort(slice, scratch);
+}
+
+/**
+ * @brief sorts an array of integral or floating point values with a radix sort
+ *
+ * @param array - the array to be sorted
+ */
+template <class Type>
+void radix_sort(DynamicArray<Type>& array)
+{
+    radix_sort(array.slice());
+}
+
+/**
+ * @brief sorts a slice by an integral or floating point key of its elements with a stable radix sort
+ *
+ * @param slice - the slice to be sorted
+ * @param key - returns the key of an element
+ * @param scratch - storage reused between sorts, it must have at least slice.size() elements
+ */
+template <class Type, class KeyFunction>
+void radix_sort(DynamicArraySlice<Type> slice, KeyFunction key, Buffer<Type>& scratch)
+{
+    if(scratch.size() < slice.size())
+        throw std::invalid_argument("The scratch buffer is smaller than the array");
+
+    if(slice.size() > 1)
+        radixSortRange(slice.data(), slice.size(), scratch.begin(), key);
+}
+
+/**
+ * @brief sorts an array by an integral or floating point key of its elements with a stable radix sort,
+ *  e.g. (key, payload) pairs by their keys
+ *
+ * @param array - the array to be sorted
+ * @param key - returns the key of an element
+ * @param scratch - storage reused between sorts, it must have at least array.size() elements
+ */
+template <class Type, class KeyFunction>
+void radix_sort(DynamicArray<Type>& array, KeyFunction key, Buffer<Type>& scratch)
+{
+    radix_sort(array.slice(), key, scratch);
+}
+
+/**
+ * @brief sorts a slice by an integral or floating point key of its elements with a stable radix sort
+ *
+ * @param slice - the slice to be sorted
+ * @param key - returns the key of an element
+ */
+template <class Type, class KeyFunction>
+void radix_sort(DynamicArraySlice<Type> slice, KeyFunction key)
+{
+    Buffer<Type> scratch(slice.size());
+    radix_sort(slice, key, scratch);
+}
+
+/**
+ * @brief sorts an array by an integral or floating point key of its elements with a stable radix sort
+ *
+ * @param array - the array to be sorted
+ * @param key - returns the key of an element
+ */
+template <class Type, class KeyFunction>
+void radix_sort(DynamicArray<Type>& array, KeyFunction key)
+{
+    radix_sort(array.slice(), key);
+}
+
+/**
+ * @brief returns how many elements of the first range are among the first elements of the stable merge of two ranges
+ *
+ * @param lhs - the first sorted range
+ * @param lhsSize - size of the first range
+ * @param rhs - the second sorted range
+ * @param rhsSize - size of the second range
+ * @param diagonal - number of the first elements of the merge
+ * @param compare - ordering of the elements
+ * @return size_t
+ */
+template <class Type, class Compare>
+size_t mergePath(const Type* lhs, size_t lhsSize, const Type* rhs, size_t rhsSize, size_t diagonal, Compare compare)
+{
+    size_t low = diagonal > rhsSize ? diagonal - rhsSize : 0;
+    size_t high = diagonal < lhsSize ? diagonal : lhsSize;
+
+    while(low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if(!compare(rhs[diagonal - middle - 1], lhs[middle]))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+/**
+ * @brief sorts a range with a parallel merge sort
+ *  - the range is split into one run per thread and the runs are sorted concurrently
+ *  - the runs are merged pairwise into a scratch buffer, not by one multiway merge, so the runs are
+ *    merged in log2(threads) rounds that each pass over the whole range
+ *  - every merge is split by merge path into independent parts, so all threads work until the last
+ *    merge is done
+ *
+ * @param data - pointer to the first element of the range
+ * @param size - number of the elements in the range
+ * @param compare - ordering of the elements
+ * @param threads - number of threads to be used
+ * @param stable - whether equivalent elements have to keep their order
+ */
+template <class Type, class Compare>
+void parallelMergeSort(Type* data, size_t size, Compare compare, size_t threads, bool stable)
+{
+    const size_t minimumRun = 1 << 14;
+
+    threads = limitThreads(size, threads, minimumRun);
+
+    if(threads <= 1)
+    {
+        if(stable)
+            std::stable_sort(data, data + size, compare);
+        else
+            std::sort(data, data + size, compare);
+        return;
+    }
+
+    std::vector<size_t> bounds(threads + 1);
+    for(size_t i = 0; i <= threads; ++i)
+    {
+        bounds[i] = size * i / threads;
+    }
+
+    runParallel(threads, [&](size_t i)
+    {
+        if(stable)
+            std::stable_sort(data + bounds[i], data + bounds[i + 1], compare);
+        else
+            std::sort(data + bounds[i], data + bounds[i + 1], compare);
+    });
+
+    Buffer<Type> scratch(size);
+    Type* from = data;
+    Type* to = scratch.begin();
+
+    while(bounds.size() > 2)
+    {
+        size_t pairs = (bounds.size() - 1) / 2;
+        size_t parts = threads / pairs > 0 ? threads / pairs : 1;
+
+        if((bounds.size() - 1) % 2 == 1)
+            std::copy(from + bounds[bounds.size() - 2], from + bounds.back(), to + bounds[bounds.size() - 2]);
+
+        runParallel(pairs * parts, [&](size_t task)
+        {
+            size_t pair = task / parts;
+            size_t part = task % parts;
+
+            const Type* lhs = from + bounds[2 * pair];
+            const Type* rhs = from + bounds[2 * pair + 1];
+            size_t lhsSize = bounds[2 * pair + 1] - bounds[2 * pair];
+            size_t rhsSize = bounds[2 * pair + 2] - bounds[2 * pair + 1];
+
+            size_t begin = (lhsSize + rhsSize) * part / parts;
+            size_t end = (lhsSize + rhsSize) * (part + 1) / parts;
+            size_t lhsBegin = mergePath(lhs, lhsSize, rhs, rhsSize, begin, compare);
+            size_t lhsEnd = mergePath(lhs, lhsSize, rhs, rhsSize, end, compare);
+
+            std::merge(lhs + lhsBegin, lhs + lhsEnd, rhs + (begin - lhsBegin), rhs + (end - lhsEnd), to + bounds[2 * pair] + begin, compare);
+        });
+
+        std::vector<size_t> merged;
+        for(size_t i = 0; i < bounds.size(); i += 2)
+        {
+            merged.push_back(bounds[i]);
+        }
+        if(merged.back() != size)
+            merged.push_back(size);
+        bounds.swap(merged);
+
+        std::swap(from, to);
+    }
+
+    if(from != data)
+        std::copy(from, from + size, data);
+}
+
+/**
+ * @brief sorts a slice with a parallel merge sort
+ *
+ * @param slice - the slice to be sorted
+ * @param compare - ordering of the elements
+ * @param threads - number of threads to be used
+ */
+template <class Type, class Compare = std::less<Type>>
+void parallel_sort(DynamicArraySlice<Type> slice, Compare compare = Compare(), size_t threads = parallelThreads())
+{
+    parallelMergeSort(slice.data(), slice.size(), compare, threads, false);
+}
+
+/**
+ * @brief sorts an array with a parallel merge sort
+ *
+ * @param array - the array to be sorted
+ * @param compare - ordering of the elements
+ * @param threads - number of threads to be used
+ */
+template <class Type, class Compare = std::less<Type>>
+void parallel_sort(DynamicArray<Type>& array, Compare compare = Compare(), size_t threads = parallelThreads())
+{
+    parallel_sort(array.slice(), compare, threads);
+}
+
+/**
+ * @brief sorts a slice with a parallel merge sort, keeping the order of equivalent elements
+ *
+ * @param slice - the slice to be sorted
+ * @param compare - ordering of the elements
+ * @param threads - number of threads to be used
+ */
+template <class Type, class Compare = std::less<Type>>
+void parallel_stable_sort(DynamicArraySlice<Type> slice, Compare compare = Compare(), size_t threads = parallelThreads())
+{
+    parallelMergeSort(slice.data(), slice.size(), compare, threads, true);
+}
+
+/**
+ * @brief sorts an array with a parallel merge sort, keeping the order of equivalent elements
+ *
+ * @param array - the array to be sorted
+ * @param compare - ordering of the elements
+ * @param threads - number of threads to be used
+ */
+template <class Type, class Compare = std::less<Type>>
+void parallel_stable_sort(DynamicArray<Type>& array, Compare compare = Compare(), size_t threads = parallelThreads())
+{
+    parallel_stable_sort(array.slice(), compare, threads);
+}
+
+/**
+ * @brief number of the elements from which sort and stable_sort use a radix sort for integral
+ *  and floating point values, smaller slices are sorted by comparisons in the same order
+ */
+const size_t RADIX_SORT_THRESHOLD = 256;
+
+/**
+ * @brief sorts a slice in ascending order, choosing the algorithm by the type of the elements
+ *  - integral and floating point values are sorted with a radix sort, or in the same order by
+ *    comparisons if there are few of them, floating point values are ordered as by RadixOrder
+ *  - other types are sorted with a parallel merge sort
+ *
+ * @param slice - the slice to be sorted
+ */
+template <class Type>
+void sort(DynamicArraySlice<Type> slice)
+{
+    if constexpr(RadixTraits<Type>::sortable)
+    {
+        if(slice.size() >= RADIX_SORT_THRESHOLD)
+            radix_sort(slice);
+        else
+            std::sort(slice.begin(), slice.end(), RadixOrder<Type>());
+        return;
+    }
+
+    parallel_sort(slice);
+}
+
+/**
+ * @brief sorts an array in ascending order, choosing the algorithm by the type of the elements
+ *
+ * @param array - the array to be sorted
+ */
+template <class Type>
+void sort(DynamicArray<Type>& array)
+{
+    sort(array.slice());
+}
+
+/**
+ * @brief sorts a slice in ascending order, keeping the order of equivalent elements and
+ *  choosing the algorithm by the type of the elements
+ *  - integral and floating point values are sorted with a radix sort, or in the same order by
+ *    stable comparisons if there are few of them, floating point values are ordered as by RadixOrder
+ *  - other types are sorted with a parallel merge sort
+ *
+ * @param slice - the slice to be sorted
+ */
+template <class Type>
+void stable_sort(DynamicArraySlice<Type> slice)
+{
+    if constexpr(RadixTraits<Type>::sortable)
+    {
+        if(slice.size() >= RADIX_SORT_THRESHOLD)
+            radix_sort(slice);
+        else
+            std::stable_sort(slice.begin(), slice.end(), RadixOrder<Type>());
+        return;
+    }
+
+    parallel_stable_sort(slice);
+}
+
+/**
+ * @brief sorts an array in ascending order, keeping the order of equivalent elements and
+ *  choosing the algorithm by the type of the elements
+ *
+ * @param array - the array to be sorted
+ */
+template <class Type>
+void stable_sort(DynamicArray<Type>& array)
+{
+    stable_sort(array.slice());
+}
+
+#endif
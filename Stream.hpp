@@ -0,0 +1,708 @@
+#ifndef _STREAM_
+#define _STREAM_
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "DynamicArray.hpp"
+
+/**
+ * @brief Generator class is a class template of coroutines that produce a sequence of values with co_yield,
+ *  it is consumed as a range
+ *
+ *  The coroutine runs only when the next value is requested, so a value refers to state of the coroutine
+ *  that stays valid until the iterator moves on.
+ *
+ * @tparam Value - type of the values
+ */
+template <class Value>
+class Generator
+{
+public:
+    struct promise_type
+    {
+        const Value* current = nullptr;
+        std::exception_ptr error;
+
+        Generator get_return_object();
+        std::suspend_always initial_suspend()noexcept;
+        std::suspend_always final_suspend()noexcept;
+        std::suspend_always yield_value(const Value&)noexcept;
+        void return_void();
+        void unhandled_exception();
+    };
+
+    class iterator
+    {
+    private:
+        std::coroutine_handle<promise_type> coroutine;
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+
+        iterator();
+        explicit iterator(std::coroutine_handle<promise_type>);
+
+        const Value& operator*()const;
+        iterator& operator++();
+        void operator++(int);
+        bool operator==(std::default_sentinel_t)const;
+    };
+
+private:
+    std::coroutine_handle<promise_type> coroutine;
+
+private:
+    static void advance(std::coroutine_handle<promise_type>);
+
+public:
+    explicit Generator(std::coroutine_handle<promise_type>);
+    Generator(Generator&&)noexcept;
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator();
+
+public:
+    iterator begin();
+    std::default_sentinel_t end()const;
+};
+
+/**
+ * @brief StreamTask class is a coroutine of a stage of a pipeline, it is started and resumed by a StreamScheduler
+ *
+ *  An exception that escapes the coroutine ends it and is rethrown by get.
+ */
+class StreamTask
+{
+public:
+    struct promise_type
+    {
+        std::exception_ptr error;
+
+        StreamTask get_return_object();
+        std::suspend_always initial_suspend()noexcept;
+        std::suspend_always final_suspend()noexcept;
+        void return_void();
+        void unhandled_exception();
+    };
+
+private:
+    std::coroutine_handle<promise_type> coroutine;
+
+public:
+    explicit StreamTask(std::coroutine_handle<promise_type>);
+    StreamTask(StreamTask&&)noexcept;
+    StreamTask(const StreamTask&) = delete;
+    StreamTask& operator=(const StreamTask&) = delete;
+    ~StreamTask();
+
+public:
+    std::coroutine_handle<> handle()const;
+    bool done()const;
+    void get()const;
+};
+
+/**
+ * @brief StreamScheduler class runs the stages of a pipeline on the calling thread, resuming one ready
+ *  coroutine at a time until none is ready
+ */
+class StreamScheduler
+{
+private:
+    std::deque<std::coroutine_handle<>> ready;
+
+public:
+    void schedule(std::coroutine_handle<>);
+    void spawn(const StreamTask&);
+    void run();
+};
+
+/**
+ * @brief BatchChannel class passes batches of elements from one producing stage to one consuming stage
+ *  of a pipeline with backpressure
+ *
+ *  The producer appends batches to the array of the channel until it holds the limit of elements,
+ *  then it is suspended until the consumer has taken them. The consumer gets all appended elements at once
+ *  as a span that stays valid until its next read, so the channel never holds more than the limit
+ *  (or one larger batch) and its storage is reused for every read.
+ *
+ * @tparam Type - type of the elements
+ */
+template <class Type>
+class BatchChannel
+{
+public:
+    class WriteAwaiter
+    {
+    private:
+        BatchChannel* channel;
+        std::span<const Type> batch;
+
+    public:
+        WriteAwaiter(BatchChannel*, std::span<const Type>);
+
+        bool await_ready()const;
+        void await_suspend(std::coroutine_handle<>);
+        void await_resume();
+    };
+
+    class ReadAwaiter
+    {
+    private:
+        BatchChannel* channel;
+
+    public:
+        explicit ReadAwaiter(BatchChannel*);
+
+        bool await_ready()const;
+        void await_suspend(std::coroutine_handle<>);
+        std::span<const Type> await_resume();
+    };
+
+private:
+    StreamScheduler* scheduler;
+    DynamicArray<Type> buffered;
+    size_t limit;
+    size_t highWater;
+    bool delivered;     ///the consumer holds a span of the buffered elements
+    bool closed;
+    std::coroutine_handle<> producer;
+    std::coroutine_handle<> consumer;
+
+private:
+    void wake(std::coroutine_handle<>&);
+
+public:
+    BatchChannel(StreamScheduler&, size_t);
+    BatchChannel(const BatchChannel&) = delete;
+    BatchChannel& operator=(const BatchChannel&) = delete;
+
+public:
+    WriteAwaiter write(std::span<const Type>);
+    ReadAwaiter read();
+    void close();
+
+    size_t high_water()const;
+};
+
+/**
+ * @brief returns the generator of a coroutine
+ *
+ * @return Generator
+ */
+template <class Value>
+Generator<Value> Generator<Value>::promise_type::get_return_object()
+{
+    return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+template <class Value>
+std::suspend_always Generator<Value>::promise_type::initial_suspend()noexcept
+{
+    return {};
+}
+
+template <class Value>
+std::suspend_always Generator<Value>::promise_type::final_suspend()noexcept
+{
+    return {};
+}
+
+/**
+ * @brief keeps the address of a yielded value, it lives until the coroutine is resumed
+ *
+ * @param value - the value
+ * @return std::suspend_always
+ */
+template <class Value>
+std::suspend_always Generator<Value>::promise_type::yield_value(const Value& value)noexcept
+{
+    current = &value;
+    return {};
+}
+
+template <class Value>
+void Generator<Value>::promise_type::return_void()
+{
+
+}
+
+/**
+ * @brief keeps an exception that escaped the coroutine, it is rethrown by the iterator
+ */
+template <class Value>
+void Generator<Value>::promise_type::unhandled_exception()
+{
+    error = std::current_exception();
+}
+
+/**
+ * @brief Construct a new iterator object that is equal to the end
+ */
+template <class Value>
+Generator<Value>::iterator::iterator()
+{
+
+}
+
+/**
+ * @brief Construct a new iterator object of a started coroutine
+ *
+ * @param coroutine - the coroutine
+ */
+template <class Value>
+Generator<Value>::iterator::iterator(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine)
+{
+
+}
+
+/**
+ * @brief returns the last yielded value
+ *
+ * @return const Value&
+ */
+template <class Value>
+const Value& Generator<Value>::iterator::operator*()const
+{
+    return *coroutine.promise().current;
+}
+
+/**
+ * @brief resumes the coroutine until it yields the next value or ends
+ *
+ * @return iterator&
+ */
+template <class Value>
+typename Generator<Value>::iterator& Generator<Value>::iterator::operator++()
+{
+    advance(coroutine);
+    return *this;
+}
+
+template <class Value>
+void Generator<Value>::iterator::operator++(int)
+{
+    ++*this;
+}
+
+/**
+ * @brief checks if the coroutine has ended
+ *
+ * @return true
+ * @return false
+ */
+template <class Value>
+bool Generator<Value>::iterator::operator==(std::default_sentinel_t)const
+{
+    return !coroutine || coroutine.done();
+}
+
+/**
+ * @brief resumes a coroutine and rethrows an exception that escaped it
+ *
+ * @param coroutine - the coroutine
+ */
+template <class Value>
+void Generator<Value>::advance(std::coroutine_handle<promise_type> coroutine)
+{
+    coroutine.resume();
+    if(coroutine.done() && coroutine.promise().error)
+        std::rethrow_exception(std::exchange(coroutine.promise().error, nullptr));
+}
+
+/**
+ * @brief Construct a new Generator object that owns a coroutine
+ *
+ * @param coroutine - the coroutine
+ */
+template <class Value>
+Generator<Value>::Generator(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine)
+{
+
+}
+
+/**
+ * @brief Construct a new Generator object taking the coroutine of another one
+ *
+ * @param other - the other generator
+ */
+template <class Value>
+Generator<Value>::Generator(Generator&& other)noexcept : coroutine(std::exchange(other.coroutine, nullptr))
+{
+
+}
+
+/**
+ * @brief Destroy the Generator object and its coroutine
+ */
+template <class Value>
+Generator<Value>::~Generator()
+{
+    if(coroutine)
+        coroutine.destroy();
+}
+
+/**
+ * @brief starts the coroutine and returns an iterator to its first value
+ *
+ * @return iterator
+ */
+template <class Value>
+typename Generator<Value>::iterator Generator<Value>::begin()
+{
+    if(!coroutine)
+        return iterator();
+
+    advance(coroutine);
+    return iterator(coroutine);
+}
+
+template <class Value>
+std::default_sentinel_t Generator<Value>::end()const
+{
+    return std::default_sentinel;
+}
+
+/**
+ * @brief returns the task of a coroutine
+ *
+ * @return StreamTask
+ */
+inline StreamTask StreamTask::promise_type::get_return_object()
+{
+    return StreamTask(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+inline std::suspend_always StreamTask::promise_type::initial_suspend()noexcept
+{
+    return {};
+}
+
+inline std::suspend_always StreamTask::promise_type::final_suspend()noexcept
+{
+    return {};
+}
+
+inline void StreamTask::promise_type::return_void()
+{
+
+}
+
+/**
+ * @brief keeps an exception that escaped the coroutine, it is rethrown by get
+ */
+inline void StreamTask::promise_type::unhandled_exception()
+{
+    error = std::current_exception();
+}
+
+/**
+ * @brief Construct a new Stream Task object that owns a coroutine
+ *
+ * @param coroutine - the coroutine
+ */
+inline StreamTask::StreamTask(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine)
+{
+
+}
+
+/**
+ * @brief Construct a new Stream Task object taking the coroutine of another one
+ *
+ * @param other - the other task
+ */
+inline StreamTask::StreamTask(StreamTask&& other)noexcept : coroutine(std::exchange(other.coroutine, nullptr))
+{
+
+}
+
+/**
+ * @brief Destroy the Stream Task object and its coroutine, also if the coroutine is suspended
+ */
+inline StreamTask::~StreamTask()
+{
+    if(coroutine)
+        coroutine.destroy();
+}
+
+/**
+ * @brief returns the handle used to resume the coroutine
+ *
+ * @return std::coroutine_handle<>
+ */
+inline std::coroutine_handle<> StreamTask::handle()const
+{
+    return coroutine;
+}
+
+/**
+ * @brief checks if the coroutine has ended
+ *
+ * @return true
+ * @return false
+ */
+inline bool StreamTask::done()const
+{
+    return coroutine.done();
+}
+
+/**
+ * @brief rethrows the exception that ended the coroutine, if there was one
+ */
+inline void StreamTask::get()const
+{
+    if(coroutine.promise().error)
+        std::rethrow_exception(coroutine.promise().error);
+}
+
+/**
+ * @brief marks a suspended coroutine as ready to be resumed
+ *
+ * @param coroutine - the coroutine
+ */
+inline void StreamScheduler::schedule(std::coroutine_handle<> coroutine)
+{
+    ready.push_back(coroutine);
+}
+
+/**
+ * @brief marks the coroutine of a task as ready to be started, the task must outlive the run
+ *
+ * @param task - the task
+ */
+inline void StreamScheduler::spawn(const StreamTask& task)
+{
+    schedule(task.handle());
+}
+
+/**
+ * @brief resumes the ready coroutines until none is left, the coroutines waiting for a channel
+ *  whose other side has ended stay suspended
+ */
+inline void StreamScheduler::run()
+{
+    while(!ready.empty())
+    {
+        std::coroutine_handle<> coroutine = ready.front();
+        ready.pop_front();
+        coroutine.resume();
+    }
+}
+
+/**
+ * @brief Construct a new Write Awaiter object
+ *
+ * @param channel - the channel
+ * @param batch - the elements to be written
+ */
+template <class Type>
+BatchChannel<Type>::WriteAwaiter::WriteAwaiter(BatchChannel* channel, std::span<const Type> batch)
+    : channel(channel), batch(batch)
+{
+
+}
+
+/**
+ * @brief checks if the batch fits the limit of the channel, a batch is always accepted by an empty channel
+ *
+ * @return true
+ * @return false
+ */
+template <class Type>
+bool BatchChannel<Type>::WriteAwaiter::await_ready()const
+{
+    return !channel->delivered && (channel->buffered.empty() || channel->buffered.size() + batch.size() <= channel->limit);
+}
+
+/**
+ * @brief suspends the producer until the consumer takes the buffered elements
+ *
+ * @param coroutine - the producer
+ */
+template <class Type>
+void BatchChannel<Type>::WriteAwaiter::await_suspend(std::coroutine_handle<> coroutine)
+{
+    channel->producer = coroutine;
+    channel->wake(channel->consumer);
+}
+
+/**
+ * @brief appends the batch to the channel and wakes the consumer
+ *  - throws std::logic_error if the channel is closed
+ */
+template <class Type>
+void BatchChannel<Type>::WriteAwaiter::await_resume()
+{
+    if(channel->closed)
+        throw std::logic_error("The channel is closed!");
+
+    channel->buffered.append(batch.data(), batch.size());
+    if(channel->buffered.size() > channel->highWater)
+        channel->highWater = channel->buffered.size();
+
+    channel->wake(channel->consumer);
+}
+
+/**
+ * @brief Construct a new Read Awaiter object
+ *
+ * @param channel - the channel
+ */
+template <class Type>
+BatchChannel<Type>::ReadAwaiter::ReadAwaiter(BatchChannel* channel) : channel(channel)
+{
+
+}
+
+/**
+ * @brief checks if there are elements to be taken or the channel is closed
+ *
+ * @return true
+ * @return false
+ */
+template <class Type>
+bool BatchChannel<Type>::ReadAwaiter::await_ready()const
+{
+    return !channel->buffered.empty() || channel->closed;
+}
+
+/**
+ * @brief suspends the consumer until the producer writes or closes the channel
+ *
+ * @param coroutine - the consumer
+ */
+template <class Type>
+void BatchChannel<Type>::ReadAwaiter::await_suspend(std::coroutine_handle<> coroutine)
+{
+    channel->consumer = coroutine;
+    channel->wake(channel->producer);
+}
+
+/**
+ * @brief returns all buffered elements, an empty span means that the channel is closed and drained
+ *
+ * @return std::span<const Type>
+ */
+template <class Type>
+std::span<const Type> BatchChannel<Type>::ReadAwaiter::await_resume()
+{
+    channel->delivered = !channel->buffered.empty();
+    return std::span<const Type>(channel->buffered.data(), channel->buffered.size());
+}
+
+/**
+ * @brief Construct a new Batch Channel object
+ *
+ * @param scheduler - scheduler of the producer and the consumer
+ * @param limit - number of the elements after which the producer waits
+ */
+template <class Type>
+BatchChannel<Type>::BatchChannel(StreamScheduler& scheduler, size_t limit)
+    : scheduler(&scheduler), buffered(limit), limit(limit), highWater(0), delivered(false), closed(false)
+{
+
+}
+
+/**
+ * @brief schedules a waiting coroutine
+ *
+ * @param waiting - the coroutine, it is reset
+ */
+template <class Type>
+void BatchChannel<Type>::wake(std::coroutine_handle<>& waiting)
+{
+    if(waiting)
+        scheduler->schedule(std::exchange(waiting, nullptr));
+}
+
+/**
+ * @brief returns an awaitable that appends a batch of elements to the channel, suspending the producer
+ *  while the channel is full
+ *
+ * @param batch - the elements, they are copied
+ * @return WriteAwaiter
+ */
+template <class Type>
+typename BatchChannel<Type>::WriteAwaiter BatchChannel<Type>::write(std::span<const Type> batch)
+{
+    return WriteAwaiter(this, batch);
+}
+
+/**
+ * @brief returns an awaitable of the next elements of the channel, the elements of the previous read
+ *  are released and a waiting producer is woken
+ *
+ * @return ReadAwaiter
+ */
+template <class Type>
+typename BatchChannel<Type>::ReadAwaiter BatchChannel<Type>::read()
+{
+    if(delivered)
+    {
+        buffered.clear();
+        delivered = false;
+        wake(producer);
+    }
+    return ReadAwaiter(this);
+}
+
+/**
+ * @brief marks the end of the stream, the consumer gets the buffered elements and then an empty span
+ */
+template <class Type>
+void BatchChannel<Type>::close()
+{
+    closed = true;
+    wake(consumer);
+}
+
+/**
+ * @brief returns the largest number of elements the channel has held at once
+ *
+ * @return size_t
+ */
+template <class Type>
+size_t BatchChannel<Type>::high_water()const
+{
+    return highWater;
+}
+
+/**
+ * @brief returns a generator of consecutive chunks of a slice, the last one may be shorter
+ *  - the slice must stay valid while the chunks are used
+ *
+ * @param slice - the slice
+ * @param size - number of the elements of a chunk
+ * @return Generator<std::span<const Type>>
+ */
+template <class Type>
+Generator<std::span<const typename std::remove_const<Type>::type>> stream_chunks(DynamicArraySlice<Type> slice, size_t size)
+{
+    for(DynamicArraySlice<Type> chunk : slice.chunks(size))
+    {
+        co_yield chunk.span();
+    }
+}
+
+/**
+ * @brief returns a generator of consecutive chunks of an array, the last one may be shorter
+ *  - the array must not change while the chunks are used
+ *
+ * @param array - the array
+ * @param size - number of the elements of a chunk
+ * @return Generator<std::span<const Type>>
+ */
+template <class Type>
+Generator<std::span<const Type>> stream_chunks(const DynamicArray<Type>& array, size_t size)
+{
+    return stream_chunks(array.slice(), size);
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef _BENCHMARK_
+#define _BENCHMARK_
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief measures the best time of several runs of a function
+ * 
+ * @param function - the measured function
+ * @param runs - number of the runs
+ * @return double - time of the fastest run in seconds
+ */
+template <class Function>
+double measure(Function function, size_t runs = 5)
+{
+    double best = 0;
+    for(size_t i = 0; i < runs; ++i)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if(i == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+/**
+ * @brief prints the time per operation and the throughput of a measurement
+ * 
+ * @param name - name of the measurement
+ * @param operations - number of the operations done in one run
+ * @param seconds - time of one run
+ */
+inline void report(const char* name, size_t operations, double seconds)
+{
+    std::printf("%-40s %12zu ops %10.2f ns/op %10.2f Mops/s\n",
+                name, operations, seconds * 1e9 / operations, operations / seconds / 1e6);
+}
+
+/**
+ * @brief reads a size from the command line or returns a default one
+ * 
+ * @param argc - number of the arguments
+ * @param argv - the arguments
+ * @param index - index of the argument
+ * @param value - the default size
+ * @return size_t 
+ */
+inline size_t argument(int argc, char** argv, int index, size_t value)
+{
+    return index < argc ? std::strtoull(argv[index], nullptr, 10) : value;
+}
+
+/**
+ * @brief keeps the compiler from optimizing away a computed value
+ * 
+ * @param value - the value
+ */
+template <class Type>
+void doNotOptimize(const Type& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "Benchmark.hpp"
+#include "../DynamicArray.hpp"
+
+/**
+ * @brief builds and destroys short-lived arrays like a request handler does
+ * 
+ * @param requests - number of the requests
+ * @param elements - number of the elements pushed into every array
+ * @param allocator - allocator of the arrays
+ * @param afterRequest - called after every request
+ */
+template <class Allocator, class AfterRequest>
+void handleRequests(size_t requests, size_t elements, const Allocator& allocator, AfterRequest afterRequest)
+{
+    for(size_t request = 0; request < requests; ++request)
+    {
+        {
+            DynamicArray<int, Allocator> ids(allocator);
+            DynamicArray<double, Allocator> scores(allocator);
+
+            for(size_t i = 0; i < elements; ++i)
+            {
+                ids.push_back(int(i));
+                scores.push_back(i * 0.5);
+            }
+            doNotOptimize(ids.back() + scores.back());
+        }
+        afterRequest();
+    }
+}
+
+/**
+ * Measures the cost of allocating push_back-heavy short-lived arrays with every allocator.
+ * 
+ * usage: bench_Allocator [requests] [elements per array]
+ */
+int main(int argc, char** argv)
+{
+    size_t requests = argument(argc, argv, 1, 100000);
+    size_t elements = argument(argc, argv, 2, 16);
+
+    size_t pushes = requests * elements * 2;
+    auto nothing = []() {};
+
+    report("HeapAllocator", pushes, measure([&]()
+    {
+        handleRequests(requests, elements, HeapAllocator(), nothing);
+    }));
+
+    MonotonicArena arena;
+    report("ArenaAllocator with reset", pushes, measure([&]()
+    {
+        handleRequests(requests, elements, ArenaAllocator(arena), [&]() { arena.reset(); });
+    }));
+
+    SizeClassPool pool;
+    report("PoolAllocator", pushes, measure([&]()
+    {
+        handleRequests(requests, elements, PoolAllocator(pool), nothing);
+    }));
+
+    report("ThreadLocalPoolAllocator", pushes, measure([&]()
+    {
+        handleRequests(requests, elements, ThreadLocalPoolAllocator(), nothing);
+    }));
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "Benchmark.hpp"
+#include "../DynamicArray.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Measures appending batches to an array element by element and with the batch functions, like
+ * concatenating parsed records does. The array is cleared between the runs and keeps its capacity,
+ * so only the first run pays for growing it.
+ *
+ * usage: bench_Append [elements] [elements per batch]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, size_t(1) << 24);
+    size_t batch = argument(argc, argv, 2, 256);
+
+    DynamicArray<uint32_t> source(batch);
+    for(size_t i = 0; i < batch; ++i)
+    {
+        source.push_back(uint32_t(i));
+    }
+    size_t batches = size / batch;
+
+    DynamicArray<uint32_t> out;
+
+    report("push_back of every element", batches * batch, measure([&]()
+    {
+        out.clear();
+        for(size_t b = 0; b < batches; ++b)
+        {
+            for(size_t i = 0; i < batch; ++i)
+            {
+                out.push_back(source[i]);
+            }
+        }
+        doNotOptimize(out.back());
+    }));
+
+    report("append", batches * batch, measure([&]()
+    {
+        out.clear();
+        for(size_t b = 0; b < batches; ++b)
+        {
+            out.append(source.data(), batch);
+        }
+        doNotOptimize(out.back());
+    }));
+
+    report("append_uninitialized and memcpy", batches * batch, measure([&]()
+    {
+        out.clear();
+        for(size_t b = 0; b < batches; ++b)
+        {
+            std::memcpy(out.append_uninitialized(batch).data(), source.data(), batch * sizeof(uint32_t));
+        }
+        doNotOptimize(out.back());
+    }));
+
+    report("append_n", batches * batch, measure([&]()
+    {
+        out.clear();
+        for(size_t b = 0; b < batches; ++b)
+        {
+            out.append_n(batch, uint32_t(b));
+        }
+        doNotOptimize(out.back());
+    }));
+
+    report("resize", size, measure([&]()
+    {
+        out.clear();
+        out.resize(out.capacity(), 1);
+        doNotOptimize(out.back());
+    }));
+
+    return 0;
+}
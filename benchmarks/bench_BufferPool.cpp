@@ -0,0 +1,73 @@
+#include "Benchmark.hpp"
+#include "../Allocator.hpp"
+#include "../DynamicArray.hpp"
+
+/**
+ * @brief empties and refills an array like a steady-state processing loop does
+ * 
+ * @param rounds - number of the rounds
+ * @param elements - number of the elements pushed in every round
+ * @param allocator - allocator of the array
+ * @param keepCapacity - whether the array is emptied by clear() instead of release()
+ */
+template <class Allocator>
+void refill(size_t rounds, size_t elements, const Allocator& allocator, bool keepCapacity = false)
+{
+    DynamicArray<double, Allocator> values(allocator);
+
+    for(size_t round = 0; round < rounds; ++round)
+    {
+        for(size_t i = 0; i < elements; ++i)
+        {
+            values.push_back(i * 0.5);
+        }
+        doNotOptimize(values.back());
+        if(keepCapacity)
+            values.clear();
+        else
+            values.release();
+    }
+}
+
+/**
+ * Measures releasing and refilling an array with and without a size class pool,
+ * compared to clearing it without releasing its storage.
+ * 
+ * usage: bench_BufferPool [rounds] [elements per round]
+ */
+int main(int argc, char** argv)
+{
+    size_t rounds = argument(argc, argv, 1, 200);
+    size_t elements = argument(argc, argv, 2, 100000);
+
+    size_t pushes = rounds * elements;
+
+    report("HeapAllocator", pushes, measure([&]()
+    {
+        refill(rounds, elements, HeapAllocator());
+    }));
+
+    SizeClassPool pool;
+    report("PoolAllocator", pushes, measure([&]()
+    {
+        refill(rounds, elements, PoolAllocator(pool));
+    }));
+    std::printf("hit rate: %.3f\n", pool.statistics().hit_rate());
+
+    report("GlobalPoolAllocator", pushes, measure([&]()
+    {
+        refill(rounds, elements, GlobalPoolAllocator());
+    }));
+
+    report("ThreadLocalPoolAllocator", pushes, measure([&]()
+    {
+        refill(rounds, elements, ThreadLocalPoolAllocator());
+    }));
+
+    report("HeapAllocator with clear", pushes, measure([&]()
+    {
+        refill(rounds, elements, HeapAllocator(), true);
+    }));
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "Benchmark.hpp"
+#include "../CompressedDynamicArray.hpp"
+
+#include <random>
+
+/**
+ * Compares the memory and the scan speed of sorted IDs stored in a DynamicArray<uint32_t>
+ * and in a CompressedDynamicArray.
+ * 
+ * usage: bench_CompressedDynamicArray [size] [largest gap]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, 1 << 26);
+    size_t gap = argument(argc, argv, 2, 16);
+
+    std::mt19937 generator(1);
+
+    DynamicArray<uint32_t> raw(size);
+    uint32_t current = 0;
+    for(size_t i = 0; i < size; ++i)
+    {
+        current += generator() % gap;
+        raw.push_back(current);
+    }
+
+    CompressedDynamicArray compressed;
+    report("CompressedDynamicArray push_back", size, measure([&]()
+    {
+        compressed = CompressedDynamicArray(raw);
+    }, 1));
+
+    std::printf("raw bytes %zu, compressed bytes %zu, ratio %.2f\n",
+                raw.size() * sizeof(uint32_t), compressed.compressed_bytes(),
+                double(raw.size() * sizeof(uint32_t)) / compressed.compressed_bytes());
+
+    report("DynamicArray scan", size, measure([&]()
+    {
+        uint64_t sum = 0;
+        for(uint32_t value : raw)
+        {
+            sum += value;
+        }
+        doNotOptimize(sum);
+    }));
+
+    report("CompressedDynamicArray block scan", size, measure([&]()
+    {
+        uint32_t values[CompressedDynamicArray::BLOCK_SIZE];
+        uint64_t sum = 0;
+        for(size_t block = 0; block < compressed.block_count(); ++block)
+        {
+            compressed.decode_block(block, values);
+            for(size_t i = 0; i < CompressedDynamicArray::BLOCK_SIZE; ++i)
+            {
+                sum += values[i];
+            }
+        }
+        doNotOptimize(sum);
+    }));
+
+    DynamicArray<uint32_t> decoded(size);
+    report("CompressedDynamicArray decode", size, measure([&]()
+    {
+        decoded = DynamicArray<uint32_t>(size);
+        compressed.decode(decoded);
+        doNotOptimize(decoded.size());
+    }));
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "Benchmark.hpp"
+#include "../ConcurrentQueue.hpp"
+#include "../DynamicArray.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief a bounded queue guarded by a mutex, the usual replacement of SpscQueue
+ */
+class MutexQueue
+{
+private:
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<uint64_t> values;
+    size_t limit;
+
+public:
+    explicit MutexQueue(size_t limit) : limit(limit)
+    {
+
+    }
+
+    void push_n(std::span<const uint64_t> batch)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for(uint64_t value : batch)
+        {
+            notFull.wait(lock, [&]() { return values.size() < limit; });
+            values.push_back(value);
+            notEmpty.notify_one();
+        }
+    }
+
+    size_t pop_n(std::span<uint64_t> out)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&]() { return !values.empty(); });
+
+        size_t count = std::min(out.size(), values.size());
+        std::copy(values.begin(), values.begin() + count, out.data());
+        values.erase(values.begin(), values.begin() + count);
+        notFull.notify_one();
+        return count;
+    }
+};
+
+/**
+ * @brief nanoseconds on the steady clock, passed through the queues as the elements
+ */
+uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief passes timestamps from a producer thread to the calling thread in batches and records
+ *  how long every element stayed in the queue
+ *
+ * @param queue - the queue
+ * @param count - number of the elements
+ * @param batch - number of the elements pushed and popped at once
+ * @param latencies - the latencies in nanoseconds
+ */
+template <class Queue>
+void transfer(Queue& queue, size_t count, size_t batch, DynamicArray<uint64_t>& latencies)
+{
+    latencies.clear();
+    std::thread producer([&]()
+    {
+        DynamicArray<uint64_t> stamps;
+        for(size_t sent = 0; sent < count; sent += batch)
+        {
+            size_t size = std::min(batch, count - sent);
+            stamps.clear();
+            uint64_t stamp = now();
+            stamps.append_n(size, stamp);
+            queue.push_n(std::span<const uint64_t>(stamps.data(), size));
+        }
+    });
+
+    DynamicArray<uint64_t> received(batch);
+    received.resize_default_init(batch);
+    while(latencies.size() < count)
+    {
+        size_t popped = queue.pop_n(std::span<uint64_t>(received.data(), batch));
+        uint64_t stamp = now();
+        for(size_t i = 0; i < popped; ++i)
+        {
+            latencies.push_back(stamp - received[i]);
+        }
+    }
+    producer.join();
+}
+
+/**
+ * @brief runs a transfer and prints its throughput and 99th percentile latency
+ */
+template <class Queue>
+void measureQueue(const char* name, size_t count, size_t capacity, size_t batch)
+{
+    DynamicArray<uint64_t> latencies(count);
+    report(name, count, measure([&]()
+    {
+        Queue queue(capacity);
+        transfer(queue, count, batch, latencies);
+    }, 3));
+
+    uint64_t* p99 = latencies.data() + latencies.size() * 99 / 100;
+    std::nth_element(latencies.data(), p99, latencies.data() + latencies.size());
+    std::printf("  p99 latency %.1f us\n", *p99 / 1e3);
+}
+
+/**
+ * Measures passing elements from one thread to another - through a mutex-guarded deque and through SpscQueue
+ * with every wait strategy. Reports the throughput and the 99th percentile of the time an element spends
+ * between its push and its pop. Spinning only pays off when both threads have their own core.
+ *
+ * usage: bench_ConcurrentQueue [elements] [queue capacity] [elements per batch]
+ */
+int main(int argc, char** argv)
+{
+    size_t count = argument(argc, argv, 1, size_t(1) << 22);
+    size_t capacity = argument(argc, argv, 2, 4096);
+    size_t batch = argument(argc, argv, 3, 1);
+
+    measureQueue<MutexQueue>("mutex queue", count, capacity, batch);
+    measureQueue<SpscQueue<uint64_t, SpinWait>>("spsc queue, spin", count, capacity, batch);
+    measureQueue<SpscQueue<uint64_t, YieldWait>>("spsc queue, yield", count, capacity, batch);
+    measureQueue<SpscQueue<uint64_t, FutexWait>>("spsc queue, futex", count, capacity, batch);
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "Benchmark.hpp"
+#include "../Expression.hpp"
+#include "../Sort.hpp"
+
+#include <cstdint>
+
+/**
+ * @brief sums the elements of an array
+ */
+uint64_t total(const DynamicArray<uint64_t>& array)
+{
+    return sum(array);
+}
+
+/**
+ * @brief sums the elements of a slice
+ */
+uint64_t total(DynamicArraySlice<const uint64_t> slice)
+{
+    return sum(slice);
+}
+
+/**
+ * Measures processing an array chunk by chunk - summing and sorting every chunk - when every chunk is copied
+ * into an array of its own and when the chunks are slices of the array.
+ *
+ * usage: bench_DynamicArraySlice [elements] [chunk]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, size_t(1) << 24);
+    size_t chunk = argument(argc, argv, 2, 4096);
+
+    DynamicArray<uint64_t> array;
+    uint64_t state = 1;
+    for(size_t i = 0; i < size; ++i)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        array.push_back(state >> 40);
+    }
+    DynamicArray<uint64_t> original = array;
+
+    report("sum, copied chunks", size, measure([&]()
+    {
+        uint64_t result = 0;
+        for(size_t first = 0; first < size; first += chunk)
+        {
+            DynamicArray<uint64_t> part;
+            part.append(array.data() + first, first + chunk < size ? chunk : size - first);
+            result += total(part);
+        }
+        doNotOptimize(result);
+    }));
+
+    report("sum, slices", size, measure([&]()
+    {
+        uint64_t result = 0;
+        for(DynamicArraySlice<uint64_t> part : array.chunks(chunk))
+        {
+            result += total(part);
+        }
+        doNotOptimize(result);
+    }));
+
+    report("sort, copied chunks", size, measure([&]()
+    {
+        array = original;
+        for(size_t first = 0; first < size; first += chunk)
+        {
+            size_t length = first + chunk < size ? chunk : size - first;
+            DynamicArray<uint64_t> part;
+            part.append(array.data() + first, length);
+            sort(part);
+            std::copy(part.begin(), part.end(), array.data() + first);
+        }
+        doNotOptimize(array.data());
+    }));
+
+    report("sort, slices", size, measure([&]()
+    {
+        array = original;
+        for(DynamicArraySlice<uint64_t> part : array.chunks(chunk))
+        {
+            sort(part);
+        }
+        doNotOptimize(array.data());
+    }));
+
+    return 0;
+}
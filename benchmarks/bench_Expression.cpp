@@ -0,0 +1,100 @@
+#include "Benchmark.hpp"
+#include "../Expression.hpp"
+
+/**
+ * @brief computes a * x + b - c with a temporary array per operation, like the usual element-wise functions
+ */
+void withTemporaries(const DynamicArray<double>& a, const DynamicArray<double>& x, double b, const DynamicArray<double>& c,
+                     DynamicArray<double>& y)
+{
+    size_t size = a.size();
+    DynamicArray<double> product(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        product.push_back(a[i] * x[i]);
+    }
+
+    DynamicArray<double> shifted(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        shifted.push_back(product[i] + b);
+    }
+
+    y.clear();
+    for(size_t i = 0; i < size; ++i)
+    {
+        y.push_back(shifted[i] - c[i]);
+    }
+}
+
+/**
+ * Measures computing y = a * x + b - c and the dot product of a and x - by hand-written loops, with a temporary
+ * array per operation and with expressions evaluated by one and by all threads.
+ *
+ * usage: bench_Expression [elements] [threads]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, size_t(1) << 24);
+    size_t threads = argument(argc, argv, 2, parallelThreads());
+
+    DynamicArray<double> a;
+    DynamicArray<double> x;
+    DynamicArray<double> c;
+    for(size_t i = 0; i < size; ++i)
+    {
+        a.push_back(double(i % 100) / 100);
+        x.push_back(double(i % 37));
+        c.push_back(double(i % 11));
+    }
+    double b = 2.5;
+    DynamicArray<double> y;
+    y.resize_default_init(size);
+
+    report("hand loop", size, measure([&]()
+    {
+        double* out = y.data();
+        for(size_t i = 0; i < size; ++i)
+        {
+            out[i] = a[i] * x[i] + b - c[i];
+        }
+        doNotOptimize(out);
+    }));
+
+    report("temporary per operation", size, measure([&]()
+    {
+        withTemporaries(a, x, b, c, y);
+        doNotOptimize(y.data());
+    }));
+
+    report("expression", size, measure([&]()
+    {
+        assign(y, a * x + b - c);
+        doNotOptimize(y.data());
+    }));
+
+    report("expression, parallel", size, measure([&]()
+    {
+        parallel_assign(y, a * x + b - c, threads);
+        doNotOptimize(y.data());
+    }));
+
+    double dot = 0;
+    report("dot product, hand loop", size, measure([&]()
+    {
+        dot = 0;
+        for(size_t i = 0; i < size; ++i)
+        {
+            dot += a[i] * x[i];
+        }
+        doNotOptimize(dot);
+    }));
+
+    report("dot product, sum(a * x)", size, measure([&]()
+    {
+        dot = sum(a * x);
+        doNotOptimize(dot);
+    }));
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "Benchmark.hpp"
+#include "../EytzingerIndex.hpp"
+#include "../FlatSet.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+/**
+ * Compares the lookup throughput of binary search over a sorted DynamicArray<uint64_t>
+ * with single and batched searches in an EytzingerIndex.
+ * 
+ * usage: bench_EytzingerIndex [size] [lookups]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, size_t(1) << 24);
+    size_t lookups = argument(argc, argv, 2, 1000000);
+
+    std::mt19937_64 generator(1);
+
+    DynamicArray<uint64_t> sorted(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        sorted.push_back(generator());
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    DynamicArray<uint64_t> keys(lookups);
+    for(size_t i = 0; i < lookups; ++i)
+    {
+        keys.push_back(generator());
+    }
+
+    std::printf("size %zu\n", size);
+
+    report("EytzingerIndex build", size, measure([&]()
+    {
+        EytzingerIndex<uint64_t> index(sorted);
+        doNotOptimize(index.size());
+    }, 1));
+
+    EytzingerIndex<uint64_t> index(sorted);
+
+    report("std::lower_bound", lookups, measure([&]()
+    {
+        size_t sum = 0;
+        for(size_t i = 0; i < lookups; ++i)
+        {
+            sum += std::lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin();
+        }
+        doNotOptimize(sum);
+    }));
+
+    report("branchless binary search", lookups, measure([&]()
+    {
+        size_t sum = 0;
+        for(size_t i = 0; i < lookups; ++i)
+        {
+            sum += branchlessLowerBound(sorted.data(), size, keys[i], std::less<uint64_t>()) - sorted.data();
+        }
+        doNotOptimize(sum);
+    }));
+
+    report("EytzingerIndex lower_bound", lookups, measure([&]()
+    {
+        size_t sum = 0;
+        for(size_t i = 0; i < lookups; ++i)
+        {
+            sum += index.lower_bound(keys[i]);
+        }
+        doNotOptimize(sum);
+    }));
+
+    DynamicArray<size_t> results(lookups);
+    report("EytzingerIndex batched lower_bound", lookups, measure([&]()
+    {
+        index.lower_bound(keys.data(), lookups, results.data());
+        doNotOptimize(results.data()[lookups - 1]);
+    }));
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "Benchmark.hpp"
+#include "../FileLoader.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief a decode step that touches every element, like checking or converting the loaded values
+ *
+ * @param values - the elements
+ * @return uint64_t - checksum of the elements
+ */
+uint64_t checksum(std::span<const uint64_t> values)
+{
+    uint64_t sum = 0;
+    for(uint64_t value : values)
+    {
+        sum = (sum ^ value) * 0x100000001B3;
+    }
+    return sum;
+}
+
+/**
+ * Measures loading several files at startup - one blocking read at a time and with FileLoader,
+ * with and without a decode step. The files are usually in the page cache after the first run.
+ *
+ * usage: bench_FileLoader [files] [megabytes per file] [threads]
+ */
+int main(int argc, char** argv)
+{
+    size_t files = argument(argc, argv, 1, 8);
+    size_t megabytes = argument(argc, argv, 2, 64);
+    size_t threads = argument(argc, argv, 3, 4);
+
+    size_t count = (megabytes << 20) / sizeof(uint64_t);
+    std::vector<std::string> paths;
+    for(size_t file = 0; file < files; ++file)
+    {
+        paths.push_back((std::filesystem::temp_directory_path() / ("bench_FileLoader_" + std::to_string(file))).string());
+
+        DynamicArray<uint64_t> values;
+        for(size_t i = 0; i < count; ++i)
+        {
+            values.push_back(i * file);
+        }
+        std::FILE* stream = std::fopen(paths.back().c_str(), "wb");
+        std::fwrite(values.data(), sizeof(uint64_t), count, stream);
+        std::fclose(stream);
+    }
+
+    size_t total = files * count;
+    std::printf("%s\n", FileLoader::uses_io_uring() ? "io_uring" : "pread on a thread pool");
+
+    for(bool decode : {false, true})
+    {
+        std::printf("%s\n", decode ? "with a decode step" : "without decoding");
+
+        report("  blocking reads", total, measure([&]()
+        {
+            uint64_t sum = 0;
+            for(const std::string& path : paths)
+            {
+                DynamicArray<uint64_t> array;
+                array.resize_default_init(count);
+
+                std::FILE* stream = std::fopen(path.c_str(), "rb");
+                doNotOptimize(std::fread(array.data(), sizeof(uint64_t), count, stream));
+                std::fclose(stream);
+
+                if(decode)
+                    sum += checksum(std::span<const uint64_t>(array.data(), array.size()));
+            }
+            doNotOptimize(sum);
+        }, 3));
+
+        report("  FileLoader", total, measure([&]()
+        {
+            FileLoader loader(threads);
+            std::vector<DynamicArray<uint64_t>> arrays(files);
+            std::vector<std::future<size_t>> loads;
+            std::atomic<uint64_t> sum(0);
+
+            for(size_t file = 0; file < files; ++file)
+            {
+                loads.push_back(loader.load(paths[file], arrays[file], [&](std::span<uint64_t> chunk, size_t)
+                {
+                    if(decode)
+                        sum += checksum(chunk);
+                }));
+            }
+            for(std::future<size_t>& load : loads)
+            {
+                doNotOptimize(load.get());
+            }
+            doNotOptimize(sum.load());
+        }, 3));
+    }
+
+    for(const std::string& path : paths)
+    {
+        std::remove(path.c_str());
+    }
+
+    return 0;
+}
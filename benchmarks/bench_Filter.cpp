@@ -0,0 +1,101 @@
+#include "Benchmark.hpp"
+#include "../Filter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief a value that isn't compacted by the SIMD instructions
+ */
+struct Pair
+{
+    uint32_t key;
+    uint32_t value;
+};
+
+/**
+ * @brief measures erasing the elements of an array below a threshold with every method
+ *
+ * @param name - name of the array
+ * @param array - the array
+ * @param threshold - elements below it are erased, it sets the share of the erased elements
+ * @param key - returns the compared value of an element
+ */
+template <class Type, class Key>
+void erase(const char* name, const DynamicArray<Type>& array, uint32_t threshold, Key key)
+{
+    std::printf("%s\n", name);
+    size_t size = array.size();
+    auto below = [threshold, key](const Type& value) { return key(value) < threshold; };
+
+    report("  copy only", size, measure([&]()
+    {
+        DynamicArray<Type> copy = array;
+        doNotOptimize(copy.size());
+    }));
+
+    report("  std::remove_if and pop_back", size, measure([&]()
+    {
+        DynamicArray<Type> copy = array;
+        Type* end = std::remove_if(copy.data(), copy.data() + copy.size(), below);
+        size_t kept = size_t(end - copy.data());
+        while(copy.size() > kept)
+        {
+            copy.pop_back();
+        }
+        doNotOptimize(copy.size());
+    }));
+
+    report("  erase_if", size, measure([&]()
+    {
+        DynamicArray<Type> copy = array;
+        erase_if(copy, below);
+        doNotOptimize(copy.size());
+    }));
+
+    report("  parallel_erase_if", size, measure([&]()
+    {
+        DynamicArray<Type> copy = array;
+        parallel_erase_if(copy, below);
+        doNotOptimize(copy.size());
+    }));
+
+    report("  filter_into", size, measure([&]()
+    {
+        DynamicArray<Type> out;
+        filter_into(array, out, [&below](const Type& value) { return !below(value); });
+        doNotOptimize(out.size());
+    }));
+}
+
+/**
+ * Measures stream compaction - erasing the elements that match a predicate. The copy of the array
+ * made by every run is included in the times.
+ *
+ * usage: bench_Filter [elements] [percent of the erased elements]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, size_t(1) << 24);
+    uint32_t threshold = uint32_t(argument(argc, argv, 2, 50)) * 10;
+
+    std::mt19937_64 generator(1);
+
+    DynamicArray<uint32_t> ids(size);
+    DynamicArray<double> prices(size);
+    DynamicArray<Pair> pairs(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        uint32_t value = uint32_t(generator() % 1000);
+        ids.push_back(value);
+        prices.push_back(value);
+        pairs.push_back(Pair{value, uint32_t(i)});
+    }
+
+    erase("uint32_t column", ids, threshold, [](uint32_t value) { return value; });
+    erase("double column", prices, threshold, [](double value) { return uint32_t(value); });
+    erase("8 bytes pairs", pairs, threshold, [](const Pair& pair) { return pair.key; });
+
+    return 0;
+}
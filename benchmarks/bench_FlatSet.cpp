@@ -0,0 +1,137 @@
+#include "Benchmark.hpp"
+#include "../FlatMap.hpp"
+#include "../FlatSet.hpp"
+
+#include <map>
+#include <random>
+#include <set>
+
+/**
+ * Compares lookups and iteration of FlatSet and FlatMap with std::set and std::map.
+ * 
+ * usage: bench_FlatSet [largest size] [lookups]
+ */
+int main(int argc, char** argv)
+{
+    size_t largest = argument(argc, argv, 1, 1000000);
+    size_t lookups = argument(argc, argv, 2, 1000000);
+
+    std::mt19937_64 generator(1);
+
+    for(size_t size = 100; size <= largest; size *= 10)
+    {
+        DynamicArray<unsigned> keys(size);
+        DynamicArray<std::pair<unsigned, unsigned>> pairs(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            unsigned key = generator();
+            keys.push_back(key);
+            pairs.push_back(std::make_pair(key, unsigned(i)));
+        }
+
+        DynamicArray<unsigned> queries(lookups);
+        for(size_t i = 0; i < lookups; ++i)
+        {
+            queries.push_back(keys[generator() % size]);
+        }
+
+        FlatSet<unsigned> flatSet;
+        std::set<unsigned> treeSet;
+        FlatMap<unsigned, unsigned> flatMap;
+        std::map<unsigned, unsigned> treeMap;
+
+        std::printf("size %zu\n", size);
+
+        report("FlatSet bulk insert", size, measure([&]()
+        {
+            flatSet = FlatSet<unsigned>();
+            flatSet.insert(keys);
+        }, 1));
+        report("std::set insert", size, measure([&]()
+        {
+            treeSet.clear();
+            treeSet.insert(keys.begin(), keys.end());
+        }, 1));
+
+        report("FlatSet lookup", lookups, measure([&]()
+        {
+            size_t found = 0;
+            for(size_t i = 0; i < lookups; ++i)
+            {
+                found += flatSet.contains(queries[i]);
+            }
+            doNotOptimize(found);
+        }));
+        report("std::set lookup", lookups, measure([&]()
+        {
+            size_t found = 0;
+            for(size_t i = 0; i < lookups; ++i)
+            {
+                found += treeSet.count(queries[i]);
+            }
+            doNotOptimize(found);
+        }));
+
+        report("FlatSet iteration", flatSet.size(), measure([&]()
+        {
+            unsigned sum = 0;
+            for(unsigned key : flatSet)
+            {
+                sum += key;
+            }
+            doNotOptimize(sum);
+        }));
+        report("std::set iteration", treeSet.size(), measure([&]()
+        {
+            unsigned sum = 0;
+            for(unsigned key : treeSet)
+            {
+                sum += key;
+            }
+            doNotOptimize(sum);
+        }));
+
+        flatMap.insert(pairs);
+        treeMap.insert(pairs.begin(), pairs.end());
+
+        report("FlatMap lookup", lookups, measure([&]()
+        {
+            unsigned sum = 0;
+            for(size_t i = 0; i < lookups; ++i)
+            {
+                sum += flatMap.at(queries[i]);
+            }
+            doNotOptimize(sum);
+        }));
+        report("std::map lookup", lookups, measure([&]()
+        {
+            unsigned sum = 0;
+            for(size_t i = 0; i < lookups; ++i)
+            {
+                sum += treeMap.at(queries[i]);
+            }
+            doNotOptimize(sum);
+        }));
+
+        report("FlatMap iteration", flatMap.size(), measure([&]()
+        {
+            unsigned sum = 0;
+            for(const std::pair<unsigned, unsigned>& pair : flatMap)
+            {
+                sum += pair.second;
+            }
+            doNotOptimize(sum);
+        }));
+        report("std::map iteration", treeMap.size(), measure([&]()
+        {
+            unsigned sum = 0;
+            for(const std::pair<const unsigned, unsigned>& pair : treeMap)
+            {
+                sum += pair.second;
+            }
+            doNotOptimize(sum);
+        }));
+    }
+
+    return 0;
+}
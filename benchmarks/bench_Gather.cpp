@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+#include "../Gather.hpp"
+
+#include <cstdint>
+#include <random>
+
+/**
+ * @brief a row of a table that isn't copied by the gather instructions
+ */
+struct Row
+{
+    uint64_t key;
+    uint64_t payload;
+};
+
+/**
+ * @brief measures fetching the rows of a table matched by a join with every method
+ * 
+ * @param name - name of the table
+ * @param table - the table
+ * @param matches - indices of the matched rows
+ */
+template <class Type>
+void fetch(const char* name, const DynamicArray<Type>& table, const DynamicArray<uint32_t>& matches)
+{
+    std::printf("%s\n", name);
+    size_t count = matches.size();
+
+    report("  loop", count, measure([&]()
+    {
+        DynamicArray<Type> out(count);
+        for(size_t i = 0; i < count; ++i)
+        {
+            out.push_back(table[matches[i]]);
+        }
+        doNotOptimize(out.back());
+    }));
+
+    report("  gather without prefetching", count, measure([&]()
+    {
+        DynamicArray<Type> out;
+        gather(table, matches, out, 0);
+        doNotOptimize(out.back());
+    }));
+
+    report("  gather", count, measure([&]()
+    {
+        DynamicArray<Type> out;
+        gather(table, matches, out);
+        doNotOptimize(out.back());
+    }));
+}
+
+/**
+ * Measures index-chasing workloads - fetching and aggregating the rows of a large table at random
+ * indices, like the probe side of a hash join does.
+ * 
+ * usage: bench_Gather [table rows] [matches]
+ */
+int main(int argc, char** argv)
+{
+    size_t rows = argument(argc, argv, 1, size_t(1) << 23);
+    size_t count = argument(argc, argv, 2, size_t(1) << 22);
+
+    std::mt19937_64 generator(1);
+
+    DynamicArray<uint32_t> matches(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+        matches.push_back(uint32_t(generator() % rows));
+    }
+
+    DynamicArray<uint32_t> keys(rows);
+    DynamicArray<double> prices(rows);
+    DynamicArray<Row> records(rows);
+    for(size_t i = 0; i < rows; ++i)
+    {
+        keys.push_back(uint32_t(i));
+        prices.push_back(i * 0.25);
+        records.push_back(Row{i, i * 3});
+    }
+
+    fetch("uint32_t column", keys, matches);
+    fetch("double column", prices, matches);
+    fetch("16 bytes rows", records, matches);
+
+    std::printf("sum of a double column\n");
+
+    report("  loop", count, measure([&]()
+    {
+        double sum = 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            sum += prices[matches[i]];
+        }
+        doNotOptimize(sum);
+    }));
+
+    for(size_t distance : {size_t(0), size_t(8), size_t(16), size_t(32)})
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "  indexed_for_each, distance %zu", distance);
+
+        report(name, count, measure([&]()
+        {
+            double sum = 0;
+            indexed_for_each(prices, matches, [&sum](double price) { sum += price; }, distance);
+            doNotOptimize(sum);
+        }));
+    }
+
+    return 0;
+}
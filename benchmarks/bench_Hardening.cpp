@@ -0,0 +1,58 @@
+#include "Benchmark.hpp"
+#include "../DynamicArray.hpp"
+
+/**
+ * Measures element access through operator[] and iterators against a raw pointer loop
+ * at the hardening level the benchmark is compiled with.
+ * 
+ * usage: bench_Hardening [elements] [runs]
+ * 
+ * e.g. compare builds with -DNDEBUG -DDYNAMIC_ARRAY_HARDENING=0, 1 and 2 - at level 0 all three loops
+ * take the same time.
+ */
+int main(int argc, char** argv)
+{
+    size_t elements = argument(argc, argv, 1, 1 << 20);
+    size_t runs = argument(argc, argv, 2, 200);
+
+    DynamicArray<int> array(elements);
+    for(size_t i = 0; i < elements; ++i)
+    {
+        array.push_back(int(i & 0xFF));
+    }
+
+    std::printf("hardening level %d\n", DYNAMIC_ARRAY_HARDENING);
+
+    report("raw pointer", elements, measure([&]()
+    {
+        long sum = 0;
+        const int* data = array.data();
+        for(size_t i = 0; i < elements; ++i)
+        {
+            sum += data[i];
+        }
+        doNotOptimize(sum);
+    }, runs));
+
+    report("operator[]", elements, measure([&]()
+    {
+        long sum = 0;
+        for(size_t i = 0; i < array.size(); ++i)
+        {
+            sum += array[i];
+        }
+        doNotOptimize(sum);
+    }, runs));
+
+    report("iterators", elements, measure([&]()
+    {
+        long sum = 0;
+        for(int value : array)
+        {
+            sum += value;
+        }
+        doNotOptimize(sum);
+    }, runs));
+
+    return 0;
+}
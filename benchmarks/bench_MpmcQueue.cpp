@@ -0,0 +1,134 @@
+#include "Benchmark.hpp"
+#include "../ConcurrentQueue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief the usual replacement of BatchedAppender - an array guarded by a mutex which the consumer
+ *  copies out and clears
+ */
+class MutexAppender
+{
+private:
+    std::mutex mutex;
+    DynamicArray<uint64_t> values;
+
+public:
+    void push_back(uint64_t value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.push_back(value);
+    }
+
+    size_t drain(DynamicArray<uint64_t>& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t drained = values.size();
+        out.append(values.data(), drained);
+        values.clear();
+        return drained;
+    }
+};
+
+/**
+ * @brief runs producer threads that push their share of the elements while the calling thread drains them
+ *
+ * @param producers - number of the producer threads
+ * @param count - number of all elements
+ * @param produce - function of a producer thread, it gets the number of the elements to push
+ * @param drain - function that appends the pushed elements to an array and returns their number
+ */
+template <class Produce, class Drain>
+void run(size_t producers, size_t count, Produce produce, Drain drain)
+{
+    std::vector<std::thread> threads;
+    for(size_t producer = 0; producer < producers; ++producer)
+    {
+        threads.emplace_back(produce, count / producers + (producer < count % producers ? 1 : 0));
+    }
+
+    DynamicArray<uint64_t> out(count);
+    while(out.size() < count)
+    {
+        if(drain(out) == 0)
+            std::this_thread::yield();
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    doNotOptimize(out.data());
+}
+
+/**
+ * Measures many producer threads handing elements to one consumer for 1, 2, 4... producers - through an array
+ * guarded by a mutex, through MpmcQueue one element at a time and through BatchedAppender, whose producers
+ * contend once per batch.
+ *
+ * usage: bench_MpmcQueue [elements] [most producers] [elements per batch]
+ */
+int main(int argc, char** argv)
+{
+    size_t count = argument(argc, argv, 1, size_t(1) << 23);
+    size_t most = argument(argc, argv, 2, 2 * std::max(1u, std::thread::hardware_concurrency()));
+    size_t batchSize = argument(argc, argv, 3, 1024);
+
+    for(size_t producers = 1; producers <= most; producers *= 2)
+    {
+        std::printf("%zu producers\n", producers);
+
+        report("  mutex-guarded array", count, measure([&]()
+        {
+            MutexAppender appender;
+            run(producers, count, [&](size_t share)
+            {
+                for(uint64_t i = 0; i < share; ++i)
+                {
+                    appender.push_back(i);
+                }
+            }, [&](DynamicArray<uint64_t>& out) { return appender.drain(out); });
+        }, 3));
+
+        report("  mpmc queue, per element", count, measure([&]()
+        {
+            MpmcQueue<uint64_t> queue(65536);
+            run(producers, count, [&](size_t share)
+            {
+                for(uint64_t i = 0; i < share; ++i)
+                {
+                    queue.push(i);
+                }
+            }, [&](DynamicArray<uint64_t>& out)
+            {
+                size_t drained = 0;
+                uint64_t value;
+                while(queue.try_pop(value))
+                {
+                    out.push_back(value);
+                    ++drained;
+                }
+                return drained;
+            });
+        }, 3));
+
+        report("  batched appender", count, measure([&]()
+        {
+            BatchedAppender<uint64_t> appender(batchSize, 2 * producers + 2);
+            run(producers, count, [&](size_t share)
+            {
+                BatchedAppender<uint64_t>::Producer producer(appender);
+                for(uint64_t i = 0; i < share; ++i)
+                {
+                    producer.push_back(i);
+                }
+            }, [&](DynamicArray<uint64_t>& out) { return appender.drain(out); });
+        }, 3));
+    }
+
+    return 0;
+}
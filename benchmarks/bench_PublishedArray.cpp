@@ -0,0 +1,105 @@
+#include "Benchmark.hpp"
+#include "../PublishedArray.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief runs reader threads that each take a number of snapshots, while the calling thread publishes
+ *  a new version every millisecond until they finish
+ *
+ * @param threads - number of the reader threads
+ * @param read - function of a reader thread, it gets the index of the thread
+ * @param write - function that publishes a new version
+ */
+template <class Read, class Write>
+void run(size_t threads, Read read, Write write)
+{
+    std::atomic<size_t> running(threads);
+    std::vector<std::thread> readers;
+    for(size_t i = 0; i < threads; ++i)
+    {
+        readers.emplace_back([&, i]()
+        {
+            read(i);
+            running.fetch_sub(1);
+        });
+    }
+
+    while(running.load() > 0)
+    {
+        write();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for(std::thread& reader : readers)
+    {
+        reader.join();
+    }
+}
+
+/**
+ * Measures the throughput of readers of a small table that is replaced every millisecond, for 1, 2, 4... reader
+ * threads - guarded by a std::shared_mutex and published as a PublishedArray. The readers of the shared mutex
+ * all write its cache line, the readers of PublishedArray only write their own.
+ *
+ * usage: bench_PublishedArray [reads per thread] [most threads] [elements]
+ */
+int main(int argc, char** argv)
+{
+    size_t reads = argument(argc, argv, 1, size_t(1) << 21);
+    size_t most = argument(argc, argv, 2, 2 * std::max(1u, std::thread::hardware_concurrency()));
+    size_t size = argument(argc, argv, 3, 64);
+
+    DynamicArray<uint64_t> table;
+    table.append_n(size, 1);
+
+    for(size_t threads = 1; threads <= most; threads *= 2)
+    {
+        std::printf("%zu readers\n", threads);
+
+        report("  shared mutex", reads * threads, measure([&]()
+        {
+            std::shared_mutex mutex;
+            DynamicArray<uint64_t> guarded = table;
+            run(threads, [&](size_t thread)
+            {
+                uint64_t sum = 0;
+                for(size_t i = 0; i < reads; ++i)
+                {
+                    std::shared_lock<std::shared_mutex> lock(mutex);
+                    sum += guarded[(i + thread) % guarded.size()];
+                }
+                doNotOptimize(sum);
+            }, [&]()
+            {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                guarded = table;
+            });
+        }, 3));
+
+        report("  published array", reads * threads, measure([&]()
+        {
+            PublishedArray<uint64_t> published(table, threads);
+            run(threads, [&](size_t thread)
+            {
+                PublishedArray<uint64_t>::Reader reader(published);
+                uint64_t sum = 0;
+                for(size_t i = 0; i < reads; ++i)
+                {
+                    PublishedArray<uint64_t>::Snapshot snapshot = reader.read();
+                    sum += (*snapshot)[(i + thread) % snapshot->size()];
+                }
+                doNotOptimize(sum);
+            }, [&]()
+            {
+                published.publish(table);
+            });
+        }, 3));
+    }
+
+    return 0;
+}
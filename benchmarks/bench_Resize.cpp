@@ -0,0 +1,84 @@
+#include "Benchmark.hpp"
+#include "../CompressedDynamicArray.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief measures making room for a buffer and overwriting it, like reading a file into it does
+ *
+ * @param name - name of the measurement
+ * @param bytes - size of the buffer
+ * @param buffer - the array, it is cleared before every run
+ * @param makeRoom - sizes the array
+ */
+template <class MakeRoom>
+void overwrite(const char* name, size_t bytes, DynamicArray<uint8_t>& buffer, MakeRoom makeRoom)
+{
+    double seconds = measure([&]()
+    {
+        buffer.clear();
+        makeRoom(buffer);
+        std::memset(buffer.data(), 0x5A, buffer.size());
+        doNotOptimize(buffer.back());
+    }, 3);
+
+    std::printf("%-40s %10.2f GB/s\n", name, bytes / seconds / 1e9);
+}
+
+/**
+ * Measures the bandwidth saved by not writing new elements that are overwritten right away, for fresh
+ * and reused buffers and for decoding. The default buffer has 1 GB, fresh ones are dominated by page faults.
+ *
+ * usage: bench_Resize [megabytes]
+ */
+int main(int argc, char** argv)
+{
+    size_t bytes = argument(argc, argv, 1, 1024) << 20;
+
+    auto resize = [bytes](DynamicArray<uint8_t>& buffer) { buffer.resize(bytes, 0); };
+    auto resizeDefaultInit = [bytes](DynamicArray<uint8_t>& buffer) { buffer.resize_default_init(bytes); };
+
+    {
+        DynamicArray<uint8_t> fresh;
+        overwrite("resize and overwrite", bytes, fresh, [&](DynamicArray<uint8_t>& buffer) { buffer.release(); resize(buffer); });
+        overwrite("resize_default_init and overwrite", bytes, fresh, [&](DynamicArray<uint8_t>& buffer) { buffer.release(); resizeDefaultInit(buffer); });
+    }
+    {
+        DynamicArray<uint8_t> reused;
+        overwrite("reused, resize and overwrite", bytes, reused, resize);
+        overwrite("reused, resize_default_init and overwrite", bytes, reused, resizeDefaultInit);
+    }
+
+    size_t count = bytes / sizeof(uint32_t) / 4;
+    CompressedDynamicArray compressed;
+    for(size_t i = 0; i < count; ++i)
+    {
+        compressed.push_back(uint32_t(i * 3));
+    }
+
+    DynamicArray<uint32_t> out;
+    out.resize_default_init(count);
+
+    report("decode into a reused array", count, measure([&]()
+    {
+        out.clear();
+        compressed.decode(out);
+        doNotOptimize(out.back());
+    }));
+
+    report("decode_block and append", count, measure([&]()
+    {
+        out.clear();
+        uint32_t values[CompressedDynamicArray::BLOCK_SIZE];
+        for(size_t block = 0; block <= compressed.block_count(); ++block)
+        {
+            compressed.decode_block(block, values);
+            size_t decoded = block < compressed.block_count() ? CompressedDynamicArray::BLOCK_SIZE : count % CompressedDynamicArray::BLOCK_SIZE;
+            out.append(values, decoded);
+        }
+        doNotOptimize(out.back());
+    }));
+
+    return 0;
+}
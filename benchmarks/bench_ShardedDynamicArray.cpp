@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+#include "../ShardedDynamicArray.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief runs a function in several threads, giving every thread its index
+ */
+template <class Function>
+void inThreads(size_t threads, Function function)
+{
+    std::vector<std::thread> workers;
+    for(size_t i = 0; i < threads; ++i)
+    {
+        workers.emplace_back(function, i);
+    }
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * Measures several threads building partial arrays and merging them - with the arrays next to each other
+ * in a std::vector and merged by one thread, and with a ShardedDynamicArray merged by all threads.
+ *
+ * usage: bench_ShardedDynamicArray [elements] [threads]
+ */
+int main(int argc, char** argv)
+{
+    size_t count = argument(argc, argv, 1, size_t(1) << 26);
+    size_t threads = argument(argc, argv, 2, parallelThreads());
+    size_t share = count / threads;
+
+    std::vector<DynamicArray<uint64_t>> adjacent(threads);
+    report("adjacent arrays, build", share * threads, measure([&]()
+    {
+        inThreads(threads, [&](size_t thread)
+        {
+            adjacent[thread].clear();
+            for(uint64_t i = 0; i < share; ++i)
+            {
+                adjacent[thread].push_back(i);
+            }
+        });
+    }));
+
+    DynamicArray<uint64_t> merged;
+    report("adjacent arrays, serial merge", share * threads, measure([&]()
+    {
+        merged.clear();
+        for(const DynamicArray<uint64_t>& part : adjacent)
+        {
+            for(uint64_t value : part)
+            {
+                merged.push_back(value);
+            }
+        }
+        doNotOptimize(merged.data());
+    }));
+
+    ShardedDynamicArray<uint64_t> sharded(threads);
+    report("sharded array, build", share * threads, measure([&]()
+    {
+        inThreads(threads, [&](size_t thread)
+        {
+            DynamicArray<uint64_t>& shard = sharded.shard(thread);
+            shard.clear();
+            for(uint64_t i = 0; i < share; ++i)
+            {
+                shard.push_back(i);
+            }
+        });
+    }));
+
+    report("sharded array, parallel merge", share * threads, measure([&]()
+    {
+        merged.clear();
+        sharded.merge_into(merged, threads);
+        doNotOptimize(merged.data());
+    }));
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "Benchmark.hpp"
+#include "../Sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+/**
+ * @brief measures std::sort, radix_sort and parallel_sort on copies of the same array
+ * 
+ * @param name - name of the element type
+ * @param source - the unsorted array
+ */
+template <class Type>
+void compareSorts(const char* name, const DynamicArray<Type>& source)
+{
+    std::printf("%s\n", name);
+
+    DynamicArray<Type> array(source);
+    Buffer<Type> scratch(source.size());
+
+    report("std::sort", source.size(), measure([&]()
+    {
+        array = source;
+        std::sort(array.begin(), array.end());
+    }, 3));
+
+    report("radix_sort", source.size(), measure([&]()
+    {
+        array = source;
+        radix_sort(array, scratch);
+    }, 3));
+
+    report("parallel_sort", source.size(), measure([&]()
+    {
+        array = source;
+        parallel_sort(array);
+    }, 3));
+}
+
+/**
+ * Compares the in-library sorts with std::sort for integer, floating point and (key, payload) arrays.
+ * The times include copying the unsorted array.
+ * 
+ * usage: bench_Sort [size]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, 1000000);
+
+    std::mt19937_64 generator(1);
+
+    DynamicArray<uint32_t> integers(size);
+    DynamicArray<uint64_t> longIntegers(size);
+    DynamicArray<double> doubles(size);
+    DynamicArray<std::pair<uint64_t, uint64_t>> pairs(size);
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        uint64_t value = generator();
+        integers.push_back(value);
+        longIntegers.push_back(value);
+        doubles.push_back(double(int64_t(value)) / 3.0);
+        pairs.push_back(std::make_pair(value, i));
+    }
+
+    std::printf("size %zu, %zu threads\n", size, parallelThreads());
+
+    compareSorts("uint32_t", integers);
+    compareSorts("uint64_t", longIntegers);
+    compareSorts("double", doubles);
+
+    std::printf("(uint64_t, uint64_t) by key\n");
+
+    DynamicArray<std::pair<uint64_t, uint64_t>> array(pairs);
+    Buffer<std::pair<uint64_t, uint64_t>> scratch(size);
+    auto byKey = [](const std::pair<uint64_t, uint64_t>& lhs, const std::pair<uint64_t, uint64_t>& rhs)
+    {
+        return lhs.first < rhs.first;
+    };
+
+    report("std::stable_sort", size, measure([&]()
+    {
+        array = pairs;
+        std::stable_sort(array.begin(), array.end(), byKey);
+    }, 3));
+
+    report("radix_sort by key", size, measure([&]()
+    {
+        array = pairs;
+        radix_sort(array, [](const std::pair<uint64_t, uint64_t>& pair) { return pair.first; }, scratch);
+    }, 3));
+
+    report("parallel_stable_sort", size, measure([&]()
+    {
+        array = pairs;
+        parallel_stable_sort(array, byKey);
+    }, 3));
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "Benchmark.hpp"
+#include "../Stream.hpp"
+
+#include <chrono>
+
+/**
+ * @brief time since the start of a run in microseconds
+ */
+double since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief the first stage - scales the chunks of an array and writes them to a channel
+ */
+StreamTask scale(const DynamicArray<double>& source, size_t chunk, BatchChannel<double>& channel)
+{
+    DynamicArray<double> scaled(chunk);
+    for(std::span<const double> part : stream_chunks(source, chunk))
+    {
+        scaled.clear();
+        for(double value : part)
+        {
+            scaled.push_back(value * 1.5);
+        }
+        co_await channel.write(std::span<const double>(scaled.data(), scaled.size()));
+    }
+    channel.close();
+}
+
+/**
+ * @brief the second stage - sums the batches of a channel and notes when the first one arrived
+ */
+StreamTask sum(BatchChannel<double>& channel, double& total, std::chrono::steady_clock::time_point start, double& firstBatch)
+{
+    for(;;)
+    {
+        std::span<const double> batch = co_await channel.read();
+        if(batch.empty())
+            break;
+
+        if(firstBatch < 0)
+            firstBatch = since(start);
+        for(double value : batch)
+        {
+            total += value;
+        }
+    }
+}
+
+/**
+ * Measures a two-stage pipeline that scales and sums an array - with the intermediate result materialized
+ * as a full copy and streamed through a BatchChannel. Reports the time, the latency until the second stage
+ * gets its first elements and the memory held between the stages.
+ *
+ * usage: bench_Stream [elements] [elements per chunk] [channel limit]
+ */
+int main(int argc, char** argv)
+{
+    size_t size = argument(argc, argv, 1, size_t(1) << 24);
+    size_t chunk = argument(argc, argv, 2, 4096);
+    size_t limit = argument(argc, argv, 3, 65536);
+
+    DynamicArray<double> source;
+    source.resize_default_init(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        source[i] = double(i % 1000);
+    }
+
+    double firstBatch = -1;
+    report("materialized copy", size, measure([&]()
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        DynamicArray<double> scaled(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            scaled.push_back(source[i] * 1.5);
+        }
+
+        double total = 0;
+        firstBatch = since(start);
+        for(size_t i = 0; i < size; ++i)
+        {
+            total += scaled[i];
+        }
+        doNotOptimize(total);
+    }));
+    std::printf("  first elements after %.1f us, %zu bytes between the stages\n", firstBatch, size * sizeof(double));
+
+    size_t highWater = 0;
+    report("streamed through a channel", size, measure([&]()
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        StreamScheduler scheduler;
+        BatchChannel<double> channel(scheduler, limit);
+        double total = 0;
+        firstBatch = -1;
+
+        StreamTask producer = scale(source, chunk, channel);
+        StreamTask consumer = sum(channel, total, start, firstBatch);
+        scheduler.spawn(producer);
+        scheduler.spawn(consumer);
+        scheduler.run();
+
+        highWater = channel.high_water();
+        doNotOptimize(total);
+    }));
+    std::printf("  first elements after %.1f us, %zu bytes between the stages\n", firstBatch, highWater * sizeof(double));
+
+    return 0;
+}
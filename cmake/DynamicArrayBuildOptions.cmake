@@ -0,0 +1,49 @@
+# Compiler flags of the targets built by the project itself - the tests, benchmarks and fuzzers.
+# They aren't added to the DynamicArray target, consumers choose their own flags.
+
+if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    message(WARNING "The headers use GCC builtins, only GCC and Clang are supported")
+endif()
+
+string(TOUPPER "${DYNAMIC_ARRAY_SIMD}" DYNAMIC_ARRAY_SIMD)
+if(DYNAMIC_ARRAY_SIMD STREQUAL "NONE")
+    set(DYNAMIC_ARRAY_SIMD_FLAGS "")
+elseif(DYNAMIC_ARRAY_SIMD STREQUAL "SSE2")
+    set(DYNAMIC_ARRAY_SIMD_FLAGS -msse2)
+elseif(DYNAMIC_ARRAY_SIMD STREQUAL "AVX2")
+    set(DYNAMIC_ARRAY_SIMD_FLAGS -mavx2 -mfma -mbmi -mbmi2 -mpopcnt)
+elseif(DYNAMIC_ARRAY_SIMD STREQUAL "AVX512")
+    set(DYNAMIC_ARRAY_SIMD_FLAGS -mavx512f -mavx512bw -mavx512dq -mavx512vl -mavx2 -mfma -mbmi -mbmi2 -mpopcnt)
+elseif(DYNAMIC_ARRAY_SIMD STREQUAL "NATIVE")
+    set(DYNAMIC_ARRAY_SIMD_FLAGS -march=native)
+else()
+    message(FATAL_ERROR "DYNAMIC_ARRAY_SIMD must be NONE, SSE2, AVX2, AVX512 or NATIVE")
+endif()
+
+set(DYNAMIC_ARRAY_INSTRUMENTATION_FLAGS "")
+if(NOT DYNAMIC_ARRAY_SANITIZERS STREQUAL "")
+    if(DYNAMIC_ARRAY_SANITIZERS MATCHES "memory" AND NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        message(FATAL_ERROR "MemorySanitizer requires Clang")
+    endif()
+    list(APPEND DYNAMIC_ARRAY_INSTRUMENTATION_FLAGS -fsanitize=${DYNAMIC_ARRAY_SANITIZERS} -fno-omit-frame-pointer -fno-sanitize-recover=all)
+endif()
+if(DYNAMIC_ARRAY_COVERAGE)
+    list(APPEND DYNAMIC_ARRAY_INSTRUMENTATION_FLAGS --coverage)
+endif()
+
+# applies the instruction set and the instrumentation to a test or fuzz target
+function(dynamic_array_checked_target target)
+    target_link_libraries(${target} PRIVATE DynamicArray::DynamicArray)
+    target_compile_features(${target} PRIVATE cxx_std_20)
+    target_compile_options(${target} PRIVATE ${DYNAMIC_ARRAY_SIMD_FLAGS} ${DYNAMIC_ARRAY_INSTRUMENTATION_FLAGS})
+    target_link_options(${target} PRIVATE ${DYNAMIC_ARRAY_INSTRUMENTATION_FLAGS})
+endfunction()
+
+# applies the instruction set and fixed optimization flags to a benchmark target, so the
+# measurements don't depend on the build type
+function(dynamic_array_benchmark_target target)
+    target_link_libraries(${target} PRIVATE DynamicArray::DynamicArray)
+    target_compile_features(${target} PRIVATE cxx_std_20)
+    target_compile_options(${target} PRIVATE -O3 ${DYNAMIC_ARRAY_SIMD_FLAGS})
+    target_compile_definitions(${target} PRIVATE NDEBUG)
+endfunction()
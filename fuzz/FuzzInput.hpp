@@ -0,0 +1,93 @@
+#ifndef _FUZZ_INPUT_
+#define _FUZZ_INPUT_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * @brief FuzzInput class reads the operations of a fuzz test and their arguments from the input bytes
+ *  - reading past the end of the input returns zeros, so every input is a valid sequence of operations
+ */
+class FuzzInput
+{
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+
+public:
+    FuzzInput(const uint8_t*, size_t);
+
+public:
+    bool empty()const;
+    uint8_t byte();
+    size_t number(size_t);
+    std::string text();
+};
+
+/**
+ * @brief stops the fuzz test if a condition doesn't hold, so the fuzzer saves the input that broke it
+ */
+#define FUZZ_CHECK(condition) \
+    ((condition) ? (void)0 : (std::fprintf(stderr, "%s:%d: fuzz check failed: %s\n", __FILE__, __LINE__, #condition), std::abort()))
+
+/**
+ * @brief Construct a new Fuzz Input object
+ *
+ * @param data - the input bytes
+ * @param size - number of the bytes
+ */
+inline FuzzInput::FuzzInput(const uint8_t* data, size_t size) : data(data), size(size), position(0)
+{
+
+}
+
+/**
+ * @brief checks if all bytes of the input are read
+ *
+ * @return true
+ * @return false
+ */
+inline bool FuzzInput::empty()const
+{
+    return position >= size;
+}
+
+/**
+ * @brief reads the next byte
+ *
+ * @return uint8_t - the byte or 0 at the end of the input
+ */
+inline uint8_t FuzzInput::byte()
+{
+    return position < size ? data[position++] : 0;
+}
+
+/**
+ * @brief reads a number from the next two bytes
+ *
+ * @param limit - the number is smaller than the limit
+ * @return size_t
+ */
+inline size_t FuzzInput::number(size_t limit)
+{
+    size_t value = byte();
+    value |= size_t(byte()) << 8;
+    return limit > 0 ? value % limit : 0;
+}
+
+/**
+ * @brief reads a string of up to 63 equal characters, so that longer ones are allocated on the heap
+ *
+ * @return std::string
+ */
+inline std::string FuzzInput::text()
+{
+    size_t length = byte() % 64;
+    return std::string(length, char('a' + byte() % 26));
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+/**
+ * Runs a fuzz target without libFuzzer, e.g. with compilers that don't support -fsanitize=fuzzer.
+ * 
+ * usage: fuzz_target [input files...]
+ *  - with files it runs every file once, e.g. to reproduce a crash saved by libFuzzer
+ *  - without files it runs random inputs, FUZZ_RUNS of them (10000 by default) with the seed FUZZ_SEED
+ */
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+/**
+ * @brief returns the value of an environment variable or a default value
+ */
+static size_t environment(const char* name, size_t fallback)
+{
+    const char* value = std::getenv(name);
+    return value ? std::strtoull(value, nullptr, 10) : fallback;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc > 1)
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            std::ifstream file(argv[i], std::ios::binary);
+            if(!file)
+            {
+                std::fprintf(stderr, "cannot open %s\n", argv[i]);
+                return 1;
+            }
+
+            std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        return 0;
+    }
+
+    size_t runs = environment("FUZZ_RUNS", 10000);
+    std::mt19937_64 generator(environment("FUZZ_SEED", 1));
+
+    std::vector<uint8_t> data;
+    for(size_t run = 0; run < runs; ++run)
+    {
+        data.resize(generator() % 4096);
+        for(uint8_t& byte : data)
+        {
+            byte = uint8_t(generator());
+        }
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+
+    std::printf("%zu inputs passed\n", runs);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "FuzzInput.hpp"
+#include "../Buffer.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * Drives two Buffers of strings with random sequences of construction, copying, swapping and clearing
+ * and compares them with two std::vectors after every operation.
+ * 
+ * build with libFuzzer: clang++ -std=c++20 -g -fsanitize=fuzzer,address,undefined fuzz/fuzz_Buffer.cpp
+ * build without it:     g++ -std=c++20 -g -fsanitize=address,undefined fuzz/fuzz_Buffer.cpp fuzz/StandaloneFuzzDriver.cpp
+ */
+
+const size_t MAX_SIZE = 512;
+
+/**
+ * @brief checks that a buffer has the elements of its oracle
+ */
+void compare(const Buffer<std::string>& buffer, const std::vector<std::string>& oracle)
+{
+    FUZZ_CHECK(buffer.size() == oracle.size());
+    FUZZ_CHECK((buffer.begin() == nullptr) == oracle.empty());
+    FUZZ_CHECK(buffer.end() - buffer.begin() == ptrdiff_t(oracle.size()));
+
+    for(size_t i = 0; i < oracle.size(); ++i)
+    {
+        FUZZ_CHECK(buffer[i] == oracle[i]);
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    FuzzInput input(data, size);
+
+    Buffer<std::string> buffers[2];
+    std::vector<std::string> oracles[2];
+
+    while(!input.empty())
+    {
+        size_t target = input.byte() % 2;
+        Buffer<std::string>& buffer = buffers[target];
+        std::vector<std::string>& oracle = oracles[target];
+
+        switch(input.byte() % 6)
+        {
+        case 0:
+        {
+            size_t length = input.number(MAX_SIZE);
+            Buffer<std::string> created(length);
+            buffer.swap(created);
+            oracle.assign(length, std::string());
+            break;
+        }
+        case 1:
+        {
+            if(!oracle.empty())
+            {
+                size_t index = input.number(oracle.size());
+                std::string element = input.text();
+                buffer[index] = element;
+                oracle[index] = element;
+            }
+            break;
+        }
+        case 2:
+        {
+            size_t length = input.number(MAX_SIZE);
+            size_t copied = input.number(oracle.size() + 1);
+            size_t kept = length < copied ? length : copied;
+
+            Buffer<std::string> copy(length, copied, buffer);
+            buffer.swap(copy);
+            compare(copy, oracle);
+
+            oracle.resize(kept);
+            oracle.resize(length);
+            break;
+        }
+        case 3:
+        {
+            size_t length = oracle.size() + input.number(MAX_SIZE);
+            Buffer<std::string> copy(length, buffer);
+            buffer.swap(copy);
+            oracle.resize(length);
+            break;
+        }
+        case 4:
+        {
+            buffers[0].swap(buffers[1]);
+            oracles[0].swap(oracles[1]);
+            buffer.swap(buffer);
+            break;
+        }
+        case 5:
+        {
+            buffer.clear();
+            oracle.clear();
+            break;
+        }
+        }
+
+        compare(buffers[0], oracles[0]);
+        compare(buffers[1], oracles[1]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+#include "FuzzInput.hpp"
+#include "../DynamicArray.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Drives a DynamicArray with random sequences of operations and compares it with a std::vector
+ * after every operation.
+ * 
+ * build with libFuzzer: clang++ -std=c++20 -g -fsanitize=fuzzer,address,undefined fuzz/fuzz_DynamicArray.cpp
+ * build without it:     g++ -std=c++20 -g -fsanitize=address,undefined fuzz/fuzz_DynamicArray.cpp fuzz/StandaloneFuzzDriver.cpp
+ */
+
+const size_t MAX_SIZE = 1024;
+
+/**
+ * @brief reads a value of the elements from the input
+ */
+template <class Type>
+Type value(FuzzInput& input);
+
+template <>
+int value<int>(FuzzInput& input)
+{
+    return int(input.number(1 << 16));
+}
+
+template <>
+std::string value<std::string>(FuzzInput& input)
+{
+    return input.text();
+}
+
+/**
+ * @brief returns the capacity the array gets when it is resized or reserved with a specific size
+ */
+template <class Type>
+size_t resizedCapacity(const DynamicArray<Type>& array, size_t size)
+{
+    if(size > array.capacity() && size < array.capacity() * 2)
+        return array.capacity() * 2;
+    return size;
+}
+
+/**
+ * @brief checks that the array has the elements of the oracle
+ */
+template <class Type>
+void compare(const DynamicArray<Type>& array, const std::vector<Type>& oracle)
+{
+    FUZZ_CHECK(array.size() == oracle.size());
+    FUZZ_CHECK(array.capacity() >= array.size());
+    FUZZ_CHECK(array.empty() == oracle.empty());
+
+    for(size_t i = 0; i < oracle.size(); ++i)
+    {
+        FUZZ_CHECK(array[i] == oracle[i]);
+    }
+
+    if(!oracle.empty())
+    {
+        FUZZ_CHECK(array.front() == oracle.front());
+        FUZZ_CHECK(array.back() == oracle.back());
+    }
+}
+
+/**
+ * @brief runs the operations of the input on an array and its oracle
+ */
+template <class Type>
+void run(FuzzInput& input)
+{
+    DynamicArray<Type> array;
+    std::vector<Type> oracle;
+
+    while(!input.empty())
+    {
+        switch(input.byte() % 12)
+        {
+        case 0:
+        case 1:
+        {
+            Type element = value<Type>(input);
+            array.push_back(element);
+            oracle.push_back(element);
+            break;
+        }
+        case 2:
+        {
+            if(!oracle.empty())
+            {
+                Type element = oracle[input.number(oracle.size())];
+                array.push_back(element);
+                oracle.push_back(element);
+            }
+            break;
+        }
+        case 3:
+        {
+            array.pop_back();
+            if(!oracle.empty())
+                oracle.pop_back();
+            break;
+        }
+        case 4:
+        {
+            size_t size = input.number(MAX_SIZE);
+            Type element = value<Type>(input);
+            size_t capacity = resizedCapacity(array, size);
+
+            array.resize(size, element);
+            oracle.resize(oracle.size() < capacity ? oracle.size() : capacity);
+            oracle.resize(capacity, element);
+            FUZZ_CHECK(array.capacity() == capacity);
+            break;
+        }
+        case 5:
+        {
+            size_t size = input.number(MAX_SIZE);
+            size_t capacity = resizedCapacity(array, size);
+
+            array.reserve(size);
+            oracle.resize(oracle.size() < capacity ? oracle.size() : capacity);
+            FUZZ_CHECK(array.capacity() == capacity);
+            break;
+        }
+        case 6:
+        {
+            size_t capacity = array.capacity();
+            array.clear();
+            oracle.clear();
+            FUZZ_CHECK(array.capacity() == capacity);
+            break;
+        }
+        case 7:
+        {
+            array.release();
+            oracle.clear();
+            FUZZ_CHECK(array.capacity() == 0);
+            break;
+        }
+        case 8:
+        {
+            DynamicArray<Type> copy(array);
+            compare(copy, oracle);
+
+            DynamicArray<Type> assigned;
+            assigned.push_back(value<Type>(input));
+            assigned = copy;
+            compare(assigned, oracle);
+
+            array = array;
+            if(input.byte() % 2)
+                array = assigned;
+            break;
+        }
+        case 9:
+        {
+            size_t index = input.number(2 * oracle.size() + 1);
+            if(index < oracle.size())
+            {
+                FUZZ_CHECK(array.at(index) == oracle[index]);
+            }
+            else
+            {
+                bool thrown = false;
+                try
+                {
+                    array.at(index);
+                }
+                catch(const std::out_of_range&)
+                {
+                    thrown = true;
+                }
+                FUZZ_CHECK(thrown);
+            }
+            break;
+        }
+        case 10:
+        {
+            if(oracle.size() > MAX_SIZE)
+                break;
+
+            size_t first = input.number(oracle.size() + 1);
+            size_t count = input.number(oracle.size() - first + 1);
+
+            std::vector<Type> appended(oracle.begin() + first, oracle.begin() + first + count);
+            array.append(array.data() + first, count);
+            oracle.insert(oracle.end(), appended.begin(), appended.end());
+            break;
+        }
+        case 11:
+        {
+            size_t count = input.number(MAX_SIZE / 8);
+            Type element = value<Type>(input);
+
+            array.append_n(count, element);
+            oracle.insert(oracle.end(), count, element);
+            break;
+        }
+        }
+
+        compare(array, oracle);
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    if(size == 0)
+        return 0;
+
+    FuzzInput input(data + 1, size - 1);
+    if(data[0] % 2)
+        run<std::string>(input);
+    else
+        run<int>(input);
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+#include "catch.hpp"
+#include "../Allocator.hpp"
+#include "../DynamicArray.hpp"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+class TestAllocator
+{
+public:
+
+    static bool isAligned(const void* pointer, size_t alignment)
+    {
+        return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+    }
+
+    template <class Allocator>
+    static bool fillAndCheck(DynamicArray<std::string, Allocator>& array, size_t count)
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            array.push_back(std::to_string(i));
+        }
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(array[i] != std::to_string(i))
+                return false;
+        }
+        return true;
+    }
+};
+
+struct alignas(64) CacheLine
+{
+    int value;
+};
+
+SCENARIO("Testing the monotonic arena")
+{
+    GIVEN("An arena with a small first chunk")
+    {
+        MonotonicArena arena(256);
+
+        WHEN("Memory with different sizes and alignments is allocated")
+        {
+            void* first = arena.allocate(10, 1);
+            void* second = arena.allocate(100, 64);
+            void* third = arena.allocate(1000, 16);
+
+            THEN("Every block should be aligned and the arena should grow")
+            {
+                REQUIRE(TestAllocator::isAligned(second, 64));
+                REQUIRE(TestAllocator::isAligned(third, 16));
+                REQUIRE(first != second);
+                REQUIRE(arena.reserved() >= 1110);
+            }
+
+            WHEN("The arena is reset")
+            {
+                size_t reserved = arena.reserved();
+                arena.reset();
+
+                void* reused = arena.allocate(10, 1);
+
+                THEN("The memory should be reused without new chunks")
+                {
+                    REQUIRE(reused == first);
+                    REQUIRE(arena.reserved() == reserved);
+                }
+            }
+        }
+
+        WHEN("Arrays allocate from the arena")
+        {
+            DynamicArray<std::string, ArenaAllocator> strings((ArenaAllocator(arena)));
+            DynamicArray<CacheLine, ArenaAllocator> lines(3, ArenaAllocator(arena));
+
+            THEN("The elements should be valid")
+            {
+                CHECK(TestAllocator::fillAndCheck(strings, 100));
+                REQUIRE(TestAllocator::isAligned(lines.data(), 64));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the size class pool")
+{
+    GIVEN("A pool")
+    {
+        SizeClassPool pool;
+
+        WHEN("A block is released")
+        {
+            void* block = pool.allocate(100, 8);
+            pool.deallocate(block, 100, 8);
+
+            THEN("It should be reused by a request of the same size class")
+            {
+                void* reused = pool.allocate(128, 64);
+                REQUIRE(reused == block);
+                REQUIRE(TestAllocator::isAligned(reused, SizeClassPool::BLOCK_ALIGNMENT));
+                pool.deallocate(reused, 128, 64);
+
+                SizeClassPool::Statistics statistics = pool.statistics();
+                REQUIRE(statistics.hits == 1);
+                REQUIRE(statistics.misses == 1);
+                REQUIRE(statistics.returned == 2);
+                REQUIRE(statistics.retained == 128);
+                REQUIRE(statistics.hit_rate() == 0.5);
+            }
+        }
+
+        WHEN("A large block is allocated")
+        {
+            void* block = pool.allocate(SizeClassPool::MAX_CLASS + 1, 8);
+
+            THEN("It should bypass the pool")
+            {
+                REQUIRE(block != nullptr);
+                pool.deallocate(block, SizeClassPool::MAX_CLASS + 1, 8);
+
+                SizeClassPool::Statistics statistics = pool.statistics();
+                REQUIRE(statistics.misses == 0);
+                REQUIRE(statistics.retained == 0);
+            }
+        }
+
+        WHEN("An array allocates from the pool")
+        {
+            DynamicArray<std::string, PoolAllocator> strings((PoolAllocator(pool)));
+
+            THEN("The elements should be valid")
+            {
+                CHECK(TestAllocator::fillAndCheck(strings, 1000));
+            }
+        }
+
+        WHEN("The storage of an array is released and the array is refilled")
+        {
+            DynamicArray<std::string, PoolAllocator> strings((PoolAllocator(pool)));
+            TestAllocator::fillAndCheck(strings, 1000);
+            strings.release();
+            pool.reset_statistics();
+
+            TestAllocator::fillAndCheck(strings, 1000);
+
+            THEN("Every allocation should be served by the pool")
+            {
+                SizeClassPool::Statistics statistics = pool.statistics();
+                REQUIRE(statistics.misses == 0);
+                REQUIRE(statistics.hits > 0);
+                REQUIRE(strings[999] == "999");
+            }
+        }
+    }
+
+    GIVEN("A pool with a limit")
+    {
+        SizeClassPool pool(1024);
+
+        WHEN("More bytes than the limit are released")
+        {
+            void* first = pool.allocate(1024, 8);
+            void* second = pool.allocate(512, 8);
+            pool.deallocate(first, 1024, 8);
+            pool.deallocate(second, 512, 8);
+
+            THEN("The blocks above the limit should be released to the heap")
+            {
+                SizeClassPool::Statistics statistics = pool.statistics();
+                REQUIRE(statistics.returned == 1);
+                REQUIRE(statistics.dropped == 1);
+                REQUIRE(statistics.retained == 1024);
+            }
+
+            WHEN("The limit is lowered")
+            {
+                pool.set_limit(0);
+
+                THEN("All blocks should be released")
+                {
+                    REQUIRE(pool.statistics().retained == 0);
+                    REQUIRE(pool.get_limit() == 0);
+                }
+            }
+        }
+    }
+
+    GIVEN("Arrays using the process-wide pool from several threads")
+    {
+        std::thread workers[4];
+        for(std::thread& worker : workers)
+        {
+            worker = std::thread([]()
+            {
+                for(size_t round = 0; round < 50; ++round)
+                {
+                    DynamicArray<std::string, GlobalPoolAllocator> strings;
+                    TestAllocator::fillAndCheck(strings, 100);
+                }
+            });
+        }
+        for(std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        THEN("Later allocations should be served by the pool")
+        {
+            REQUIRE(SizeClassPool::global().statistics().hits > 0);
+        }
+    }
+
+    GIVEN("A thread_local array created before the pool of its thread")
+    {
+        size_t returned = SizeClassPool::global().statistics().returned;
+
+        std::thread worker([]()
+        {
+            thread_local DynamicArray<int, ThreadLocalPoolAllocator> values;
+            values.push_back(1);
+        });
+        worker.join();
+
+        THEN("It should release its storage to the process-wide pool after the pool of the thread is destroyed")
+        {
+            REQUIRE(SizeClassPool::global().statistics().returned > returned);
+        }
+    }
+
+    GIVEN("Arrays using the pool of their thread")
+    {
+        DynamicArray<std::string, ThreadLocalPoolAllocator> strings;
+
+        THEN("The elements should be valid")
+        {
+            CHECK(TestAllocator::fillAndCheck(strings, 1000));
+        }
+
+        WHEN("An array is copied and assigned")
+        {
+            TestAllocator::fillAndCheck(strings, 10);
+
+            DynamicArray<std::string, ThreadLocalPoolAllocator> copy(strings);
+            DynamicArray<std::string, ThreadLocalPoolAllocator> assigned;
+            assigned = copy;
+
+            THEN("The copies should have the same elements")
+            {
+                REQUIRE(assigned.size() == 10);
+                REQUIRE(assigned[9] == "9");
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include "catch.hpp"
+#include "../CompressedDynamicArray.hpp"
+
+#include <random>
+
+class TestCompressedDynamicArray
+{
+public:
+
+    static DynamicArray<uint32_t> values(size_t size, int kind)
+    {
+        std::mt19937 generator(size + kind);
+
+        DynamicArray<uint32_t> array(size);
+        uint32_t current = 1000;
+        for(size_t i = 0; i < size; ++i)
+        {
+            switch(kind)
+            {
+            case 0:
+                current += generator() % 20;
+                array.push_back(current);
+                break;
+            case 1:
+                array.push_back(5000 + generator() % 1000);
+                break;
+            case 2:
+                array.push_back(42);
+                break;
+            default:
+                array.push_back(generator());
+                break;
+            }
+        }
+        return array;
+    }
+
+    static bool haveSameValues(const CompressedDynamicArray& compressed, const DynamicArray<uint32_t>& expected)
+    {
+        if(compressed.size() != expected.size())
+            return false;
+
+        for(size_t i = 0; i < expected.size(); ++i)
+        {
+            if(compressed[i] != expected[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+SCENARIO("Testing compression of integer arrays")
+{
+    GIVEN("Sorted, clustered, constant and random values")
+    {
+        int kind = GENERATE(0, 1, 2, 3);
+        size_t size = GENERATE(0, 1, 127, 128, 129, 1000);
+
+        DynamicArray<uint32_t> expected = TestCompressedDynamicArray::values(size, kind);
+        CompressedDynamicArray compressed(expected);
+
+        THEN("The blocks and the size should be valid")
+        {
+            REQUIRE(compressed.size() == size);
+            REQUIRE(compressed.block_count() == size / CompressedDynamicArray::BLOCK_SIZE);
+            REQUIRE(compressed.empty() == (size == 0));
+        }
+
+        THEN("Every value should be accessible")
+        {
+            CHECK(TestCompressedDynamicArray::haveSameValues(compressed, expected));
+            REQUIRE_THROWS_AS(compressed.at(size), std::out_of_range);
+        }
+
+        WHEN("All values are decoded into an array")
+        {
+            DynamicArray<uint32_t> decoded;
+            decoded.push_back(7);
+            compressed.decode(decoded);
+
+            THEN("The values should be appended in the same order")
+            {
+                REQUIRE(decoded.size() == size + 1);
+                REQUIRE(decoded[0] == 7);
+                for(size_t i = 0; i < size; ++i)
+                {
+                    if(decoded[i + 1] != expected[i])
+                        CHECK(false);
+                }
+            }
+        }
+
+        WHEN("More values are pushed")
+        {
+            for(uint32_t i = 0; i < 200; ++i)
+            {
+                compressed.push_back(i * 3);
+                expected.push_back(i * 3);
+            }
+
+            THEN("All values should be accessible")
+            {
+                CHECK(TestCompressedDynamicArray::haveSameValues(compressed, expected));
+            }
+        }
+    }
+
+    GIVEN("Sorted values with small gaps")
+    {
+        DynamicArray<uint32_t> expected = TestCompressedDynamicArray::values(128 * 100, 0);
+        CompressedDynamicArray compressed(expected);
+
+        THEN("They should take several times less memory")
+        {
+            REQUIRE(compressed.compressed_bytes() * 3 < expected.size() * sizeof(uint32_t));
+        }
+
+        THEN("Every block should be decoded separately")
+        {
+            uint32_t values[CompressedDynamicArray::BLOCK_SIZE];
+            compressed.decode_block(50, values);
+
+            for(size_t i = 0; i < CompressedDynamicArray::BLOCK_SIZE; ++i)
+            {
+                if(values[i] != expected[50 * CompressedDynamicArray::BLOCK_SIZE + i])
+                    CHECK(false);
+            }
+            REQUIRE_THROWS_AS(compressed.decode_block(101, values), std::out_of_range);
+        }
+    }
+}
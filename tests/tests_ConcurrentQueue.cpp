@@ -0,0 +1,435 @@
+#include "catch.hpp"
+#include "../ConcurrentQueue.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Element type whose default construction throws while it is switched on, it isn't trivially destructible,
+ * so the arrays reset its elements when they are cleared.
+ */
+class FailingDefault
+{
+public:
+    static bool failing;
+
+    int value;
+
+public:
+    FailingDefault() : value(0)
+    {
+        if(failing)
+            throw std::runtime_error("Injected default construction failure");
+    }
+
+    FailingDefault(int value) : value(value)
+    {
+
+    }
+
+    ~FailingDefault()
+    {
+
+    }
+};
+
+bool FailingDefault::failing = false;
+
+class TestConcurrentQueue
+{
+public:
+
+    template <class Wait>
+    static bool transfersInOrder(size_t count, size_t capacity)
+    {
+        SpscQueue<uint64_t, Wait> queue(capacity);
+        bool ordered = true;
+
+        std::thread consumer([&]()
+        {
+            uint64_t batch[7];
+            uint64_t expected = 0;
+            while(expected < count)
+            {
+                if(expected % 3 == 0)
+                {
+                    ordered &= queue.pop() == expected++;
+                    continue;
+                }
+
+                size_t popped = queue.pop_n(std::span<uint64_t>(batch, 7));
+                for(size_t i = 0; i < popped; ++i)
+                {
+                    ordered &= batch[i] == expected++;
+                }
+            }
+        });
+
+        std::vector<uint64_t> values;
+        for(uint64_t value = 0; value < count; ++value)
+        {
+            if(value % 2 == 0 || value + 5 > count)
+            {
+                queue.push(value);
+                continue;
+            }
+
+            values.clear();
+            for(size_t i = 0; i < 5; ++i)
+            {
+                values.push_back(value + i);
+            }
+            queue.push_n(values);
+            value += 4;
+        }
+        consumer.join();
+
+        return ordered && queue.size_approx() == 0;
+    }
+
+    /**
+     * every producer pushes its index in the upper and a counter in the lower half of the values, so the
+     * consumers can check that every value arrives once and the values of one producer in order
+     */
+    template <class Wait>
+    static bool stressMpmc(size_t producers, size_t consumers, size_t count, size_t capacity)
+    {
+        MpmcQueue<uint64_t, Wait> queue(capacity);
+        std::vector<std::vector<uint64_t>> received(consumers);
+        std::atomic<size_t> remaining(producers * count);
+        std::vector<std::thread> threads;
+
+        for(size_t producer = 0; producer < producers; ++producer)
+        {
+            threads.emplace_back([&, producer]()
+            {
+                for(uint64_t i = 0; i < count; ++i)
+                {
+                    queue.push(producer << 32 | i);
+                }
+            });
+        }
+        for(size_t consumer = 0; consumer < consumers; ++consumer)
+        {
+            threads.emplace_back([&, consumer]()
+            {
+                uint64_t value;
+                while(remaining.load() > 0)
+                {
+                    if(queue.try_pop(value))
+                    {
+                        received[consumer].push_back(value);
+                        remaining.fetch_sub(1);
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::vector<size_t> seen(producers, 0);
+        for(const std::vector<uint64_t>& values : received)
+        {
+            std::vector<int64_t> last(producers, -1);
+            for(uint64_t value : values)
+            {
+                size_t producer = value >> 32;
+                int64_t index = int64_t(value & 0xFFFFFFFF);
+                if(producer >= producers || index <= last[producer])
+                    return false;
+                last[producer] = index;
+                ++seen[producer];
+            }
+        }
+        return seen == std::vector<size_t>(producers, count) && queue.size_approx() == 0;
+    }
+
+    static bool appendsInBatches(size_t producers, size_t count, size_t batchSize, size_t batches)
+    {
+        BatchedAppender<uint64_t> appender(batchSize, batches);
+        DynamicArray<uint64_t> out;
+        std::atomic<size_t> finished(0);
+        std::vector<std::thread> threads;
+
+        for(size_t index = 0; index < producers; ++index)
+        {
+            threads.emplace_back([&, index]()
+            {
+                BatchedAppender<uint64_t>::Producer producer(appender);
+                for(uint64_t i = 0; i < count; ++i)
+                {
+                    producer.push_back(index << 32 | i);
+                }
+                producer.flush();
+                finished.fetch_add(1);
+            });
+        }
+        while(finished.load() < producers)
+        {
+            if(appender.drain(out) == 0)
+                std::this_thread::yield();
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        appender.drain(out);
+
+        if(out.size() != producers * count)
+            return false;
+
+        std::vector<uint64_t> next(producers, 0);
+        for(uint64_t value : out)
+        {
+            size_t producer = value >> 32;
+            if(producer >= producers || (value & 0xFFFFFFFF) != next[producer]++)
+                return false;
+        }
+        return true;
+    }
+};
+
+SCENARIO("Testing the single-producer single-consumer queue")
+{
+    GIVEN("A queue with a capacity that isn't a power of two")
+    {
+        SpscQueue<std::string> queue(5);
+
+        THEN("The capacity should be rounded up")
+        {
+            REQUIRE(queue.capacity() == 8);
+            REQUIRE(queue.size_approx() == 0);
+        }
+
+        WHEN("It is filled")
+        {
+            for(size_t i = 0; i < 8; ++i)
+            {
+                REQUIRE(queue.try_push(std::to_string(i)));
+            }
+
+            THEN("Further pushes should fail and the elements should come out in order")
+            {
+                REQUIRE_FALSE(queue.try_push("8"));
+                REQUIRE(queue.size_approx() == 8);
+
+                std::string value;
+                for(size_t i = 0; i < 8; ++i)
+                {
+                    REQUIRE(queue.try_pop(value));
+                    REQUIRE(value == std::to_string(i));
+                }
+                REQUIRE_FALSE(queue.try_pop(value));
+            }
+        }
+    }
+
+    GIVEN("Batches that wrap around the end of the buffer")
+    {
+        SpscQueue<int> queue(8);
+        int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        int out[10] = {};
+
+        REQUIRE(queue.try_push_n(std::span<const int>(values, 6)) == 6);
+        REQUIRE(queue.try_pop_n(std::span<int>(out, 5)) == 5);
+
+        WHEN("More elements are pushed than fit")
+        {
+            size_t pushed = queue.try_push_n(std::span<const int>(values, 10));
+
+            THEN("Only the free slots should be filled")
+            {
+                REQUIRE(pushed == 7);
+                REQUIRE(queue.try_pop_n(std::span<int>(out, 10)) == 8);
+                REQUIRE(out[0] == 5);
+                for(size_t i = 1; i < 8; ++i)
+                {
+                    REQUIRE(out[i] == int(i - 1));
+                }
+                REQUIRE(queue.try_pop_n(std::span<int>(out, 10)) == 0);
+            }
+        }
+    }
+
+    GIVEN("Invalid capacities")
+    {
+        THEN("The construction should throw")
+        {
+            REQUIRE_THROWS_AS(SpscQueue<int>(0), std::invalid_argument);
+            REQUIRE_THROWS_AS(SpscQueue<int>(size_t(-1)), std::invalid_argument);
+        }
+    }
+
+    GIVEN("A producer and a consumer thread")
+    {
+        THEN("Every wait strategy should pass all elements in order")
+        {
+            CHECK(TestConcurrentQueue::transfersInOrder<SpinWait>(20000, 16));
+            CHECK(TestConcurrentQueue::transfersInOrder<YieldWait>(100000, 64));
+            CHECK(TestConcurrentQueue::transfersInOrder<FutexWait>(100000, 4));
+        }
+    }
+}
+
+SCENARIO("Testing the multi-producer multi-consumer queue")
+{
+    GIVEN("A queue used by one thread")
+    {
+        MpmcQueue<std::string> queue(3);
+
+        THEN("It should be bounded and keep the order")
+        {
+            REQUIRE(queue.capacity() == 4);
+            for(size_t i = 0; i < 4; ++i)
+            {
+                REQUIRE(queue.try_push(std::to_string(i)));
+            }
+            REQUIRE_FALSE(queue.try_push("4"));
+            REQUIRE(queue.size_approx() == 4);
+
+            std::string value;
+            for(size_t lap = 0; lap < 3; ++lap)
+            {
+                for(size_t i = 0; i < 4; ++i)
+                {
+                    REQUIRE(queue.try_pop(value));
+                    REQUIRE(value == std::to_string(i));
+                    REQUIRE(queue.try_push(std::to_string(i)));
+                }
+            }
+            REQUIRE(queue.pop() == "0");
+            REQUIRE(queue.size_approx() == 3);
+        }
+
+        THEN("Moved elements should only be taken on success")
+        {
+            std::string value = "moved";
+            REQUIRE(queue.try_push(std::move(value)));
+            REQUIRE(queue.pop() == "moved");
+
+            for(size_t i = 0; i < 4; ++i)
+            {
+                queue.push("filler");
+            }
+            value = "kept";
+            REQUIRE_FALSE(queue.try_push(std::move(value)));
+            REQUIRE(value == "kept");
+        }
+
+        THEN("An empty queue should have nothing to pop")
+        {
+            std::string value;
+            REQUIRE_FALSE(queue.try_pop(value));
+        }
+    }
+
+    GIVEN("Many producer and consumer threads")
+    {
+        THEN("Every element should arrive once and in the order of its producer")
+        {
+            CHECK(TestConcurrentQueue::stressMpmc<YieldWait>(4, 4, 20000, 8));
+            CHECK(TestConcurrentQueue::stressMpmc<FutexWait>(3, 2, 20000, 2));
+            CHECK(TestConcurrentQueue::stressMpmc<SpinWait>(2, 3, 5000, 64));
+        }
+    }
+}
+
+SCENARIO("Testing batched appends of many producers")
+{
+    GIVEN("Invalid sizes")
+    {
+        THEN("The construction should throw")
+        {
+            REQUIRE_THROWS_AS(BatchedAppender<int>(0, 4), std::invalid_argument);
+            REQUIRE_THROWS_AS(BatchedAppender<int>(4, 0), std::invalid_argument);
+        }
+    }
+
+    GIVEN("An appender used by one thread")
+    {
+        BatchedAppender<int> appender(4, 2);
+        DynamicArray<int> out;
+
+        WHEN("Less than a batch is pushed")
+        {
+            BatchedAppender<int>::Producer producer(appender);
+            producer.push_back(1);
+            producer.push_back(2);
+
+            THEN("Nothing should be drained before a flush")
+            {
+                REQUIRE(appender.drain(out) == 0);
+                producer.flush();
+                REQUIRE(appender.drain(out) == 2);
+                REQUIRE(out.size() == 2);
+                REQUIRE(out[1] == 2);
+            }
+        }
+
+        WHEN("Full batches are pushed")
+        {
+            {
+                BatchedAppender<int>::Producer producer(appender);
+                for(int i = 0; i < 9; ++i)
+                {
+                    producer.push_back(i);
+                    if(i == 3)
+                        REQUIRE(appender.drain(out) == 4);
+                }
+            }
+
+            THEN("They should be handed over when full and the rest when the producer is destroyed")
+            {
+                REQUIRE(appender.drain(out) == 5);
+                REQUIRE(out.size() == 9);
+                for(int i = 0; i < 9; ++i)
+                {
+                    REQUIRE(out[i] == i);
+                }
+                REQUIRE(appender.batch_size() == 4);
+            }
+        }
+    }
+
+    GIVEN("An appender with one batch of elements whose default construction fails")
+    {
+        BatchedAppender<FailingDefault> appender(2, 1);
+        DynamicArray<FailingDefault> out;
+        out.reserve(8);
+        BatchedAppender<FailingDefault>::Producer producer(appender);
+
+        FailingDefault::failing = true;
+        producer.push_back(FailingDefault(1));
+        producer.push_back(FailingDefault(2));
+        size_t first = appender.drain(out);
+        producer.push_back(FailingDefault(3));
+        producer.push_back(FailingDefault(4));
+        size_t second = appender.drain(out);
+        FailingDefault::failing = false;
+
+        THEN("Draining should give the batch back without default values")
+        {
+            REQUIRE(first == 2);
+            REQUIRE(second == 2);
+            REQUIRE(out.size() == 4);
+            REQUIRE(out[3].value == 4);
+        }
+    }
+
+    GIVEN("Many producer threads and fewer batches than producers")
+    {
+        THEN("All elements should be drained in the order of their producers")
+        {
+            CHECK(TestConcurrentQueue::appendsInBatches(4, 50000, 256, 3));
+            CHECK(TestConcurrentQueue::appendsInBatches(3, 10000, 1, 8));
+        }
+    }
+}
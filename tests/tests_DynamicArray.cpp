@@ -2,6 +2,7 @@
 #include "../DynamicArray.hpp"
 
 #include <algorithm>
+#include <string>
 
 class TestDynamicArray{
 public:
@@ -186,6 +187,16 @@ SCENARIO("Testing constructor with one argument - size")
         WHEN("The content is erased")
         {
             testArray.clear();
+            THEN("Nothing should change")
+            {
+                REQUIRE(testArray.capacity() == testArraySize);
+                REQUIRE(testArray.size() == 0);
+            }
+        }  
+
+        WHEN("The storage is released")
+        {
+            testArray.release();
             THEN("Only the capacity should change")
             {
                 REQUIRE(testArray.capacity() == 0);
@@ -750,9 +761,67 @@ SCENARIO("Testing clear function")
         {
             testArray.clear();
 
-            THEN("The object should be empty")
+            THEN("The object should be empty and keep its capacity")
             {
                 CHECK(testArray.empty());
+                REQUIRE(testArray.capacity() == 10);
+            }
+        }
+
+        WHEN("The array is cleared and refilled many times")
+        {
+            for(size_t cycle = 0; cycle < 5; ++cycle)
+            {
+                testArray.clear();
+                TestDynamicArray::init(testArray, 10);
+            }
+
+            THEN("It should reuse its storage")
+            {
+                CHECK(TestDynamicArray::isValidArray(testArray, 10));
+            }
+        }
+
+        WHEN("The storage of the object is released")
+        {
+            testArray.release();
+
+            THEN("The object should be empty without capacity")
+            {
+                CHECK(testArray.empty());
+                REQUIRE(testArray.capacity() == 0);
+            }
+
+            WHEN("Elements are pushed again")
+            {
+                TestDynamicArray::init(testArray, 5);
+
+                THEN("The array should grow again")
+                {
+                    CHECK(TestDynamicArray::hasValidElements(testArray, 5));
+                }
+            }
+        }
+    }
+
+    GIVEN("An array of strings")
+    {
+        DynamicArray<std::string> strings;
+        for(size_t i = 0; i < 100; ++i)
+        {
+            strings.push_back(std::string(100, 'a'));
+        }
+        size_t capacity = strings.capacity();
+
+        WHEN("The array is cleared")
+        {
+            strings.clear();
+
+            THEN("The strings should be released and the capacity kept")
+            {
+                REQUIRE(strings.capacity() == capacity);
+                REQUIRE(strings.data()[0].empty());
+                REQUIRE(strings.data()[99].empty());
             }
         }
     }
@@ -1039,3 +1108,175 @@ SCENARIO("Testing reserve function")
         }
     }
 }
+
+SCENARIO("Testing append functions")
+{
+    GIVEN("An array with spare capacity")
+    {
+        DynamicArray<int> testArray(10);
+        TestDynamicArray::init(testArray, 3);
+
+        WHEN("A range fitting the capacity is appended")
+        {
+            int values[] = {3, 4, 5, 6};
+            testArray.append(values, 4);
+
+            THEN("The elements should follow the old ones without growing the array")
+            {
+                REQUIRE(testArray.size() == 7);
+                REQUIRE(testArray.capacity() == 10);
+                CHECK(TestDynamicArray::hasValidElements(testArray, 7));
+            }
+        }
+
+        WHEN("A range larger than the doubled capacity is appended")
+        {
+            DynamicArray<int> other;
+            TestDynamicArray::init(other, 30);
+            testArray.append(other.data() + 3, 27);
+
+            THEN("The array should grow once to the needed size")
+            {
+                REQUIRE(testArray.size() == 30);
+                REQUIRE(testArray.capacity() == 30);
+                CHECK(TestDynamicArray::hasValidElements(testArray, 30));
+            }
+        }
+
+        WHEN("The array appends itself while growing")
+        {
+            testArray.append(testArray.data(), 3);
+            testArray.append(testArray.data(), 6);
+            testArray.append(testArray.data(), 12);
+
+            THEN("The copies should be taken before the old storage is released")
+            {
+                REQUIRE(testArray.size() == 24);
+                for(size_t i = 0; i < 24; ++i)
+                {
+                    REQUIRE(testArray[i] == int(i % 3));
+                }
+            }
+        }
+
+        WHEN("Copies of a value are appended")
+        {
+            testArray.append_n(2, 7);
+            testArray.append_n(20, testArray[1]);
+            testArray.append_n(0, 9);
+
+            THEN("They should follow the old elements")
+            {
+                REQUIRE(testArray.size() == 25);
+                REQUIRE(testArray[3] == 7);
+                REQUIRE(testArray[4] == 7);
+                for(size_t i = 5; i < 25; ++i)
+                {
+                    REQUIRE(testArray[i] == 1);
+                }
+            }
+        }
+
+        WHEN("Elements are appended without being written")
+        {
+            std::span<int> added = testArray.append_uninitialized(40);
+            for(size_t i = 0; i < added.size(); ++i)
+            {
+                added[i] = int(i + 3);
+            }
+
+            THEN("The span should cover the new elements of the array")
+            {
+                REQUIRE(added.size() == 40);
+                REQUIRE(added.data() == testArray.data() + 3);
+                REQUIRE(testArray.size() == 43);
+                CHECK(TestDynamicArray::hasValidElements(testArray, 43));
+            }
+        }
+    }
+
+    GIVEN("An array of strings")
+    {
+        DynamicArray<std::string> strings;
+        strings.push_back("a");
+
+        WHEN("Strings are appended")
+        {
+            std::string values[] = {"b", "c"};
+            strings.append(values, 2);
+            strings.append_n(3, strings[0]);
+
+            THEN("They should be copied")
+            {
+                REQUIRE(strings.size() == 6);
+                REQUIRE(strings[2] == "c");
+                REQUIRE(strings[5] == "a");
+            }
+        }
+    }
+}
+
+SCENARIO("Testing resize_default_init function")
+{
+    GIVEN("An array with some elements")
+    {
+        DynamicArray<int> testArray(10);
+        TestDynamicArray::init(testArray, 5);
+
+        WHEN("It is resized to a size within its capacity")
+        {
+            testArray.resize_default_init(8);
+
+            THEN("The size should be exact and the capacity unchanged")
+            {
+                REQUIRE(testArray.size() == 8);
+                REQUIRE(testArray.capacity() == 10);
+                CHECK(TestDynamicArray::hasValidElements(testArray, 5));
+            }
+        }
+
+        WHEN("It is resized to a size above its doubled capacity")
+        {
+            testArray.resize_default_init(1000);
+            for(size_t i = 5; i < 1000; ++i)
+            {
+                testArray[i] = int(i);
+            }
+
+            THEN("It should grow to exactly that size and keep its elements")
+            {
+                REQUIRE(testArray.size() == 1000);
+                REQUIRE(testArray.capacity() == 1000);
+                CHECK(TestDynamicArray::hasValidElements(testArray, 1000));
+            }
+        }
+
+        WHEN("It is resized to a smaller size")
+        {
+            testArray.resize_default_init(2);
+
+            THEN("The last elements should be removed and the capacity kept")
+            {
+                REQUIRE(testArray.size() == 2);
+                REQUIRE(testArray.capacity() == 10);
+                CHECK(TestDynamicArray::hasValidElements(testArray, 2));
+            }
+        }
+    }
+
+    GIVEN("An empty array of strings")
+    {
+        DynamicArray<std::string> strings;
+
+        WHEN("It is resized")
+        {
+            strings.resize_default_init(3);
+
+            THEN("The new strings should be empty")
+            {
+                REQUIRE(strings.size() == 3);
+                REQUIRE(strings[2].empty());
+            }
+        }
+    }
+}
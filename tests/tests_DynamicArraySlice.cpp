@@ -0,0 +1,462 @@
+#include "catch.hpp"
+#include "../Expression.hpp"
+#include "../Filter.hpp"
+#include "../Gather.hpp"
+#include "../Sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+class SliceCheckError : public std::logic_error
+{
+public:
+    SliceCheckError(const char* condition) : std::logic_error(condition)
+    {
+
+    }
+};
+
+class TestDynamicArraySlice
+{
+public:
+
+    static void throwing(const char* condition, const char*, int)
+    {
+        throw SliceCheckError(condition);
+    }
+
+    static DynamicArray<int> make(size_t size)
+    {
+        DynamicArray<int> array;
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(int(i));
+        }
+        return array;
+    }
+
+    static long total(std::span<const int> elements)
+    {
+        return std::accumulate(elements.begin(), elements.end(), 0L);
+    }
+};
+
+SCENARIO("Testing the slices of the dynamic array")
+{
+    GIVEN("An array of 10 elements")
+    {
+        DynamicArray<int> array = TestDynamicArraySlice::make(10);
+
+        WHEN("A part of it is sliced")
+        {
+            DynamicArraySlice<int> slice = array.slice(2, 5);
+
+            THEN("The slice should borrow the elements")
+            {
+                REQUIRE(slice.size() == 5);
+                REQUIRE(slice.data() == array.data() + 2);
+                REQUIRE(slice.front() == 2);
+                REQUIRE(slice.back() == 6);
+                REQUIRE(slice[4] == 6);
+                REQUIRE(std::equal(slice.begin(), slice.end(), array.begin() + 2));
+            }
+
+            THEN("Writing through the slice should change the array")
+            {
+                slice[0] = 100;
+                std::fill(slice.begin() + 1, slice.end(), -1);
+
+                REQUIRE(array[2] == 100);
+                REQUIRE(array[3] == -1);
+                REQUIRE(array[6] == -1);
+                REQUIRE(array[7] == 7);
+            }
+
+            THEN("It should be sliced again relative to its first element")
+            {
+                DynamicArraySlice<int> inner = slice.slice(1, 3);
+                REQUIRE(inner.size() == 3);
+                REQUIRE(inner[0] == 3);
+                REQUIRE(slice.slice(5, 0).empty());
+            }
+
+            THEN("Parts past the end should be rejected")
+            {
+                REQUIRE_THROWS_AS(slice.slice(3, 3), std::out_of_range);
+                REQUIRE_THROWS_AS(slice.slice(6, 0), std::out_of_range);
+                REQUIRE_THROWS_AS(slice.at(5), std::out_of_range);
+                REQUIRE_THROWS_AS(array.slice(8, 3), std::out_of_range);
+                REQUIRE_THROWS_AS(array.slice(size_t(-1), 2), std::out_of_range);
+                REQUIRE_THROWS_AS(DynamicArraySlice<int>().front(), std::out_of_range);
+            }
+
+            THEN("It should convert to a span and to a read-only slice")
+            {
+                std::span<int> span = slice;
+                DynamicArraySlice<const int> constant = slice;
+
+                REQUIRE(span.data() == slice.data());
+                REQUIRE(span.size() == 5);
+                REQUIRE(constant.data() == slice.data());
+                REQUIRE(TestDynamicArraySlice::total(slice) == 2 + 3 + 4 + 5 + 6);
+            }
+        }
+
+        WHEN("A constant array is sliced")
+        {
+            const DynamicArray<int>& constant = array;
+            DynamicArraySlice<const int> slice = constant.slice();
+
+            THEN("The slice should be read-only and cover the whole array")
+            {
+                REQUIRE(slice.size() == 10);
+                REQUIRE(slice.data() == array.data());
+                REQUIRE(std::is_const<std::remove_reference<decltype(slice[0])>::type>::value);
+            }
+        }
+
+        WHEN("A slice is made of a span")
+        {
+            DynamicArraySlice<int> slice(std::span<int>(array.data() + 5, 5));
+
+            THEN("It should view the same elements")
+            {
+                REQUIRE(slice.size() == 5);
+                REQUIRE(slice[0] == 5);
+                REQUIRE(slice.valid());
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the strided slices and the chunks")
+{
+    GIVEN("A 3x4 matrix stored by rows")
+    {
+        DynamicArray<int> matrix = TestDynamicArraySlice::make(12);
+
+        WHEN("A column is viewed")
+        {
+            StridedSlice<int> column = matrix.strided(1, 3, 4);
+
+            THEN("It should have every fourth element")
+            {
+                REQUIRE(column.size() == 3);
+                REQUIRE(column.stride() == 4);
+                REQUIRE(column[0] == 1);
+                REQUIRE(column[1] == 5);
+                REQUIRE(column[2] == 9);
+                REQUIRE(column.end() - column.begin() == 3);
+                REQUIRE(std::accumulate(column.begin(), column.end(), 0) == 15);
+                REQUIRE_THROWS_AS(column.at(3), std::out_of_range);
+            }
+
+            THEN("Library algorithms should work on it")
+            {
+                std::reverse(column.begin(), column.end());
+                REQUIRE(matrix[1] == 9);
+                REQUIRE(matrix[9] == 1);
+
+                std::sort(column.begin(), column.end());
+                REQUIRE(matrix[1] == 1);
+                REQUIRE(matrix[9] == 9);
+            }
+        }
+
+        THEN("Views past the end should be rejected")
+        {
+            REQUIRE_NOTHROW(matrix.strided(3, 3, 4));
+            REQUIRE_NOTHROW(matrix.strided(12, 0, 4));
+            REQUIRE_THROWS_AS(matrix.strided(4, 3, 4), std::out_of_range);
+            REQUIRE_THROWS_AS(matrix.strided(12, 1, 1), std::out_of_range);
+            REQUIRE_THROWS_AS(matrix.strided(0, 2, 0), std::invalid_argument);
+        }
+
+        WHEN("It is split into chunks of 5")
+        {
+            SliceChunks<int> chunks = matrix.chunks(5);
+
+            THEN("The chunks should cover the array in order")
+            {
+                REQUIRE(chunks.size() == 3);
+                REQUIRE(chunks[0].size() == 5);
+                REQUIRE(chunks[2].size() == 2);
+                REQUIRE(chunks[2][0] == 10);
+
+                size_t next = 0;
+                for(DynamicArraySlice<int> chunk : chunks)
+                {
+                    REQUIRE(chunk.data() == matrix.data() + next);
+                    next += chunk.size();
+                }
+                REQUIRE(next == 12);
+                REQUIRE_THROWS_AS(chunks[3], std::out_of_range);
+            }
+
+            THEN("Chunks of no elements should be rejected")
+            {
+                REQUIRE_THROWS_AS(matrix.chunks(0), std::invalid_argument);
+                REQUIRE(DynamicArray<int>().chunks(4).empty());
+            }
+        }
+    }
+}
+
+SCENARIO("Testing strided slices whose stride doesn't divide the rest of the array")
+{
+    GIVEN("Every third element of an array of 10 elements")
+    {
+        DynamicArray<int> array = TestDynamicArraySlice::make(10);
+        StridedSlice<int> strided = array.strided(0, 4, 3);
+
+        THEN("The iterators should reach the end without leaving the array")
+        {
+            StridedSlice<int>::iterator last = strided.begin() + 3;
+            REQUIRE(*last == 9);
+            REQUIRE(++last == strided.end());
+            REQUIRE(strided.end() - strided.begin() == 4);
+            REQUIRE(*(strided.end() - 1) == 9);
+            REQUIRE(std::accumulate(strided.begin(), strided.end(), 0) == 0 + 3 + 6 + 9);
+            REQUIRE(std::distance(strided.begin(), strided.end()) == 4);
+        }
+
+        THEN("It should be traversed backwards")
+        {
+            std::reverse(strided.begin(), strided.end());
+            REQUIRE(array[0] == 9);
+            REQUIRE(array[3] == 6);
+            REQUIRE(array[9] == 0);
+            REQUIRE(array[1] == 1);
+        }
+    }
+}
+
+SCENARIO("Testing the library algorithms on slices")
+{
+    GIVEN("An array in descending order")
+    {
+        DynamicArray<int> array;
+        for(int i = 0; i < 1000; ++i)
+        {
+            array.push_back(1000 - i);
+        }
+
+        WHEN("The middle is sorted")
+        {
+            sort(array.slice(100, 800));
+
+            THEN("Only the middle should be in order")
+            {
+                REQUIRE(std::is_sorted(array.begin() + 100, array.begin() + 900));
+                REQUIRE(array[100] == 101);
+                REQUIRE(array[0] == 1000);
+                REQUIRE(array[999] == 1);
+            }
+        }
+
+        WHEN("Each chunk is sorted by a merge sort")
+        {
+            for(DynamicArraySlice<int> chunk : array.chunks(300))
+            {
+                parallel_stable_sort(chunk, std::less<int>(), 2);
+            }
+
+            THEN("Every chunk should be in order")
+            {
+                REQUIRE(std::is_sorted(array.begin(), array.begin() + 300));
+                REQUIRE(std::is_sorted(array.begin() + 900, array.end()));
+                REQUIRE(array[0] == 701);
+            }
+        }
+
+        WHEN("Elements are removed from the first half")
+        {
+            size_t kept = remove_if(array.slice(0, 500), [](int value) { return value % 2 == 0; });
+
+            THEN("The kept elements should be moved to the beginning of the half")
+            {
+                REQUIRE(kept == 250);
+                REQUIRE(array[0] == 999);
+                REQUIRE(array[249] == 501);
+                REQUIRE(array[500] == 500);
+            }
+        }
+
+        WHEN("A part of it is filtered and gathered")
+        {
+            DynamicArray<int> filtered;
+            filter_into(array.slice(0, 10), filtered, [](int value) { return value > 995; });
+
+            DynamicArray<uint32_t> indices;
+            indices.push_back(3);
+            indices.push_back(0);
+            DynamicArray<int> gathered;
+            gather(array.slice(990, 10), indices.slice(), gathered);
+
+            THEN("Only the elements of the part should be used")
+            {
+                REQUIRE(filtered.size() == 5);
+                REQUIRE(filtered[4] == 996);
+                REQUIRE(gathered.size() == 2);
+                REQUIRE(gathered[0] == 7);
+                REQUIRE(gathered[1] == 10);
+                REQUIRE_THROWS_AS(gather(array.slice(0, 2), indices.slice(), gathered), std::out_of_range);
+            }
+        }
+
+        WHEN("Expressions of slices are computed into a slice")
+        {
+            DynamicArraySlice<int> low = array.slice(0, 500);
+            DynamicArraySlice<const int> high = static_cast<const DynamicArray<int>&>(array).slice(500, 500);
+            long total = sum(low + high);
+            assign(array.slice(0, 500), low * 2 - high);
+
+            THEN("The elements should be computed pairwise")
+            {
+                REQUIRE(total == 500L * 1001);
+                REQUIRE(array[0] == 2 * 1000 - 500);
+                REQUIRE(array[499] == 2 * 501 - 1);
+                REQUIRE(array[500] == 500);
+                REQUIRE_THROWS_AS(assign(array.slice(0, 10), low + 1), std::invalid_argument);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing expressions of overlapping slices")
+{
+    GIVEN("An array of zeros")
+    {
+        DynamicArray<double> array;
+        array.resize(64, 0.0);
+
+        WHEN("A slice is computed from the slice one element before it")
+        {
+            assign(array.slice(1, 63), array.slice(0, 63) + 1.0);
+
+            THEN("Every element should be computed from the elements before the assignment")
+            {
+                REQUIRE(array[0] == 0.0);
+                REQUIRE(std::all_of(array.begin() + 1, array.end(), [](double value) { return value == 1.0; }));
+            }
+        }
+
+        WHEN("A slice is computed from the slice one element after it")
+        {
+            for(size_t i = 0; i < 64; ++i)
+            {
+                array[i] = double(i);
+            }
+            assign(array.slice(0, 63), array.slice(1, 63) * 2.0 - array.slice(0, 63));
+
+            THEN("Every element should be computed from the elements before the assignment")
+            {
+                for(size_t i = 0; i < 63; ++i)
+                {
+                    REQUIRE(array[i] == double(i + 2));
+                }
+                REQUIRE(array[63] == 63.0);
+            }
+        }
+    }
+
+    GIVEN("A large array")
+    {
+        DynamicArray<int64_t> array;
+        for(int64_t i = 0; i < (1 << 18); ++i)
+        {
+            array.push_back(i);
+        }
+
+        WHEN("It is shifted by a parallel assignment")
+        {
+            parallel_assign(array.slice(1, array.size() - 1), array.slice(0, array.size() - 1) * 1, 4);
+
+            THEN("Every element should be the one before it")
+            {
+                bool shifted = array[0] == 0;
+                for(size_t i = 1; i < array.size(); ++i)
+                {
+                    shifted &= array[i] == int64_t(i - 1);
+                }
+                REQUIRE(shifted);
+            }
+        }
+    }
+}
+
+#if DYNAMIC_ARRAY_HARDENING >= 2
+
+SCENARIO("Testing the invalidation of the slices")
+{
+    HardeningHandler previous = set_hardening_handler(TestDynamicArraySlice::throwing);
+
+    GIVEN("An array and slices of it")
+    {
+        DynamicArray<int> array = TestDynamicArraySlice::make(4);
+        DynamicArraySlice<int> slice = array.slice(1, 2);
+        StridedSlice<int> strided = array.strided(0, 2, 2);
+        SliceChunks<int> chunks = array.chunks(2);
+
+        WHEN("The array grows")
+        {
+            array.reserve(1000);
+
+            THEN("Using the slices should fail the check")
+            {
+                REQUIRE_FALSE(slice.valid());
+                REQUIRE_THROWS_AS(slice[0], SliceCheckError);
+                REQUIRE_THROWS_AS(slice.begin(), SliceCheckError);
+                REQUIRE_THROWS_AS(slice.slice(0, 1), SliceCheckError);
+                REQUIRE_THROWS_AS(std::span<int>(slice), SliceCheckError);
+                REQUIRE_THROWS_AS(strided[1], SliceCheckError);
+                REQUIRE_THROWS_AS(chunks[0], SliceCheckError);
+                REQUIRE_THROWS_AS(sort(slice), SliceCheckError);
+            }
+
+            THEN("New slices should be valid")
+            {
+                REQUIRE(array.slice(1, 2)[0] == 1);
+            }
+        }
+
+        WHEN("The array is cleared")
+        {
+            array.clear();
+
+            THEN("Using the slices should fail the check")
+            {
+                REQUIRE_THROWS_AS(slice.data(), SliceCheckError);
+            }
+        }
+
+        WHEN("Elements are written without reallocating")
+        {
+            array[1] = 7;
+
+            THEN("The slices should stay valid")
+            {
+                REQUIRE(slice.valid());
+                REQUIRE(slice[0] == 7);
+            }
+        }
+    }
+
+    GIVEN("A slice")
+    {
+        DynamicArray<int> array = TestDynamicArraySlice::make(4);
+        DynamicArraySlice<int> slice = array.slice(0, 2);
+
+        THEN("Accessing elements past its size should fail the check")
+        {
+            REQUIRE_THROWS_AS(slice[2], SliceCheckError);
+        }
+    }
+
+    set_hardening_handler(previous);
+}
+
+#endif
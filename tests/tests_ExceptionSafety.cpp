@@ -0,0 +1,462 @@
+#include "catch.hpp"
+#include "../DynamicArray.hpp"
+
+#include <new>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Element type that counts its live objects, detects destruction of dead objects and
+ * throws from its copy operations once a countdown of copies reaches zero.
+ */
+class Counted
+{
+public:
+    static long live;
+    static long doubleDestructions;
+    static long copiesUntilThrow;   ///negative means that copies never throw
+
+private:
+    static const unsigned ALIVE = 0xC0FFEE;
+
+    unsigned state;
+    int value;
+
+private:
+    static void copying()
+    {
+        if(copiesUntilThrow == 0)
+            throw std::runtime_error("Injected copy failure");
+        if(copiesUntilThrow > 0)
+            --copiesUntilThrow;
+    }
+
+public:
+    Counted(int value = 0) : state(ALIVE), value(value)
+    {
+        ++live;
+    }
+
+    Counted(const Counted& other) : state(0), value(other.value)
+    {
+        copying();
+        state = ALIVE;
+        ++live;
+    }
+
+    Counted& operator=(const Counted& other)
+    {
+        copying();
+        value = other.value;
+        return *this;
+    }
+
+    ~Counted()
+    {
+        if(state != ALIVE)
+            ++doubleDestructions;
+        state = 0;
+        --live;
+    }
+
+    int get()const
+    {
+        return value;
+    }
+};
+
+long Counted::live = 0;
+long Counted::doubleDestructions = 0;
+long Counted::copiesUntilThrow = -1;
+
+/**
+ * Allocator that throws std::bad_alloc on a chosen allocation and counts the bytes it hands out.
+ */
+class FailingAllocator
+{
+public:
+    static long allocationsUntilFailure;    ///negative means that allocations never fail
+    static long outstanding;
+
+public:
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        if(allocationsUntilFailure == 0)
+            throw std::bad_alloc();
+        if(allocationsUntilFailure > 0)
+            --allocationsUntilFailure;
+
+        outstanding += bytes;
+        return HeapAllocator().allocate(bytes, alignment);
+    }
+
+    void deallocate(void* pointer, size_t bytes, size_t alignment)
+    {
+        outstanding -= bytes;
+        HeapAllocator().deallocate(pointer, bytes, alignment);
+    }
+};
+
+long FailingAllocator::allocationsUntilFailure = -1;
+long FailingAllocator::outstanding = 0;
+
+typedef DynamicArray<Counted, FailingAllocator> Array;
+
+class TestExceptionSafety
+{
+public:
+
+    static void reset()
+    {
+        Counted::live = 0;
+        Counted::doubleDestructions = 0;
+        Counted::copiesUntilThrow = -1;
+        FailingAllocator::allocationsUntilFailure = -1;
+        FailingAllocator::outstanding = 0;
+    }
+
+    static void fill(Array& array, size_t count)
+    {
+        for(size_t i = 0; i < count; ++i)
+        {
+            array.push_back(Counted(int(i)));
+        }
+    }
+
+    static bool hasValues(const Array& array, size_t count)
+    {
+        if(array.size() != count)
+            return false;
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(array[i].get() != int(i))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Runs an operation with a copy failure injected after every possible number of copies and
+     * checks the strong guarantee - the array keeps its elements whenever the operation throws
+     * and nothing created by the operation outlives it.
+     */
+    template <class Operation>
+    static bool keepsStateOnCopyFailure(size_t count, Operation operation)
+    {
+        long live = Counted::live;
+        long outstanding = FailingAllocator::outstanding;
+
+        for(long failAt = 0; ; ++failAt)
+        {
+            bool thrown = false;
+            {
+                Array array;
+                fill(array, count);
+
+                Counted::copiesUntilThrow = failAt;
+                try
+                {
+                    operation(array);
+                }
+                catch(const std::runtime_error&)
+                {
+                    thrown = true;
+                }
+                Counted::copiesUntilThrow = -1;
+
+                if(thrown && !hasValues(array, count))
+                    return false;
+            }
+
+            if(Counted::live != live || Counted::doubleDestructions != 0 || FailingAllocator::outstanding != outstanding)
+                return false;
+            if(!thrown)
+                return true;
+        }
+    }
+
+    /**
+     * Runs an operation with an allocation failure injected at every possible allocation and
+     * checks the strong guarantee.
+     */
+    template <class Operation>
+    static bool keepsStateOnAllocationFailure(size_t count, Operation operation)
+    {
+        long live = Counted::live;
+        long outstanding = FailingAllocator::outstanding;
+
+        for(long failAt = 0; ; ++failAt)
+        {
+            bool thrown = false;
+            {
+                Array array;
+                fill(array, count);
+
+                FailingAllocator::allocationsUntilFailure = failAt;
+                try
+                {
+                    operation(array);
+                }
+                catch(const std::bad_alloc&)
+                {
+                    thrown = true;
+                }
+                FailingAllocator::allocationsUntilFailure = -1;
+
+                if(thrown && !hasValues(array, count))
+                    return false;
+            }
+
+            if(Counted::live != live || Counted::doubleDestructions != 0 || FailingAllocator::outstanding != outstanding)
+                return false;
+            if(!thrown)
+                return true;
+        }
+    }
+};
+
+SCENARIO("Testing the exception safety of the buffer")
+{
+    TestExceptionSafety::reset();
+
+    GIVEN("A buffer whose element copies fail midway")
+    {
+        Buffer<Counted, FailingAllocator> origin(10);
+        Counted::copiesUntilThrow = 5;
+
+        THEN("Copying it should throw and release everything it constructed")
+        {
+            REQUIRE_THROWS_AS((Buffer<Counted, FailingAllocator>(20, origin)), std::runtime_error);
+            REQUIRE(Counted::live == 10);
+            REQUIRE(Counted::doubleDestructions == 0);
+            REQUIRE(FailingAllocator::outstanding == 10 * sizeof(Counted));
+        }
+    }
+
+    GIVEN("An allocator that fails on the first allocation")
+    {
+        FailingAllocator::allocationsUntilFailure = 0;
+
+        THEN("Constructing a buffer should throw without constructing elements")
+        {
+            REQUIRE_THROWS_AS((Buffer<Counted, FailingAllocator>(10)), std::bad_alloc);
+            REQUIRE(Counted::live == 0);
+        }
+    }
+
+    GIVEN("A buffer too large to be allocated")
+    {
+        THEN("Its construction should throw")
+        {
+            REQUIRE_THROWS_AS((Buffer<Counted, FailingAllocator>(size_t(-1) / 2)), std::bad_array_new_length);
+        }
+    }
+
+    TestExceptionSafety::reset();
+}
+
+SCENARIO("Testing the strong guarantee of the dynamic array")
+{
+    TestExceptionSafety::reset();
+
+    GIVEN("Element copies failing at every possible point")
+    {
+        THEN("push_back into a full array should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(8, [](Array& array) { array.push_back(Counted(100)); }));
+        }
+
+        THEN("push_back with spare capacity should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(5, [](Array& array) { array.push_back(Counted(100)); }));
+        }
+
+        THEN("reserve should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(7, [](Array& array) { array.reserve(64); }));
+        }
+
+        THEN("Copy assignment should keep the elements")
+        {
+            Array other;
+            TestExceptionSafety::fill(other, 20);
+
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(7, [&other](Array& array) { array = other; }));
+        }
+
+        THEN("append and append_n should keep the elements")
+        {
+            Array other;
+            TestExceptionSafety::fill(other, 20);
+
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(7, [&other](Array& array) { array.append(other.data(), 20); }));
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(5, [&other](Array& array) { array.append(other.data(), 3); }));
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(7, [](Array& array) { array.append_n(30, Counted(100)); }));
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(5, [](Array& array) { array.append_n(2, array[0]); }));
+        }
+
+        THEN("append_uninitialized and resize_default_init should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(7, [](Array& array) { array.append_uninitialized(30); }));
+            CHECK(TestExceptionSafety::keepsStateOnCopyFailure(7, [](Array& array) { array.resize_default_init(40); }));
+        }
+    }
+
+    GIVEN("Allocations failing at every possible point")
+    {
+        THEN("push_back into a full array should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(8, [](Array& array) { array.push_back(Counted(100)); }));
+        }
+
+        THEN("reserve should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [](Array& array) { array.reserve(64); }));
+        }
+
+        THEN("Copy assignment should keep the elements")
+        {
+            Array other;
+            TestExceptionSafety::fill(other, 20);
+
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [&other](Array& array) { array = other; }));
+        }
+
+        THEN("append and append_n should keep the elements")
+        {
+            Array other;
+            TestExceptionSafety::fill(other, 20);
+
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [&other](Array& array) { array.append(other.data(), 20); }));
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [](Array& array) { array.append(array.data(), 7); }));
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [](Array& array) { array.append_n(30, Counted(100)); }));
+        }
+
+        THEN("append_uninitialized and resize_default_init should keep the elements")
+        {
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [](Array& array) { array.append_uninitialized(30); }));
+            CHECK(TestExceptionSafety::keepsStateOnAllocationFailure(7, [](Array& array) { array.resize_default_init(40); }));
+        }
+    }
+
+    GIVEN("An array whose copy fails midway")
+    {
+        Array origin;
+        TestExceptionSafety::fill(origin, 10);
+        Counted::copiesUntilThrow = 3;
+
+        THEN("The copy constructor should throw and release everything it constructed")
+        {
+            REQUIRE_THROWS_AS(Array(origin), std::runtime_error);
+            Counted::copiesUntilThrow = -1;
+
+            REQUIRE(TestExceptionSafety::hasValues(origin, 10));
+            REQUIRE(Counted::live == long(origin.capacity()));
+        }
+    }
+
+    GIVEN("An array pushing its own element while growing")
+    {
+        DynamicArray<std::string> strings;
+        for(size_t i = 0; i < 4; ++i)
+        {
+            strings.push_back(std::string(50, char('a' + i)));
+        }
+
+        strings.push_back(strings[0]);
+
+        THEN("The pushed element should be a valid copy")
+        {
+            REQUIRE(strings.size() == 5);
+            REQUIRE(strings[4] == std::string(50, 'a'));
+        }
+    }
+
+    TestExceptionSafety::reset();
+}
+
+SCENARIO("Testing the basic guarantee of the dynamic array")
+{
+    TestExceptionSafety::reset();
+
+    GIVEN("An array being resized while copies fail")
+    {
+        {
+            Array array;
+            TestExceptionSafety::fill(array, 4);
+            Counted::copiesUntilThrow = 10;
+
+            REQUIRE_THROWS_AS(array.resize(32, Counted(7)), std::runtime_error);
+            Counted::copiesUntilThrow = -1;
+
+            THEN("The array should keep its old elements and stay usable")
+            {
+                REQUIRE(array.size() >= 4);
+                REQUIRE(array.size() <= 32);
+                for(size_t i = 0; i < 4; ++i)
+                {
+                    REQUIRE(array[i].get() == int(i));
+                }
+
+                array.push_back(Counted(1));
+                REQUIRE(array.back().get() == 1);
+            }
+        }
+
+        THEN("Nothing should leak or be destroyed twice")
+        {
+            REQUIRE(Counted::live == 0);
+            REQUIRE(Counted::doubleDestructions == 0);
+            REQUIRE(FailingAllocator::outstanding == 0);
+        }
+    }
+
+    GIVEN("An array being cleared while the resets of the elements fail")
+    {
+        {
+            Array array;
+            TestExceptionSafety::fill(array, 10);
+            Counted::copiesUntilThrow = 3;
+
+            REQUIRE_THROWS_AS(array.clear(), std::runtime_error);
+            Counted::copiesUntilThrow = -1;
+
+            THEN("The array should keep only the elements that weren't reset")
+            {
+                REQUIRE(TestExceptionSafety::hasValues(array, 7));
+
+                array.clear();
+                REQUIRE(array.empty());
+            }
+        }
+
+        THEN("Nothing should leak or be destroyed twice")
+        {
+            REQUIRE(Counted::live == 0);
+            REQUIRE(Counted::doubleDestructions == 0);
+            REQUIRE(FailingAllocator::outstanding == 0);
+        }
+    }
+
+    GIVEN("An array being cleared and released")
+    {
+        {
+            Array array;
+            TestExceptionSafety::fill(array, 10);
+            array.clear();
+            TestExceptionSafety::fill(array, 3);
+            array.release();
+            TestExceptionSafety::fill(array, 3);
+        }
+
+        THEN("Nothing should leak or be destroyed twice")
+        {
+            REQUIRE(Counted::live == 0);
+            REQUIRE(Counted::doubleDestructions == 0);
+            REQUIRE(FailingAllocator::outstanding == 0);
+        }
+    }
+
+    TestExceptionSafety::reset();
+}
@@ -0,0 +1,193 @@
+#include "catch.hpp"
+#include "../Allocator.hpp"
+#include "../Expression.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+class TestExpression
+{
+public:
+
+    static DynamicArray<double> makeArray(size_t size, double first, double step)
+    {
+        DynamicArray<double> array;
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(first + step * double(i));
+        }
+        return array;
+    }
+};
+
+SCENARIO("Testing element-wise expressions")
+{
+    GIVEN("Arrays of numbers")
+    {
+        DynamicArray<double> a = TestExpression::makeArray(1000, 1, 0.5);
+        DynamicArray<double> x = TestExpression::makeArray(1000, -250, 0.5);
+        DynamicArray<double> c = TestExpression::makeArray(1000, 3, 0);
+
+        WHEN("An arithmetic expression is converted into an array")
+        {
+            DynamicArray<double> y = a * x + 2.0 - c / 2 + -a;
+
+            THEN("Every element should be computed like in a hand loop")
+            {
+                REQUIRE(y.size() == 1000);
+                for(size_t i = 0; i < 1000; ++i)
+                {
+                    REQUIRE(y[i] == a[i] * x[i] + 2.0 - c[i] / 2 + -a[i]);
+                }
+            }
+        }
+
+        WHEN("An expression is assigned to one of its arrays")
+        {
+            const double* storage = a.data();
+            assign(a, a * 2.0 + 1.0);
+
+            THEN("The elements should be replaced in the same storage")
+            {
+                REQUIRE(a.data() == storage);
+                REQUIRE(a[0] == 3.0);
+                REQUIRE(a[999] == (1 + 0.5 * 999) * 2 + 1);
+            }
+        }
+
+        WHEN("An expression is assigned to a larger array")
+        {
+            DynamicArray<double> out = TestExpression::makeArray(5000, 0, 1);
+            size_t capacity = out.capacity();
+            assign(out, abs(x));
+
+            THEN("The array should be shrunk to the size of the expression without reallocation")
+            {
+                REQUIRE(out.size() == 1000);
+                REQUIRE(out.capacity() == capacity);
+                REQUIRE(out[0] == 250.0);
+                REQUIRE(out[999] == std::abs(x[999]));
+            }
+        }
+
+        THEN("Comparisons and selections should work element-wise")
+        {
+            DynamicArray<bool> positive = x > 0.0;
+            REQUIRE(positive[500] == false);
+            REQUIRE(positive[501] == true);
+
+            DynamicArray<double> clipped = select(x < 0.0, 0.0, min(x, 100.0));
+            REQUIRE(clipped[0] == 0.0);
+            REQUIRE(clipped[600] == 50.0);
+            REQUIRE(clipped[999] == 100.0);
+
+            DynamicArray<double> roots = sqrt(max(x, 0.0));
+            REQUIRE(roots[532] == 4.0);
+
+            REQUIRE(count_nonzero(x >= 0.0) == 500);
+            REQUIRE(count_nonzero(equal(x, 0.0)) == 1);
+            REQUIRE(count_nonzero(not_equal(c, 3.0)) == 0);
+            REQUIRE(count_nonzero(x <= -250.0) == 1);
+        }
+
+        THEN("Reductions should not need an array")
+        {
+            REQUIRE(sum(c) == 3000.0);
+            REQUIRE(sum(a - a) == 0.0);
+            REQUIRE(sum(x * 2.0) == Approx(2 * (-250 * 1000 + 0.5 * 999 * 500)));
+            REQUIRE(min_of(x) == -250.0);
+            REQUIRE(max_of(x * -1.0) == 250.0);
+            REQUIRE(max_of(a) == 1 + 0.5 * 999);
+            REQUIRE(sum(x > 0.0) == 499);
+        }
+
+        THEN("A parallel assignment should give the same result")
+        {
+            DynamicArray<double> large = TestExpression::makeArray(1 << 18, 0, 1);
+            DynamicArray<double> serial;
+            DynamicArray<double> parallel;
+            assign(serial, large * large - 1.0);
+            parallel_assign(parallel, large * large - 1.0, 4);
+
+            REQUIRE(parallel.size() == serial.size());
+            REQUIRE(count_nonzero(not_equal(parallel, serial)) == 0);
+
+            parallel_assign(a, a + 1.0, 4);
+            REQUIRE(a[0] == 2.0);
+        }
+    }
+
+    GIVEN("Arrays of different sizes")
+    {
+        DynamicArray<double> a = TestExpression::makeArray(10, 0, 1);
+        DynamicArray<double> b = TestExpression::makeArray(11, 0, 1);
+
+        THEN("Building an expression should throw")
+        {
+            REQUIRE_THROWS_AS(a + b, std::invalid_argument);
+            REQUIRE_THROWS_AS(select(a > 1.0, a, b), std::invalid_argument);
+        }
+    }
+
+    GIVEN("Empty arrays")
+    {
+        DynamicArray<double> empty;
+
+        THEN("The expressions should be empty")
+        {
+            DynamicArray<double> result = empty * 2.0;
+            REQUIRE(result.empty());
+            REQUIRE(sum(empty) == 0.0);
+            REQUIRE_THROWS_AS(min_of(empty), std::out_of_range);
+            REQUIRE_THROWS_AS(max_of(empty + 1.0), std::out_of_range);
+        }
+    }
+
+    GIVEN("Arrays of integers")
+    {
+        DynamicArray<int> values;
+        for(int i = -5; i < 5; ++i)
+        {
+            values.push_back(i);
+        }
+
+        THEN("The operations should keep the type of the elements")
+        {
+            DynamicArray<int> squares = values * values;
+            REQUIRE(squares[0] == 25);
+            REQUIRE(sum(values) == -5);
+            REQUIRE(sum(values / 2) == -2);
+            REQUIRE(count_nonzero(values) == 9);
+        }
+    }
+}
+
+SCENARIO("Testing expressions of arrays with other allocators")
+{
+    GIVEN("Arrays with pool allocators")
+    {
+        DynamicArray<double, ThreadLocalPoolAllocator> x;
+        DynamicArray<double, GlobalPoolAllocator> y;
+        for(int i = 0; i < (1 << 17); ++i)
+        {
+            x.push_back(i);
+            y.push_back(2.0);
+        }
+
+        WHEN("Expressions of them are computed into them")
+        {
+            DynamicArray<double, GlobalPoolAllocator> product = x * y;
+            assign(y, x + y);
+            parallel_assign(x, x * 3.0, 2);
+
+            THEN("They should be computed like arrays of the default allocator")
+            {
+                REQUIRE(product[10] == 20.0);
+                REQUIRE(y[10] == 12.0);
+                REQUIRE(x[10] == 30.0);
+                REQUIRE(x[(1 << 17) - 1] == 3.0 * ((1 << 17) - 1));
+                REQUIRE(sum(x - x) == 0.0);
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include "catch.hpp"
+#include "../EytzingerIndex.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+class TestEytzingerIndex
+{
+public:
+
+    static DynamicArray<uint64_t> sortedArray(size_t size, uint64_t range)
+    {
+        std::mt19937_64 generator(size);
+
+        DynamicArray<uint64_t> array(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(generator() % range);
+        }
+        std::sort(array.begin(), array.end());
+        return array;
+    }
+};
+
+SCENARIO("Testing searching in an Eytzinger index")
+{
+    GIVEN("Sorted arrays with different sizes")
+    {
+        size_t size = GENERATE(0, 1, 2, 3, 7, 8, 100, 1023, 1024, 5000);
+
+        DynamicArray<uint64_t> sorted = TestEytzingerIndex::sortedArray(size, 3 * size + 1);
+        EytzingerIndex<uint64_t> index(sorted);
+
+        THEN("The size should be valid")
+        {
+            REQUIRE(index.size() == size);
+        }
+
+        THEN("Every element should be accessible by its index in the sorted array")
+        {
+            for(size_t i = 0; i < size; ++i)
+            {
+                if(index.at(i) != sorted[i])
+                    CHECK(false);
+            }
+            REQUIRE_THROWS_AS(index.at(size), std::out_of_range);
+        }
+
+        THEN("Lower bound should return the same index as std::lower_bound")
+        {
+            for(uint64_t key = 0; key <= 3 * size + 2; ++key)
+            {
+                size_t expected = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+                if(index.lower_bound(key) != expected)
+                    CHECK(false);
+            }
+            CHECK(true);
+        }
+
+        THEN("Find should return the first equal element or size()")
+        {
+            for(uint64_t key = 0; key <= 3 * size + 2; ++key)
+            {
+                DynamicArray<uint64_t>::const_iterator position = std::lower_bound(sorted.begin(), sorted.end(), key);
+                bool found = position != sorted.end() && *position == key;
+                size_t expected = found ? position - sorted.begin() : size;
+
+                if(index.find(key) != expected || index.contains(key) != found)
+                    CHECK(false);
+            }
+            CHECK(true);
+        }
+
+        WHEN("Many keys are searched at once")
+        {
+            DynamicArray<uint64_t> keys;
+            for(uint64_t key = 0; key <= 3 * size + 2; key += 2)
+            {
+                keys.push_back(key);
+            }
+
+            DynamicArray<size_t> results;
+            index.lower_bound(keys, results);
+
+            THEN("Every result should be equal to the result of a single search")
+            {
+                REQUIRE(results.size() == keys.size());
+                for(size_t i = 0; i < keys.size(); ++i)
+                {
+                    if(results[i] != index.lower_bound(keys[i]))
+                        CHECK(false);
+                }
+                CHECK(true);
+            }
+        }
+    }
+}
@@ -0,0 +1,199 @@
+#include "catch.hpp"
+#include "../Allocator.hpp"
+#include "../FileLoader.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <new>
+#include <span>
+#include <string>
+
+class TestFileLoader
+{
+public:
+
+    static std::string path(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / (std::string("tests_FileLoader_") + name)).string();
+    }
+
+    template <class Type>
+    static std::string write(const char* name, size_t count)
+    {
+        std::string file = path(name);
+        std::FILE* stream = std::fopen(file.c_str(), "wb");
+        for(size_t i = 0; i < count; ++i)
+        {
+            Type value = Type(i * 7 + 1);
+            std::fwrite(&value, sizeof(Type), 1, stream);
+        }
+        std::fclose(stream);
+        return file;
+    }
+
+    template <class Type, class Allocator>
+    static bool hasFileElements(const DynamicArray<Type, Allocator>& array, size_t offset, size_t count)
+    {
+        if(array.size() != offset + count)
+            return false;
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(array[offset + i] != Type(i * 7 + 1))
+                return false;
+        }
+        return true;
+    }
+
+    struct ThrowingDecode
+    {
+        ThrowingDecode() = default;
+        ThrowingDecode(const ThrowingDecode&) = default;
+        ThrowingDecode(ThrowingDecode&&)
+        {
+            throw std::bad_alloc();
+        }
+
+        void operator()(std::span<uint32_t>, size_t)const
+        {
+
+        }
+    };
+};
+
+SCENARIO("Testing the file loader")
+{
+    GIVEN("Files with elements and a loader with small chunks")
+    {
+        std::string integers = TestFileLoader::write<uint32_t>("integers", 100003);
+        std::string doubles = TestFileLoader::write<double>("doubles", 5000);
+        FileLoader loader(3, 4096);
+
+        WHEN("The files are loaded at once")
+        {
+            DynamicArray<uint32_t> first;
+            first.push_back(5);
+            DynamicArray<double> second;
+
+            std::future<size_t> loadedFirst = loader.load(integers, first);
+            std::future<size_t> loadedSecond = loader.load(doubles, second);
+
+            THEN("The elements should be appended to the arrays")
+            {
+                REQUIRE(loadedFirst.get() == 100003);
+                REQUIRE(loadedSecond.get() == 5000);
+                REQUIRE(first[0] == 5);
+                CHECK(TestFileLoader::hasFileElements(first, 1, 100003));
+                CHECK(TestFileLoader::hasFileElements(second, 0, 5000));
+            }
+        }
+
+        WHEN("A file is loaded with a decode callback")
+        {
+            DynamicArray<uint32_t> array;
+            std::atomic<size_t> decoded(0);
+            std::atomic<size_t> chunks(0);
+
+            std::future<size_t> loaded = loader.load(integers, array, [&](std::span<uint32_t> chunk, size_t first)
+            {
+                for(size_t i = 0; i < chunk.size(); ++i)
+                {
+                    if(chunk[i] == uint32_t((first + i) * 7 + 1))
+                        ++decoded;
+                    chunk[i] += 1;
+                }
+                ++chunks;
+            });
+
+            THEN("The callback should see every element once and can modify it")
+            {
+                REQUIRE(loaded.get() == 100003);
+                REQUIRE(decoded == 100003);
+                REQUIRE(chunks == (100003 * 4 + 4095) / 4096);
+                REQUIRE(array[100002] == 100002 * 7 + 2);
+            }
+        }
+
+        WHEN("The decode callback throws")
+        {
+            DynamicArray<uint32_t> array;
+            std::future<size_t> loaded = loader.load(integers, array, [](std::span<uint32_t>, size_t first)
+            {
+                if(first > 0)
+                    throw std::runtime_error("Decoding failed");
+            });
+
+            THEN("The future should report the error and the array should stay grown")
+            {
+                REQUIRE_THROWS_AS(loaded.get(), std::runtime_error);
+                REQUIRE(array.size() == 100003);
+            }
+        }
+
+        WHEN("A file is loaded into an array with another allocator")
+        {
+            DynamicArray<double, GlobalPoolAllocator> array;
+            size_t loaded = loader.load(doubles, array).get();
+
+            THEN("The elements should be appended to it")
+            {
+                REQUIRE(loaded == 5000);
+                REQUIRE(TestFileLoader::hasFileElements(array, 0, 5000));
+            }
+        }
+
+        WHEN("The load can't be started")
+        {
+            DynamicArray<uint32_t> array;
+            array.push_back(5);
+            TestFileLoader::ThrowingDecode decode;
+
+            THEN("The array should keep its size")
+            {
+                REQUIRE_THROWS_AS(loader.load(integers, array, decode), std::bad_alloc);
+                REQUIRE(array.size() == 1);
+                REQUIRE(array[0] == 5);
+            }
+        }
+
+        std::remove(integers.c_str());
+        std::remove(doubles.c_str());
+    }
+
+    GIVEN("An empty file and a file with a partial element")
+    {
+        std::string empty = TestFileLoader::write<uint32_t>("empty", 0);
+        std::string partial = TestFileLoader::write<uint8_t>("partial", 10);
+        FileLoader loader(1);
+
+        THEN("The empty file should load no elements")
+        {
+            DynamicArray<uint32_t> array;
+            REQUIRE(loader.load(empty, array).get() == 0);
+            REQUIRE(array.empty());
+        }
+
+        THEN("The partial element should be rejected without changing the array")
+        {
+            DynamicArray<uint64_t> array;
+            REQUIRE_THROWS_AS(loader.load(partial, array), std::invalid_argument);
+            REQUIRE(array.empty());
+        }
+
+        std::remove(empty.c_str());
+        std::remove(partial.c_str());
+    }
+
+    GIVEN("A missing file")
+    {
+        FileLoader loader(1);
+        DynamicArray<int> array;
+
+        THEN("Loading it should throw")
+        {
+            REQUIRE_THROWS_AS(loader.load(TestFileLoader::path("missing"), array), std::system_error);
+        }
+    }
+}
@@ -0,0 +1,275 @@
+#include "catch.hpp"
+#include "../Allocator.hpp"
+#include "../Filter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+class TestFilter
+{
+public:
+
+    template <class Type>
+    static DynamicArray<Type> makeArray(size_t size)
+    {
+        std::mt19937_64 generator(size);
+        DynamicArray<Type> array;
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(Type(generator() % 1000));
+        }
+        return array;
+    }
+
+    template <class Type>
+    static std::vector<Type> toVector(const DynamicArray<Type>& array)
+    {
+        return std::vector<Type>(array.data(), array.data() + array.size());
+    }
+
+    template <class Type, class Predicate>
+    static bool erasesLikeStd(size_t size, Predicate predicate)
+    {
+        DynamicArray<Type> array = makeArray<Type>(size);
+        std::vector<Type> expected = toVector(array);
+        expected.erase(std::remove_if(expected.begin(), expected.end(), predicate), expected.end());
+
+        size_t erased = erase_if(array, predicate);
+        return erased == size - expected.size() && toVector(array) == expected;
+    }
+
+    template <class Type, class Predicate>
+    static bool filtersLikeStd(size_t size, Predicate predicate)
+    {
+        DynamicArray<Type> source = makeArray<Type>(size);
+        std::vector<Type> expected(1, Type(7));
+        std::copy_if(source.data(), source.data() + source.size(), std::back_inserter(expected), predicate);
+
+        DynamicArray<Type> out;
+        out.push_back(Type(7));
+        size_t appended = filter_into(source, out, predicate);
+        return appended == expected.size() - 1 && toVector(out) == expected;
+    }
+
+    template <class Type, class Predicate>
+    static bool erasesInParallelLikeStd(size_t size, size_t threads, Predicate predicate)
+    {
+        DynamicArray<Type> array = makeArray<Type>(size);
+        std::vector<Type> expected = toVector(array);
+        expected.erase(std::remove_if(expected.begin(), expected.end(), predicate), expected.end());
+
+        size_t erased = parallel_erase_if(array, predicate, threads);
+        return erased == size - expected.size() && toVector(array) == expected;
+    }
+};
+
+SCENARIO("Testing erase_if")
+{
+    GIVEN("Arrays of different types and sizes")
+    {
+        auto odd = [](auto value) { return int64_t(value) % 2 != 0; };
+        auto small = [](auto value) { return value < 100; };
+
+        THEN("Erase_if should keep the same elements as std::remove_if")
+        {
+            for(size_t size : {0, 1, 7, 8, 15, 16, 17, 100, 1003})
+            {
+                CHECK(TestFilter::erasesLikeStd<int32_t>(size, odd));
+                CHECK(TestFilter::erasesLikeStd<uint32_t>(size, small));
+                CHECK(TestFilter::erasesLikeStd<float>(size, small));
+                CHECK(TestFilter::erasesLikeStd<int64_t>(size, odd));
+                CHECK(TestFilter::erasesLikeStd<double>(size, small));
+                CHECK(TestFilter::erasesLikeStd<int16_t>(size, odd));
+            }
+        }
+
+        THEN("Erasing nothing or everything should work")
+        {
+            CHECK(TestFilter::erasesLikeStd<int32_t>(1000, [](int32_t) { return false; }));
+            CHECK(TestFilter::erasesLikeStd<int32_t>(1000, [](int32_t) { return true; }));
+            CHECK(TestFilter::erasesLikeStd<uint64_t>(1000, [](uint64_t) { return true; }));
+        }
+    }
+
+    GIVEN("An array of strings")
+    {
+        DynamicArray<std::string> array;
+        for(size_t i = 0; i < 100; ++i)
+        {
+            array.push_back(std::to_string(i));
+        }
+
+        WHEN("The strings with one character are erased")
+        {
+            size_t erased = erase_if(array, [](const std::string& value) { return value.size() == 1; });
+
+            THEN("The rest should be kept in order")
+            {
+                REQUIRE(erased == 10);
+                REQUIRE(array.size() == 90);
+                for(size_t i = 0; i < 90; ++i)
+                {
+                    REQUIRE(array[i] == std::to_string(i + 10));
+                }
+            }
+        }
+
+        WHEN("The even numbers are removed")
+        {
+            size_t kept = remove_if(array, [](const std::string& value) { return (value.back() - '0') % 2 == 0; });
+
+            THEN("The odd ones should be moved to the beginning without changing the size")
+            {
+                REQUIRE(kept == 50);
+                REQUIRE(array.size() == 100);
+                for(size_t i = 0; i < 50; ++i)
+                {
+                    REQUIRE(array[i] == std::to_string(2 * i + 1));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Testing filter_into")
+{
+    GIVEN("Arrays of different types and sizes")
+    {
+        auto even = [](auto value) { return int64_t(value) % 2 == 0; };
+
+        THEN("Filter_into should append the same elements as std::copy_if")
+        {
+            for(size_t size : {0, 1, 8, 16, 33, 1003})
+            {
+                CHECK(TestFilter::filtersLikeStd<int32_t>(size, even));
+                CHECK(TestFilter::filtersLikeStd<double>(size, even));
+                CHECK(TestFilter::filtersLikeStd<uint64_t>(size, even));
+                CHECK(TestFilter::filtersLikeStd<uint8_t>(size, even));
+            }
+        }
+    }
+
+    GIVEN("An array of strings")
+    {
+        DynamicArray<std::string> source;
+        for(size_t i = 0; i < 30; ++i)
+        {
+            source.push_back(std::to_string(i));
+        }
+
+        WHEN("The strings with two characters are filtered")
+        {
+            DynamicArray<std::string> out;
+            filter_into(source, out, [](const std::string& value) { return value.size() == 2; });
+
+            THEN("The source should be unchanged and the out should have copies")
+            {
+                REQUIRE(source.size() == 30);
+                REQUIRE(out.size() == 20);
+                REQUIRE(out[0] == "10");
+                REQUIRE(out[19] == "29");
+            }
+        }
+
+        WHEN("The strings are filtered into the same array")
+        {
+            size_t appended = filter_into(source, source, [](const std::string& value) { return value.size() == 1; });
+
+            THEN("The copies should be appended after the original strings")
+            {
+                REQUIRE(appended == 10);
+                REQUIRE(source.size() == 40);
+                REQUIRE(source[29] == "29");
+                REQUIRE(source[30] == "0");
+                REQUIRE(source[39] == "9");
+            }
+        }
+
+        WHEN("A part of the array is filtered into the array")
+        {
+            size_t appended = filter_into(source.slice(20, 10), source, [](const std::string& value) { return value[1] < '5'; });
+
+            THEN("The copies of the part should be appended")
+            {
+                REQUIRE(appended == 5);
+                REQUIRE(source.size() == 35);
+                REQUIRE(source[30] == "20");
+                REQUIRE(source[34] == "24");
+            }
+        }
+    }
+}
+
+SCENARIO("Testing parallel_erase_if")
+{
+    GIVEN("Arrays large enough to be split")
+    {
+        auto rare = [](auto value) { return value % 10 != 0; };
+        auto frequent = [](auto value) { return value % 10 == 0; };
+
+        THEN("Parallel_erase_if should keep the same elements as std::remove_if")
+        {
+            CHECK(TestFilter::erasesInParallelLikeStd<int32_t>(1 << 18, 4, rare));
+            CHECK(TestFilter::erasesInParallelLikeStd<int32_t>(1 << 18, 3, frequent));
+            CHECK(TestFilter::erasesInParallelLikeStd<uint64_t>((1 << 18) + 5, 4, rare));
+            CHECK(TestFilter::erasesInParallelLikeStd<int16_t>(1 << 18, 2, frequent));
+            CHECK(TestFilter::erasesInParallelLikeStd<int32_t>(1000, 4, rare));
+        }
+    }
+
+    GIVEN("An array of elements that aren't trivially copyable")
+    {
+        DynamicArray<std::string> strings;
+        for(int i = 0; i < (1 << 18); ++i)
+        {
+            strings.push_back(std::to_string(i));
+        }
+
+        WHEN("Most of its elements are erased in parallel")
+        {
+            size_t erased = parallel_erase_if(strings, [](const std::string& value) { return value.back() != '7'; }, 4);
+
+            THEN("The kept elements should be in order")
+            {
+                REQUIRE(strings.size() == (1 << 18) / 10);
+                REQUIRE(erased == (1 << 18) - strings.size());
+                for(size_t i = 0; i < strings.size(); ++i)
+                {
+                    REQUIRE(strings[i] == std::to_string(10 * i + 7));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the filters of arrays with other allocators")
+{
+    GIVEN("Arrays with allocators other than the default one")
+    {
+        DynamicArray<int, ThreadLocalPoolAllocator> values;
+        for(int i = 0; i < (1 << 17); ++i)
+        {
+            values.push_back(i);
+        }
+        DynamicArray<int, GlobalPoolAllocator> multiples;
+
+        WHEN("They are filtered and erased from")
+        {
+            size_t appended = filter_into(values, multiples, [](int value) { return value % 3 == 0; });
+            size_t erased = erase_if(multiples, [](int value) { return value % 2 == 0; });
+            size_t erasedInParallel = parallel_erase_if(values, [](int value) { return value % 4 != 0; }, 2);
+
+            THEN("They should be filtered like arrays of the default allocator")
+            {
+                REQUIRE(appended == ((1 << 17) + 2) / 3);
+                REQUIRE(erased == appended - multiples.size());
+                REQUIRE(multiples[1] == 9);
+                REQUIRE(erasedInParallel == (1 << 17) / 4 * 3);
+                REQUIRE(values[1] == 4);
+            }
+        }
+    }
+}
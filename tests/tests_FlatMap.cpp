@@ -0,0 +1,145 @@
+#include "catch.hpp"
+#include "../FlatMap.hpp"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+class TestFlatMap
+{
+public:
+
+    template <class Value>
+    static bool areEqual(const FlatMap<int, Value>& map, const std::map<int, Value>& expected)
+    {
+        if(map.size() != expected.size())
+            return false;
+
+        size_t index = 0;
+        for(const auto& pair : expected)
+        {
+            if(map.key_at(index) != pair.first || map.value_at(index) != pair.second)
+                return false;
+            ++index;
+        }
+        return true;
+    }
+};
+
+SCENARIO("Testing insertion in a flat map")
+{
+    GIVEN("An empty map")
+    {
+        FlatMap<int, std::string> testMap;
+
+        THEN("Accessing a key should throw an exception")
+        {
+            CHECK(testMap.empty());
+            REQUIRE_THROWS_AS(testMap.at(1), std::out_of_range);
+        }
+
+        WHEN("Pairs are inserted one by one")
+        {
+            std::map<int, std::string> expected;
+            std::mt19937 generator(7);
+
+            for(int i = 0; i < 300; ++i)
+            {
+                int key = generator() % 200;
+                std::string value = std::to_string(i);
+                REQUIRE(testMap.insert(key, value) == expected.insert(std::make_pair(key, value)).second);
+            }
+
+            THEN("The map should contain the same pairs as std::map")
+            {
+                CHECK(TestFlatMap::areEqual(testMap, expected));
+            }
+
+            WHEN("Values are assigned and erased")
+            {
+                for(int key = 0; key < 200; key += 3)
+                {
+                    testMap.insert_or_assign(key, "assigned");
+                    expected[key] = "assigned";
+                }
+                for(int key = 1; key < 200; key += 3)
+                {
+                    REQUIRE(testMap.erase(key) == (expected.erase(key) == 1));
+                }
+
+                THEN("The map should contain the same pairs as std::map")
+                {
+                    CHECK(TestFlatMap::areEqual(testMap, expected));
+                    REQUIRE(testMap.at(0) == "assigned");
+                }
+            }
+        }
+
+        WHEN("Values are accessed through operator[]")
+        {
+            testMap[5] = "five";
+            testMap[1] = "one";
+            testMap[5] += "!";
+
+            THEN("Missing keys should be inserted")
+            {
+                REQUIRE(testMap.size() == 2);
+                REQUIRE(testMap.key_at(0) == 1);
+                REQUIRE(testMap.at(5) == "five!");
+            }
+        }
+    }
+
+    GIVEN("A map with some pairs")
+    {
+        FlatMap<int, int> testMap;
+        for(int i = 0; i < 50; i += 5)
+        {
+            testMap.insert(i, -i);
+        }
+
+        WHEN("An unsorted array of pairs with repeated keys is inserted at once")
+        {
+            DynamicArray<std::pair<int, int>> batch;
+            for(int i = 49; i >= 0; --i)
+            {
+                batch.push_back(std::make_pair(i, i));
+            }
+            batch.push_back(std::make_pair(1, 100));
+
+            testMap.insert(batch);
+
+            THEN("Old keys should keep their values and the first of the new pairs should be inserted")
+            {
+                std::map<int, int> expected;
+                for(int i = 0; i < 50; ++i)
+                {
+                    expected[i] = i % 5 == 0 ? -i : i;
+                }
+
+                CHECK(TestFlatMap::areEqual(testMap, expected));
+            }
+        }
+    }
+
+    GIVEN("Pairs with the same key and shared pointers as values")
+    {
+        std::shared_ptr<int> pointer = std::make_shared<int>(7);
+        DynamicArray<std::pair<int, std::shared_ptr<int>>> batch;
+        for(int i = 0; i < 10; ++i)
+        {
+            batch.push_back(std::make_pair(3, pointer));
+        }
+
+        FlatMap<int, std::shared_ptr<int>> testMap;
+        testMap.insert(batch);
+        batch.clear();
+
+        THEN("The removed pairs shouldn't keep their values")
+        {
+            REQUIRE(testMap.size() == 1);
+            REQUIRE(pointer.use_count() == 2);
+        }
+    }
+}
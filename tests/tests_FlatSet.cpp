@@ -0,0 +1,181 @@
+#include "catch.hpp"
+#include "../FlatSet.hpp"
+
+#include <memory>
+#include <set>
+#include <random>
+
+class TestFlatSet
+{
+public:
+
+    static bool isSorted(const FlatSet<int>& set)
+    {
+        for(size_t i = 1; i < set.size(); ++i)
+        {
+            if(!(set[i - 1] < set[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static bool areEqual(const FlatSet<int>& set, const std::set<int>& expected)
+    {
+        return set.size() == expected.size() && std::equal(set.begin(), set.end(), expected.begin());
+    }
+};
+
+SCENARIO("Testing branchless lower bound")
+{
+    GIVEN("A sorted range with repeated elements")
+    {
+        const int range[] = {1, 3, 3, 3, 5, 8, 8, 13, 21};
+        const size_t count = sizeof(range) / sizeof(range[0]);
+
+        THEN("It should find the same positions as std::lower_bound")
+        {
+            for(size_t length = 0; length <= count; ++length)
+            {
+                for(int key = 0; key < 23; ++key)
+                {
+                    const int* expected = std::lower_bound(range, range + length, key);
+                    if(branchlessLowerBound(range, length, key, std::less<int>()) != expected)
+                        CHECK(false);
+                }
+            }
+            CHECK(true);
+        }
+    }
+}
+
+SCENARIO("Testing insertion in a flat set")
+{
+    GIVEN("An empty set")
+    {
+        FlatSet<int> testSet;
+
+        THEN("It should be empty")
+        {
+            CHECK(testSet.empty());
+            CHECK_FALSE(testSet.contains(0));
+            REQUIRE(testSet.find(0) == testSet.size());
+        }
+
+        WHEN("Elements are inserted one by one")
+        {
+            std::set<int> expected;
+            std::mt19937 generator(42);
+
+            for(int i = 0; i < 500; ++i)
+            {
+                int value = generator() % 300;
+                REQUIRE(testSet.insert(value) == expected.insert(value).second);
+            }
+
+            THEN("The set should be sorted and contain each element once")
+            {
+                CHECK(TestFlatSet::isSorted(testSet));
+                CHECK(TestFlatSet::areEqual(testSet, expected));
+            }
+
+            THEN("Every inserted element should be found")
+            {
+                for(int value : expected)
+                {
+                    if(!testSet.contains(value))
+                        CHECK(false);
+                }
+                CHECK_FALSE(testSet.contains(300));
+            }
+
+            WHEN("Elements are erased")
+            {
+                for(int value = 0; value < 300; value += 2)
+                {
+                    REQUIRE(testSet.erase(value) == (expected.erase(value) == 1));
+                }
+
+                THEN("Only the remaining elements should be in the set")
+                {
+                    CHECK(TestFlatSet::isSorted(testSet));
+                    CHECK(TestFlatSet::areEqual(testSet, expected));
+                }
+            }
+        }
+    }
+
+    GIVEN("A set with some elements")
+    {
+        FlatSet<int> testSet;
+        for(int i = 0; i < 100; i += 3)
+        {
+            testSet.insert(i);
+        }
+
+        WHEN("An unsorted array with duplicates is inserted at once")
+        {
+            DynamicArray<int> batch;
+            for(int i = 99; i >= 0; i -= 2)
+            {
+                batch.push_back(i);
+                batch.push_back(i);
+            }
+
+            testSet.insert(batch);
+
+            THEN("The set should contain the union of both")
+            {
+                std::set<int> expected;
+                for(int i = 0; i < 100; i += 3)
+                {
+                    expected.insert(i);
+                }
+                for(int i = 99; i >= 0; i -= 2)
+                {
+                    expected.insert(i);
+                }
+
+                CHECK(TestFlatSet::isSorted(testSet));
+                CHECK(TestFlatSet::areEqual(testSet, expected));
+            }
+        }
+    }
+
+    GIVEN("Shared pointers inserted many times at once")
+    {
+        std::shared_ptr<int> pointer = std::make_shared<int>(7);
+        DynamicArray<std::shared_ptr<int>> batch;
+        for(int i = 0; i < 10; ++i)
+        {
+            batch.push_back(pointer);
+        }
+
+        FlatSet<std::shared_ptr<int>> testSet;
+        testSet.insert(batch);
+        batch.clear();
+
+        THEN("The removed duplicates shouldn't keep their pointers")
+        {
+            REQUIRE(testSet.size() == 1);
+            REQUIRE(pointer.use_count() == 2);
+        }
+    }
+
+    GIVEN("A set with a custom ordering")
+    {
+        DynamicArray<int> values;
+        for(int i = 0; i < 10; ++i)
+        {
+            values.push_back(i);
+        }
+
+        FlatSet<int, std::greater<int>> testSet(values);
+
+        THEN("The elements should be sorted by it")
+        {
+            REQUIRE(testSet[0] == 9);
+            REQUIRE(testSet[9] == 0);
+            REQUIRE(testSet.lower_bound(4) == 5);
+        }
+    }
+}
@@ -0,0 +1,325 @@
+#include "catch.hpp"
+#include "../Allocator.hpp"
+#include "../Gather.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+
+class TestGather
+{
+public:
+
+    template <class Type>
+    static DynamicArray<Type> makeSource(size_t size)
+    {
+        DynamicArray<Type> source;
+        for(size_t i = 0; i < size; ++i)
+        {
+            source.push_back(Type(i * 3 + 1));
+        }
+        return source;
+    }
+
+    template <class Index>
+    static DynamicArray<Index> makeIndices(size_t count, size_t range)
+    {
+        std::mt19937_64 generator(count);
+        DynamicArray<Index> indices;
+        for(size_t i = 0; i < count; ++i)
+        {
+            indices.push_back(Index(generator() % range));
+        }
+        return indices;
+    }
+
+    template <class Type, class Index>
+    static bool gathersLikeLoop(size_t size, size_t count)
+    {
+        DynamicArray<Type> source = makeSource<Type>(size);
+        DynamicArray<Index> indices = makeIndices<Index>(count, size);
+
+        DynamicArray<Type> out;
+        out.push_back(Type(7));
+        gather(source, indices, out);
+
+        if(out.size() != count + 1 || out[0] != Type(7))
+            return false;
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(out[i + 1] != source[size_t(indices[i])])
+                return false;
+        }
+        return true;
+    }
+
+    template <class Type, class Index>
+    static bool scattersLikeLoop(size_t size, size_t count)
+    {
+        DynamicArray<Type> values = makeSource<Type>(count);
+        DynamicArray<Index> indices = makeIndices<Index>(count, size);
+
+        DynamicArray<Type> target(size);
+        DynamicArray<Type> expected(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            target.push_back(Type(0));
+            expected.push_back(Type(0));
+        }
+
+        scatter(values, indices, target);
+        for(size_t i = 0; i < count; ++i)
+        {
+            expected[size_t(indices[i])] = values[i];
+        }
+
+        for(size_t i = 0; i < size; ++i)
+        {
+            if(target[i] != expected[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+SCENARIO("Testing gather")
+{
+    GIVEN("Sources and indices of different types")
+    {
+        THEN("Gather should copy the same elements as a loop")
+        {
+            CHECK(TestGather::gathersLikeLoop<int32_t, int32_t>(1000, 1003));
+            CHECK(TestGather::gathersLikeLoop<uint32_t, uint64_t>(1000, 1003));
+            CHECK(TestGather::gathersLikeLoop<float, uint32_t>(1000, 37));
+            CHECK(TestGather::gathersLikeLoop<double, int32_t>(1000, 1003));
+            CHECK(TestGather::gathersLikeLoop<int64_t, size_t>(5000, 999));
+            CHECK(TestGather::gathersLikeLoop<uint16_t, uint32_t>(1000, 100));
+            CHECK(TestGather::gathersLikeLoop<int32_t, uint8_t>(200, 100));
+        }
+    }
+
+    GIVEN("A source of strings")
+    {
+        DynamicArray<std::string> source;
+        for(size_t i = 0; i < 100; ++i)
+        {
+            source.push_back(std::to_string(i));
+        }
+        DynamicArray<size_t> indices = TestGather::makeIndices<size_t>(50, 100);
+
+        WHEN("Some strings are gathered")
+        {
+            DynamicArray<std::string> out;
+            gather(source, indices, out);
+
+            THEN("They should be copies of the indexed ones")
+            {
+                REQUIRE(out.size() == 50);
+                for(size_t i = 0; i < 50; ++i)
+                {
+                    REQUIRE(out[i] == std::to_string(indices[i]));
+                }
+            }
+        }
+    }
+
+    GIVEN("An index out of range")
+    {
+        DynamicArray<int> source = TestGather::makeSource<int>(10);
+        DynamicArray<int> indices;
+        indices.push_back(3);
+        indices.push_back(10);
+
+        DynamicArray<int> negative;
+        negative.push_back(-1);
+
+        THEN("Gather should throw without appending anything")
+        {
+            DynamicArray<int> out;
+            REQUIRE_THROWS_AS(gather(source, indices, out), std::out_of_range);
+            REQUIRE_THROWS_AS(gather(source, negative, out), std::out_of_range);
+            REQUIRE(out.empty());
+        }
+    }
+
+    GIVEN("A full array gathered into itself")
+    {
+        DynamicArray<size_t> array;
+        array.reserve(4);
+        for(size_t i = 0; i < 4; ++i)
+        {
+            array.push_back(3 - i);
+        }
+
+        WHEN("It is the source")
+        {
+            DynamicArray<size_t> indices;
+            indices.push_back(2);
+            indices.push_back(0);
+            indices.push_back(3);
+            gather(array, indices, array);
+
+            THEN("The elements should be read from before it grew")
+            {
+                REQUIRE(array.size() == 7);
+                REQUIRE(array[4] == 1);
+                REQUIRE(array[5] == 3);
+                REQUIRE(array[6] == 0);
+            }
+        }
+
+        WHEN("It is also the indices")
+        {
+            gather(array, array, array);
+
+            THEN("Every element should be replaced by the one at its value")
+            {
+                REQUIRE(array.size() == 8);
+                REQUIRE(array[4] == 0);
+                REQUIRE(array[5] == 1);
+                REQUIRE(array[6] == 2);
+                REQUIRE(array[7] == 3);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing scatter")
+{
+    GIVEN("Values and indices with repetitions")
+    {
+        THEN("Scatter should write the same elements as a loop")
+        {
+            CHECK(TestGather::scattersLikeLoop<int32_t, int32_t>(100, 1003));
+            CHECK(TestGather::scattersLikeLoop<uint64_t, uint64_t>(100, 1003));
+            CHECK(TestGather::scattersLikeLoop<float, uint32_t>(1000, 333));
+            CHECK(TestGather::scattersLikeLoop<double, int64_t>(7, 64));
+            CHECK(TestGather::scattersLikeLoop<int16_t, uint32_t>(50, 200));
+        }
+    }
+
+    GIVEN("Values written to one index")
+    {
+        DynamicArray<int> values = TestGather::makeSource<int>(40);
+        DynamicArray<int> indices;
+        for(size_t i = 0; i < 40; ++i)
+        {
+            indices.push_back(2);
+        }
+        DynamicArray<int> target = TestGather::makeSource<int>(4);
+
+        WHEN("They are scattered")
+        {
+            scatter(values, indices, target);
+
+            THEN("The last value should be kept")
+            {
+                REQUIRE(target[2] == values[39]);
+                REQUIRE(target[1] == 4);
+            }
+        }
+    }
+
+    GIVEN("Invalid arguments")
+    {
+        DynamicArray<int> values = TestGather::makeSource<int>(2);
+        DynamicArray<int> target = TestGather::makeSource<int>(4);
+        DynamicArray<int> indices;
+        indices.push_back(1);
+
+        THEN("Scatter should throw")
+        {
+            REQUIRE_THROWS_AS(scatter(values, indices, target), std::invalid_argument);
+
+            indices.push_back(4);
+            REQUIRE_THROWS_AS(scatter(values, indices, target), std::out_of_range);
+            REQUIRE(target[1] == 4);
+        }
+    }
+}
+
+SCENARIO("Testing indexed for each")
+{
+    GIVEN("An array and indices")
+    {
+        DynamicArray<long> source = TestGather::makeSource<long>(1000);
+        DynamicArray<uint32_t> indices = TestGather::makeIndices<uint32_t>(500, 1000);
+
+        WHEN("The indexed elements are summed")
+        {
+            const DynamicArray<long>& constant = source;
+            long sum = 0;
+            indexed_for_each(constant, indices, [&sum](const long& value) { sum += value; });
+
+            THEN("The sum should match a loop")
+            {
+                long expected = 0;
+                for(size_t i = 0; i < indices.size(); ++i)
+                {
+                    expected += source[indices[i]];
+                }
+                REQUIRE(sum == expected);
+            }
+        }
+
+        WHEN("The indexed elements are modified")
+        {
+            indexed_for_each(source, indices, [](long& value) { value = -1; }, 4);
+
+            THEN("Exactly they should change")
+            {
+                for(size_t i = 0; i < indices.size(); ++i)
+                {
+                    REQUIRE(source[indices[i]] == -1);
+                }
+
+                size_t changed = 0;
+                for(size_t i = 0; i < source.size(); ++i)
+                {
+                    changed += source[i] == -1;
+                }
+                DynamicArray<uint32_t> sorted = indices;
+                std::sort(sorted.begin(), sorted.end());
+                REQUIRE(changed == size_t(std::unique(sorted.begin(), sorted.end()) - sorted.begin()));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the indexed accesses of arrays with other allocators")
+{
+    GIVEN("A source, indices and an output with different allocators")
+    {
+        DynamicArray<int, ThreadLocalPoolAllocator> source;
+        for(int i = 0; i < 10; ++i)
+        {
+            source.push_back(i * 10);
+        }
+        DynamicArray<uint32_t, GlobalPoolAllocator> indices;
+        indices.push_back(9);
+        indices.push_back(2);
+        DynamicArray<int, GlobalPoolAllocator> out;
+
+        WHEN("They are gathered, scattered and visited")
+        {
+            gather(source, indices, out);
+            scatter(out, indices, source);
+            int total = 0;
+            indexed_for_each(static_cast<const DynamicArray<int, ThreadLocalPoolAllocator>&>(source), indices, [&total](const int& value) { total += value; });
+            indexed_for_each(source, indices, [](int& value) { value = -value; });
+
+            THEN("They should behave like arrays of the default allocator")
+            {
+                REQUIRE(out.size() == 2);
+                REQUIRE(out[0] == 90);
+                REQUIRE(out[1] == 20);
+                REQUIRE(total == 110);
+                REQUIRE(source[9] == -90);
+                REQUIRE(source[2] == -20);
+                REQUIRE(source[3] == 30);
+            }
+        }
+    }
+}
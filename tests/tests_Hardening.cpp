@@ -0,0 +1,176 @@
+#include "catch.hpp"
+#include "../DynamicArray.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+class HardeningError : public std::logic_error
+{
+public:
+    HardeningError(const char* condition) : std::logic_error(condition)
+    {
+
+    }
+};
+
+class TestHardening
+{
+public:
+
+    static void throwing(const char* condition, const char*, int)
+    {
+        throw HardeningError(condition);
+    }
+
+    static DynamicArray<int> make(size_t size)
+    {
+        DynamicArray<int> array;
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(int(size - i));
+        }
+        return array;
+    }
+};
+
+SCENARIO("Testing the iterators of the dynamic array")
+{
+    GIVEN("An array")
+    {
+        DynamicArray<int> array = TestHardening::make(100);
+
+        WHEN("It is sorted through its iterators")
+        {
+            std::sort(array.begin(), array.end());
+
+            THEN("The elements should be in order")
+            {
+                REQUIRE(std::is_sorted(array.begin(), array.end()));
+                REQUIRE(array.end() - array.begin() == 100);
+                REQUIRE(*array.begin() == 1);
+            }
+        }
+
+        WHEN("It is traversed by a range-based loop")
+        {
+            const DynamicArray<int>& constant = array;
+            long sum = 0;
+            for(int value : constant)
+            {
+                sum += value;
+            }
+
+            THEN("Every element should be visited")
+            {
+                REQUIRE(sum == std::accumulate(array.begin(), array.end(), 0L));
+                REQUIRE(sum == 5050);
+            }
+        }
+    }
+}
+
+#if DYNAMIC_ARRAY_HARDENING >= 1
+
+SCENARIO("Testing the bounds checks")
+{
+    HardeningHandler previous = set_hardening_handler(TestHardening::throwing);
+
+    GIVEN("An array with spare capacity")
+    {
+        DynamicArray<int> array(10);
+        array.push_back(1);
+
+        THEN("Accessing elements past the size should fail the check")
+        {
+            REQUIRE(array[0] == 1);
+            REQUIRE_THROWS_AS(array[1], HardeningError);
+            REQUIRE_THROWS_AS(array[10], HardeningError);
+        }
+    }
+
+    GIVEN("A buffer")
+    {
+        Buffer<int> buffer(4);
+
+        THEN("Accessing elements past its capacity should fail the check")
+        {
+            REQUIRE_NOTHROW(buffer[3]);
+            REQUIRE_THROWS_AS(buffer[4], HardeningError);
+        }
+    }
+
+    set_hardening_handler(previous);
+}
+
+#endif
+
+#if DYNAMIC_ARRAY_HARDENING >= 2
+
+SCENARIO("Testing the checked iterators")
+{
+    HardeningHandler previous = set_hardening_handler(TestHardening::throwing);
+
+    GIVEN("An array and an iterator to its first element")
+    {
+        DynamicArray<int> array = TestHardening::make(4);
+        DynamicArray<int>::iterator first = array.begin();
+
+        WHEN("The array grows")
+        {
+            array.push_back(0);
+
+            THEN("The iterator should be invalid")
+            {
+                REQUIRE_THROWS_AS(*first, HardeningError);
+                REQUIRE_NOTHROW(*array.begin());
+            }
+        }
+
+        WHEN("The array is cleared")
+        {
+            array.clear();
+
+            THEN("The iterator should be invalid")
+            {
+                REQUIRE_THROWS_AS(*first, HardeningError);
+            }
+        }
+
+        WHEN("The last element is popped")
+        {
+            DynamicArray<int>::iterator last = array.end() - 1;
+            array.pop_back();
+
+            THEN("An iterator to it should be out of bounds")
+            {
+                REQUIRE_THROWS_AS(*last, HardeningError);
+                REQUIRE_NOTHROW(*first);
+            }
+        }
+
+        THEN("Leaving the array should fail the check")
+        {
+            REQUIRE_THROWS_AS(*array.end(), HardeningError);
+            REQUIRE_THROWS_AS(array.end() + 1, HardeningError);
+            REQUIRE_THROWS_AS(array.begin() - 1, HardeningError);
+            REQUIRE_THROWS_AS(first[4], HardeningError);
+        }
+
+        THEN("Comparing iterators of different arrays should fail the check")
+        {
+            DynamicArray<int> other = TestHardening::make(4);
+            REQUIRE_THROWS_AS(first == other.begin(), HardeningError);
+        }
+
+        THEN("A default-constructed iterator should not be dereferenced")
+        {
+            DynamicArray<int>::iterator none;
+            REQUIRE_THROWS_AS(*none, HardeningError);
+        }
+    }
+
+    set_hardening_handler(previous);
+}
+
+#endif
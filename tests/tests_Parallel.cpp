@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "../Parallel.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+SCENARIO("Testing the fork-join helpers")
+{
+    GIVEN("Inputs of different sizes")
+    {
+        THEN("The threads should be limited to one per minimum chunk")
+        {
+            REQUIRE(limitThreads(1000, 8) == 0);
+            REQUIRE(limitThreads(PARALLEL_MINIMUM_CHUNK * 3, 8) == 3);
+            REQUIRE(limitThreads(PARALLEL_MINIMUM_CHUNK * 100, 8) == 8);
+            REQUIRE(limitThreads(100, 8, 10) == 8);
+            REQUIRE(parallelThreads() >= 1);
+        }
+    }
+
+    GIVEN("Tasks that count their calls")
+    {
+        std::vector<std::atomic<int>> calls(7);
+        runParallel(7, [&calls](size_t i) { ++calls[i]; });
+
+        THEN("Every task should be called once")
+        {
+            for(std::atomic<int>& count : calls)
+            {
+                REQUIRE(count == 1);
+            }
+        }
+    }
+
+    GIVEN("A range split into parts")
+    {
+        std::vector<int> covered(1001, 0);
+        runParallelRanges(1001, 4, [&covered](size_t first, size_t last)
+        {
+            for(size_t i = first; i < last; ++i)
+            {
+                ++covered[i];
+            }
+        });
+
+        THEN("Every index should be in exactly one part")
+        {
+            for(int count : covered)
+            {
+                REQUIRE(count == 1);
+            }
+        }
+    }
+
+    GIVEN("Tasks that throw")
+    {
+        std::atomic<int> finished(0);
+        auto task = [&finished](size_t i)
+        {
+            if(i % 2 == 1)
+                throw std::runtime_error(i == 1 ? "first" : "later");
+            ++finished;
+        };
+
+        THEN("The first error should be rethrown after all tasks are done")
+        {
+            REQUIRE_THROWS_WITH(runParallel(6, task), "first");
+            REQUIRE(finished == 3);
+        }
+    }
+}
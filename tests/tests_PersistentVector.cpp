@@ -0,0 +1,206 @@
+#include "catch.hpp"
+#include "../PersistentVector.hpp"
+
+class TestPersistentVector
+{
+public:
+
+    static PersistentVector<int> init(size_t used)
+    {
+        PersistentVector<int> vector;
+        for(size_t i = 0; i < used; ++i)
+        {
+            vector = vector.push_back(i);
+        }
+        return vector;
+    }
+
+    template <class Vector>
+    static bool hasValidElements(const Vector& vector, size_t used)
+    {
+        if(vector.size() != used)
+            return false;
+
+        for(size_t i = 0; i < used; ++i)
+        {
+            if(vector[i] != int(i))
+                return false;
+        }
+
+        return true;
+    }
+};
+
+SCENARIO("Testing push_back on a persistent vector")
+{
+    GIVEN("An empty vector")
+    {
+        PersistentVector<int> emptyVector;
+
+        THEN("It should be empty")
+        {
+            CHECK(emptyVector.empty());
+            REQUIRE_THROWS_AS(emptyVector.at(0), std::out_of_range);
+        }
+
+        WHEN("An element is pushed")
+        {
+            PersistentVector<int> newVector = emptyVector.push_back(7);
+
+            THEN("Only the new version should contain it")
+            {
+                REQUIRE(newVector.size() == 1);
+                REQUIRE(newVector[0] == 7);
+                CHECK(emptyVector.empty());
+            }
+        }
+    }
+
+    GIVEN("Vectors whose elements fill several levels of the trie")
+    {
+        size_t elements = GENERATE(31, 32, 33, 1024, 1056, 1057, 40000);
+
+        PersistentVector<int> testVector = TestPersistentVector::init(elements);
+
+        THEN("All elements should be accessible")
+        {
+            CHECK(TestPersistentVector::hasValidElements(testVector, elements));
+        }
+
+        WHEN("An element is pushed")
+        {
+            PersistentVector<int> newVector = testVector.push_back(elements);
+
+            THEN("The old version shouldn't change")
+            {
+                CHECK(TestPersistentVector::hasValidElements(testVector, elements));
+                CHECK(TestPersistentVector::hasValidElements(newVector, elements + 1));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing set on a persistent vector")
+{
+    GIVEN("A vector with elements in the trie and in the tail")
+    {
+        const size_t elements = 2000;
+
+        PersistentVector<int> testVector = TestPersistentVector::init(elements);
+
+        WHEN("Elements in the trie and in the tail are replaced")
+        {
+            PersistentVector<int> first = testVector.set(5, -1);
+            PersistentVector<int> second = first.set(elements - 1, -2);
+
+            THEN("Every version should contain its own elements")
+            {
+                CHECK(TestPersistentVector::hasValidElements(testVector, elements));
+
+                REQUIRE(first[5] == -1);
+                REQUIRE(first[elements - 1] == elements - 1);
+
+                REQUIRE(second[5] == -1);
+                REQUIRE(second[elements - 1] == -2);
+                REQUIRE(second[6] == 6);
+            }
+        }
+
+        WHEN("An element outside of the vector is replaced")
+        {
+            THEN("An exception should be thrown")
+            {
+                REQUIRE_THROWS_AS(testVector.set(elements, 0), std::out_of_range);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing transient builders")
+{
+    GIVEN("A vector")
+    {
+        const size_t elements = 100;
+
+        PersistentVector<int> testVector = TestPersistentVector::init(elements);
+
+        WHEN("A transient is modified")
+        {
+            PersistentVector<int>::Transient builder = testVector.transient();
+
+            for(size_t i = elements; i < 5000; ++i)
+            {
+                builder.push_back(i);
+            }
+            builder.set(0, -1);
+            builder.set(4999, -2);
+
+            PersistentVector<int> result = builder.persistent();
+
+            THEN("The original vector shouldn't change")
+            {
+                CHECK(TestPersistentVector::hasValidElements(testVector, elements));
+            }
+
+            THEN("The result should contain all changes")
+            {
+                REQUIRE(result.size() == 5000);
+                REQUIRE(result[0] == -1);
+                REQUIRE(result[4999] == -2);
+                REQUIRE(result[1234] == 1234);
+            }
+
+            THEN("The transient can't be used anymore")
+            {
+                REQUIRE_THROWS_AS(builder.push_back(0), std::logic_error);
+            }
+
+            WHEN("The result is modified")
+            {
+                PersistentVector<int> modified = result.set(10, -3).push_back(5000);
+
+                THEN("The result shouldn't change")
+                {
+                    REQUIRE(result[10] == 10);
+                    REQUIRE(result.size() == 5000);
+                    REQUIRE(modified[10] == -3);
+                    REQUIRE(modified[5000] == 5000);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Testing conversion between DynamicArray and PersistentVector")
+{
+    GIVEN("A DynamicArray")
+    {
+        DynamicArray<int> array;
+        for(int i = 0; i < 3000; ++i)
+        {
+            array.push_back(i);
+        }
+
+        WHEN("A persistent vector is constructed from it")
+        {
+            PersistentVector<int> testVector(array);
+
+            THEN("It should contain the same elements")
+            {
+                CHECK(TestPersistentVector::hasValidElements(testVector, array.size()));
+            }
+
+            THEN("It should be converted back to the same array")
+            {
+                DynamicArray<int> result = testVector.to_dynamic_array();
+
+                REQUIRE(result.size() == array.size());
+                for(size_t i = 0; i < result.size(); ++i)
+                {
+                    if(result[i] != array[i])
+                        CHECK(false);
+                }
+            }
+        }
+    }
+}
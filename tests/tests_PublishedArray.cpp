@@ -0,0 +1,160 @@
+#include "catch.hpp"
+#include "../PublishedArray.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class TestPublishedArray
+{
+public:
+
+    static DynamicArray<int> makeVersion(int value, size_t size)
+    {
+        DynamicArray<int> array;
+        array.append_n(size, value);
+        return array;
+    }
+
+    /**
+     * every version consists of copies of its number, so a reader sees a torn or freed version as
+     * an array with different elements
+     */
+    static bool readsConsistently(size_t readers, int versions)
+    {
+        PublishedArray<int> published(makeVersion(0, 64), readers);
+        std::atomic<bool> done(false);
+        std::atomic<bool> consistent(true);
+        std::vector<std::thread> threads;
+
+        for(size_t i = 0; i < readers; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                PublishedArray<int>::Reader reader(published);
+                int last = 0;
+                while(!done.load())
+                {
+                    PublishedArray<int>::Snapshot snapshot = reader.read();
+                    int value = snapshot->front();
+                    if(value < last || snapshot->size() != size_t(64 + value % 7))
+                        consistent = false;
+                    for(int element : *snapshot)
+                    {
+                        if(element != value)
+                            consistent = false;
+                    }
+                    last = value;
+                }
+            });
+        }
+
+        for(int version = 1; version <= versions; ++version)
+        {
+            if(version % 2 == 0)
+                published.publish(makeVersion(version, 64 + version % 7));
+            else
+                published.update([version](DynamicArray<int>& array)
+                {
+                    array.clear();
+                    array.append_n(64 + version % 7, version);
+                });
+        }
+        done = true;
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        published.synchronize();
+        return consistent && published.retired() == 0;
+    }
+};
+
+SCENARIO("Testing published arrays")
+{
+    GIVEN("A published array and a reader")
+    {
+        PublishedArray<int> published(TestPublishedArray::makeVersion(1, 3), 2);
+        PublishedArray<int>::Reader reader(published);
+
+        WHEN("A new version is published while a snapshot is held")
+        {
+            PublishedArray<int>::Snapshot snapshot = reader.read();
+            published.publish(TestPublishedArray::makeVersion(2, 5));
+
+            THEN("The snapshot should keep the old version until it is destroyed")
+            {
+                REQUIRE(snapshot->size() == 3);
+                REQUIRE(snapshot.array()[2] == 1);
+                REQUIRE(published.retired() == 1);
+                REQUIRE(published.reclaim() == 0);
+
+                {
+                    PublishedArray<int>::Snapshot nested = reader.read();
+                    REQUIRE((*nested).size() == 5);
+                }
+                REQUIRE(published.reclaim() == 0);
+            }
+        }
+
+        WHEN("A new version is published without snapshots")
+        {
+            {
+                PublishedArray<int>::Snapshot snapshot = reader.read();
+            }
+            published.publish(TestPublishedArray::makeVersion(2, 5));
+
+            THEN("The old version should be freed right away")
+            {
+                REQUIRE(published.retired() == 0);
+                REQUIRE(reader.read()->back() == 2);
+            }
+        }
+
+        WHEN("An update throws")
+        {
+            auto failing = [](DynamicArray<int>& array)
+            {
+                array.push_back(7);
+                throw std::runtime_error("The update failed");
+            };
+
+            THEN("Nothing should be published")
+            {
+                REQUIRE_THROWS_AS(published.update(failing), std::runtime_error);
+                REQUIRE(reader.read()->size() == 3);
+                REQUIRE(published.retired() == 0);
+            }
+        }
+
+        WHEN("Updates are applied")
+        {
+            published.update([](DynamicArray<int>& array) { array.push_back(4); });
+            published.update([](DynamicArray<int>& array) { array[0] = 0; });
+
+            THEN("Each should change the previous version")
+            {
+                PublishedArray<int>::Snapshot snapshot = reader.read();
+                REQUIRE(snapshot->size() == 4);
+                REQUIRE((*snapshot)[0] == 0);
+                REQUIRE((*snapshot)[3] == 4);
+            }
+        }
+
+        THEN("The reader slots should be limited")
+        {
+            PublishedArray<int>::Reader second(published);
+            REQUIRE_THROWS_AS(PublishedArray<int>::Reader(published), std::length_error);
+        }
+    }
+
+    GIVEN("Readers and a writer in different threads")
+    {
+        THEN("Every snapshot should be a whole version and every replaced version should be freed")
+        {
+            CHECK(TestPublishedArray::readsConsistently(3, 2000));
+        }
+    }
+}
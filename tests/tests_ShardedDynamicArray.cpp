@@ -0,0 +1,187 @@
+#include "catch.hpp"
+#include "../ShardedDynamicArray.hpp"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class TestShardedDynamicArray
+{
+public:
+
+    /**
+     * an element whose copies throw while the copying is armed
+     */
+    struct Fragile
+    {
+        static inline bool armed = false;
+        int value = 0;
+
+        Fragile() = default;
+        Fragile(int value) : value(value) {}
+        Fragile(const Fragile& other) : value(other.value) { check(); }
+        Fragile& operator=(const Fragile& other) { value = other.value; check(); return *this; }
+
+        void check()const
+        {
+            if(armed && value == 7)
+                throw std::runtime_error("Copy failed");
+        }
+    };
+
+    static void fillInThreads(ShardedDynamicArray<int>& array, size_t count)
+    {
+        std::vector<std::thread> threads;
+        for(size_t shard = 0; shard < array.shard_count(); ++shard)
+        {
+            threads.emplace_back([&array, shard, count]()
+            {
+                DynamicArray<int>& local = array.shard(shard);
+                for(size_t i = 0; i < count; ++i)
+                {
+                    local.push_back(int(shard * count + i));
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    static bool isSequence(const DynamicArray<int>& array, size_t from, size_t size)
+    {
+        if(array.size() != from + size)
+            return false;
+        for(size_t i = 0; i < size; ++i)
+        {
+            if(array[from + i] != int(i))
+                return false;
+        }
+        return true;
+    }
+};
+
+SCENARIO("Testing sharded arrays")
+{
+    GIVEN("Invalid shards")
+    {
+        THEN("They should be rejected")
+        {
+            REQUIRE_THROWS_AS(ShardedDynamicArray<int>(0), std::invalid_argument);
+
+            ShardedDynamicArray<int> array(2);
+            REQUIRE_THROWS_AS(array.shard(2), std::out_of_range);
+        }
+    }
+
+    GIVEN("Shards filled by several threads")
+    {
+        ShardedDynamicArray<int> array(4);
+        TestShardedDynamicArray::fillInThreads(array, 100000);
+
+        THEN("The shards should be on separate cache lines")
+        {
+            const char* first = reinterpret_cast<const char*>(&array.shard(0));
+            const char* second = reinterpret_cast<const char*>(&array.shard(1));
+            REQUIRE(second - first >= 64);
+            REQUIRE(array.size() == 400000);
+        }
+
+        WHEN("They are merged by one and by several threads")
+        {
+            DynamicArray<int> serial = array.merge(1);
+            DynamicArray<int> parallel = array.merge(4);
+
+            THEN("The elements should be in the order of the shards")
+            {
+                REQUIRE(TestShardedDynamicArray::isSequence(serial, 0, 400000));
+                REQUIRE(TestShardedDynamicArray::isSequence(parallel, 0, 400000));
+            }
+        }
+
+        WHEN("They are merged into an array with elements")
+        {
+            DynamicArray<int> out;
+            out.push_back(-1);
+            out.push_back(-2);
+            array.merge_into(out, 3);
+
+            THEN("The shards should be appended")
+            {
+                REQUIRE(out[0] == -1);
+                REQUIRE(out[1] == -2);
+                REQUIRE(TestShardedDynamicArray::isSequence(out, 2, 400000));
+            }
+        }
+
+        WHEN("The shards are cleared")
+        {
+            size_t capacity = array.shard(3).capacity();
+            array.clear();
+
+            THEN("They should be empty and keep their capacity")
+            {
+                REQUIRE(array.empty());
+                REQUIRE(array.shard(3).capacity() == capacity);
+                REQUIRE(array.merge().empty());
+            }
+        }
+    }
+
+    GIVEN("Shards with empty ones in between")
+    {
+        ShardedDynamicArray<int> array(5);
+        array.shard(1).push_back(0);
+        array.shard(1).push_back(1);
+        array.shard(3).push_back(2);
+        array.shard(4).push_back(3);
+
+        THEN("Their view should concatenate them without copying")
+        {
+            ShardedDynamicArray<int>::View view = array.view();
+            REQUIRE(view.size() == 4);
+            REQUIRE_FALSE(view.empty());
+            REQUIRE(&view[2] == &array.shard(3)[0]);
+
+            int expected = 0;
+            for(int value : view)
+            {
+                REQUIRE(value == expected++);
+            }
+            REQUIRE(expected == 4);
+            REQUIRE(view.at(3) == 3);
+            REQUIRE_THROWS_AS(view.at(4), std::out_of_range);
+        }
+
+        THEN("The view of empty shards should be empty")
+        {
+            array.clear();
+            ShardedDynamicArray<int>::View view = array.view();
+            REQUIRE(view.empty());
+            REQUIRE(view.begin() == view.end());
+        }
+    }
+
+    GIVEN("Elements whose copy throws")
+    {
+        ShardedDynamicArray<TestShardedDynamicArray::Fragile> array(2);
+        for(int i = 0; i < 10; ++i)
+        {
+            array.shard(i % 2).push_back(i);
+        }
+
+        THEN("A failed merge should leave the array at its old size")
+        {
+            DynamicArray<TestShardedDynamicArray::Fragile> out;
+            out.push_back(1);
+
+            TestShardedDynamicArray::Fragile::armed = true;
+            REQUIRE_THROWS_AS(array.merge_into(out), std::runtime_error);
+            TestShardedDynamicArray::Fragile::armed = false;
+
+            REQUIRE(out.size() == 1);
+            REQUIRE(out[0].value == 1);
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#include "catch.hpp"
+#include "../SharedDynamicArray.hpp"
+
+#include <thread>
+#include <vector>
+
+class TestSharedDynamicArray
+{
+public:
+
+    static void init(SharedDynamicArray<int>& arr, size_t used)
+    {
+        for(size_t i = 0; i < used; ++i)
+        {
+            arr.push_back(i);
+        }
+    }
+
+    static bool hasValidElements(const SharedDynamicArray<int>& arr, size_t used)
+    {
+        if(arr.size() != used)
+            return false;
+
+        for(size_t i = 0; i < used; ++i)
+        {
+            if(arr[i] != int(i))
+                return false;
+        }
+
+        return true;
+    }
+};
+
+SCENARIO("Testing copies of a shared array")
+{
+    GIVEN("A non-empty shared array")
+    {
+        SharedDynamicArray<int> testArray;
+        TestSharedDynamicArray::init(testArray, 10);
+
+        THEN("It should be the only owner of its elements")
+        {
+            CHECK(testArray.unique());
+        }
+
+        WHEN("A copy and a snapshot are made")
+        {
+            SharedDynamicArray<int> copy(testArray);
+            SharedDynamicArray<int> snapshot = testArray.snapshot();
+
+            THEN("All of them should share the same elements")
+            {
+                REQUIRE(testArray.use_count() == 3);
+                REQUIRE(&copy.array() == &testArray.array());
+                REQUIRE(&snapshot.array() == &testArray.array());
+            }
+
+            WHEN("The original array is modified")
+            {
+                testArray.push_back(10);
+                testArray.set(0, 100);
+
+                THEN("Only the original array should change")
+                {
+                    REQUIRE(testArray.size() == 11);
+                    REQUIRE(testArray[0] == 100);
+                    CHECK(TestSharedDynamicArray::hasValidElements(copy, 10));
+                    CHECK(TestSharedDynamicArray::hasValidElements(snapshot, 10));
+                }
+
+                THEN("The original array should stop sharing its elements")
+                {
+                    CHECK(testArray.unique());
+                    REQUIRE(copy.use_count() == 2);
+                }
+            }
+
+            WHEN("The original array is cleared")
+            {
+                testArray.clear();
+
+                THEN("The copies shouldn't change")
+                {
+                    CHECK(testArray.empty());
+                    CHECK(TestSharedDynamicArray::hasValidElements(copy, 10));
+                    REQUIRE(copy.use_count() == 2);
+                }
+            }
+        }
+
+        WHEN("A copy is assigned")
+        {
+            SharedDynamicArray<int> other;
+            TestSharedDynamicArray::init(other, 3);
+
+            other = testArray;
+
+            THEN("Both should share the same elements")
+            {
+                REQUIRE(testArray.use_count() == 2);
+                CHECK(TestSharedDynamicArray::hasValidElements(other, 10));
+            }
+
+            WHEN("The copy is modified")
+            {
+                other.pop_back();
+
+                THEN("The original array shouldn't change")
+                {
+                    CHECK(TestSharedDynamicArray::hasValidElements(testArray, 10));
+                    CHECK(TestSharedDynamicArray::hasValidElements(other, 9));
+                }
+            }
+        }
+
+        WHEN("An element outside of the array is replaced")
+        {
+            THEN("An exception should be thrown")
+            {
+                REQUIRE_THROWS_AS(testArray.set(10, 0), std::out_of_range);
+            }
+        }
+    }
+
+    GIVEN("A DynamicArray")
+    {
+        DynamicArray<int> source;
+        for(int i = 0; i < 5; ++i)
+        {
+            source.push_back(i);
+        }
+
+        WHEN("A shared array is constructed from it")
+        {
+            SharedDynamicArray<int> testArray(source);
+
+            THEN("It should contain the same elements")
+            {
+                CHECK(TestSharedDynamicArray::hasValidElements(testArray, 5));
+                REQUIRE(testArray.capacity() == source.capacity());
+            }
+        }
+    }
+}
+
+SCENARIO("Testing concurrent readers of a shared array")
+{
+    GIVEN("A shared array and snapshots read by several threads")
+    {
+        const size_t elements = 1000;
+
+        SharedDynamicArray<int> testArray;
+        TestSharedDynamicArray::init(testArray, elements);
+
+        WHEN("The array is modified while the snapshots are read")
+        {
+            std::vector<std::thread> readers;
+            std::vector<char> results(4, 0);
+
+            for(size_t i = 0; i < results.size(); ++i)
+            {
+                SharedDynamicArray<int> snapshot = testArray.snapshot();
+
+                readers.emplace_back([snapshot, &results, i, elements]()
+                {
+                    bool valid = true;
+                    for(int pass = 0; pass < 50; ++pass)
+                    {
+                        valid = valid && TestSharedDynamicArray::hasValidElements(snapshot, elements);
+                    }
+                    results[i] = valid;
+                });
+            }
+
+            for(size_t i = 0; i < elements; ++i)
+            {
+                testArray.set(i, -1);
+            }
+
+            for(std::thread& reader : readers)
+            {
+                reader.join();
+            }
+
+            THEN("The readers should see the original elements")
+            {
+                for(char result : results)
+                {
+                    CHECK(result);
+                }
+            }
+
+            THEN("The writer should see its own elements")
+            {
+                CHECK(testArray.unique());
+                REQUIRE(testArray[0] == -1);
+                REQUIRE(testArray[elements - 1] == -1);
+            }
+        }
+    }
+}
@@ -0,0 +1,257 @@
+#include "catch.hpp"
+#include "../Sort.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+
+class TestSort
+{
+public:
+
+    template <class Type>
+    static DynamicArray<Type> randomArray(size_t size, Type low, Type high)
+    {
+        std::mt19937_64 generator(size);
+        typename std::conditional<std::is_integral<Type>::value,
+                                  std::uniform_int_distribution<Type>,
+                                  std::uniform_real_distribution<Type>>::type distribution(low, high);
+
+        DynamicArray<Type> array(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(distribution(generator));
+        }
+        return array;
+    }
+
+    template <class Type, class Compare = std::less<Type>>
+    static bool sortedLike(const DynamicArray<Type>& array, DynamicArray<Type> expected, Compare compare = Compare())
+    {
+        std::stable_sort(expected.begin(), expected.end(), compare);
+        return array.size() == expected.size() && std::equal(array.begin(), array.end(), expected.begin());
+    }
+
+    static DynamicArray<double> specialValues(size_t repetitions)
+    {
+        const double values[] = {1.5, 0.0, -std::numeric_limits<double>::quiet_NaN(), -0.0, std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN(), -2.0, 0.0, -0.0, -std::numeric_limits<double>::infinity()};
+
+        DynamicArray<double> array;
+        for(size_t i = 0; i < repetitions; ++i)
+        {
+            array.append(values, sizeof(values) / sizeof(double));
+        }
+        return array;
+    }
+
+    static bool sortedLikeRadix(const DynamicArray<double>& array, DynamicArray<double> expected)
+    {
+        radix_sort(expected);
+        return array.size() == expected.size() && std::memcmp(array.data(), expected.data(), array.size() * sizeof(double)) == 0;
+    }
+};
+
+SCENARIO("Testing radix sort")
+{
+    GIVEN("Arrays of signed and unsigned integers")
+    {
+        size_t size = GENERATE(0, 1, 2, 100, 5000);
+
+        DynamicArray<int32_t> signedArray = TestSort::randomArray<int32_t>(size, INT32_MIN, INT32_MAX);
+        DynamicArray<uint64_t> unsignedArray = TestSort::randomArray<uint64_t>(size, 0, UINT64_MAX);
+        DynamicArray<int16_t> narrowArray = TestSort::randomArray<int16_t>(size, -100, 100);
+
+        DynamicArray<int32_t> signedCopy(signedArray);
+        DynamicArray<uint64_t> unsignedCopy(unsignedArray);
+        DynamicArray<int16_t> narrowCopy(narrowArray);
+
+        WHEN("They are sorted")
+        {
+            radix_sort(signedArray);
+            radix_sort(unsignedArray);
+            radix_sort(narrowArray);
+
+            THEN("They should be sorted like with std::sort")
+            {
+                CHECK(TestSort::sortedLike(signedArray, signedCopy));
+                CHECK(TestSort::sortedLike(unsignedArray, unsignedCopy));
+                CHECK(TestSort::sortedLike(narrowArray, narrowCopy));
+            }
+        }
+    }
+
+    GIVEN("Arrays of floating point values with negative values")
+    {
+        DynamicArray<float> floats = TestSort::randomArray<float>(3000, -1000.0f, 1000.0f);
+        DynamicArray<double> doubles = TestSort::randomArray<double>(3000, -1e300, 1e300);
+        floats.push_back(0.0f);
+        floats.push_back(-0.5f);
+
+        DynamicArray<float> floatsCopy(floats);
+        DynamicArray<double> doublesCopy(doubles);
+
+        WHEN("They are sorted")
+        {
+            radix_sort(floats);
+            radix_sort(doubles);
+
+            THEN("They should be sorted like with std::sort")
+            {
+                CHECK(TestSort::sortedLike(floats, floatsCopy));
+                CHECK(TestSort::sortedLike(doubles, doublesCopy));
+            }
+        }
+    }
+
+    GIVEN("An array of pairs with repeated keys")
+    {
+        typedef std::pair<int64_t, size_t> Pair;
+
+        DynamicArray<Pair> pairs;
+        std::mt19937 generator(3);
+        for(size_t i = 0; i < 4000; ++i)
+        {
+            pairs.push_back(Pair(int64_t(generator() % 50) - 25, i));
+        }
+
+        DynamicArray<Pair> copy(pairs);
+
+        WHEN("It is sorted by the keys with a reused scratch buffer")
+        {
+            Buffer<Pair> scratch(pairs.size());
+            radix_sort(pairs, [](const Pair& pair) { return pair.first; }, scratch);
+
+            THEN("Pairs with the same key should keep their order")
+            {
+                CHECK(TestSort::sortedLike(pairs, copy, [](const Pair& lhs, const Pair& rhs) { return lhs.first < rhs.first; }));
+            }
+        }
+
+        WHEN("The scratch buffer is too small")
+        {
+            Buffer<Pair> scratch(10);
+
+            THEN("An exception should be thrown")
+            {
+                REQUIRE_THROWS_AS(radix_sort(pairs, [](const Pair& pair) { return pair.first; }, scratch), std::invalid_argument);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing parallel merge sort")
+{
+    GIVEN("A large array")
+    {
+        size_t threads = GENERATE(1, 2, 3, 4, 7);
+
+        DynamicArray<int> array = TestSort::randomArray<int>(200000, 0, 1000);
+        DynamicArray<int> copy(array);
+
+        WHEN("It is sorted in parallel")
+        {
+            parallel_sort(array, std::less<int>(), threads);
+
+            THEN("It should be sorted like with std::sort")
+            {
+                CHECK(TestSort::sortedLike(array, copy));
+            }
+        }
+
+        WHEN("It is sorted in parallel in descending order")
+        {
+            parallel_sort(array, std::greater<int>(), threads);
+
+            THEN("It should be sorted like with std::sort")
+            {
+                CHECK(TestSort::sortedLike(array, copy, std::greater<int>()));
+            }
+        }
+    }
+
+    GIVEN("A large array of pairs with repeated keys")
+    {
+        typedef std::pair<int, int> Pair;
+
+        DynamicArray<Pair> pairs;
+        std::mt19937 generator(5);
+        for(int i = 0; i < 100000; ++i)
+        {
+            pairs.push_back(Pair(generator() % 100, i));
+        }
+
+        DynamicArray<Pair> copy(pairs);
+        auto byKey = [](const Pair& lhs, const Pair& rhs) { return lhs.first < rhs.first; };
+
+        WHEN("It is sorted in parallel with a stable sort")
+        {
+            parallel_stable_sort(pairs, byKey, 4);
+
+            THEN("Pairs with the same key should keep their order")
+            {
+                CHECK(TestSort::sortedLike(pairs, copy, byKey));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the sort chosen by the type of the elements")
+{
+    GIVEN("Arrays of numbers and strings")
+    {
+        DynamicArray<int> numbers = TestSort::randomArray<int>(10000, -50, 50);
+        DynamicArray<std::string> strings;
+        for(int i = 0; i < 1000; ++i)
+        {
+            strings.push_back(std::to_string(numbers[i]));
+        }
+
+        DynamicArray<int> numbersCopy(numbers);
+        DynamicArray<std::string> stringsCopy(strings);
+
+        WHEN("They are sorted")
+        {
+            sort(numbers);
+            stable_sort(strings);
+
+            THEN("They should be sorted like with std::sort")
+            {
+                CHECK(TestSort::sortedLike(numbers, numbersCopy));
+                CHECK(TestSort::sortedLike(strings, stringsCopy));
+            }
+        }
+    }
+
+    GIVEN("Few and many floating point values with NaNs and zeros of both signs")
+    {
+        DynamicArray<double> few = TestSort::specialValues(1);
+        DynamicArray<double> many = TestSort::specialValues(100);
+
+        THEN("Both sorts should order them like the radix sort")
+        {
+            DynamicArray<double> array = few;
+            sort(array);
+            CHECK(TestSort::sortedLikeRadix(array, few));
+
+            array = few;
+            stable_sort(array);
+            CHECK(TestSort::sortedLikeRadix(array, few));
+            CHECK(std::signbit(array[3]));
+            CHECK(array[3] == 0.0);
+            CHECK_FALSE(std::signbit(array[5]));
+
+            array = many;
+            sort(array);
+            CHECK(TestSort::sortedLikeRadix(array, many));
+
+            array = many;
+            stable_sort(array);
+            CHECK(TestSort::sortedLikeRadix(array, many));
+        }
+    }
+}
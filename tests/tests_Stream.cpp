@@ -0,0 +1,169 @@
+#include "catch.hpp"
+#include "../Stream.hpp"
+
+#include <stdexcept>
+
+class TestStream
+{
+public:
+
+    static DynamicArray<int> makeArray(size_t size)
+    {
+        DynamicArray<int> array;
+        for(size_t i = 0; i < size; ++i)
+        {
+            array.push_back(int(i));
+        }
+        return array;
+    }
+
+    static StreamTask produce(const DynamicArray<int>& source, size_t chunk, BatchChannel<int>& channel)
+    {
+        DynamicArray<int> doubled(chunk);
+        for(std::span<const int> part : stream_chunks(source, chunk))
+        {
+            doubled.clear();
+            for(int value : part)
+            {
+                doubled.push_back(value * 2);
+            }
+            co_await channel.write(std::span<const int>(doubled.data(), doubled.size()));
+        }
+        channel.close();
+    }
+
+    static StreamTask consume(BatchChannel<int>& channel, DynamicArray<int>& out, size_t& reads)
+    {
+        for(;;)
+        {
+            std::span<const int> batch = co_await channel.read();
+            if(batch.empty())
+                break;
+
+            out.append(batch.data(), batch.size());
+            ++reads;
+        }
+    }
+
+    static StreamTask fail(BatchChannel<int>& channel)
+    {
+        co_await channel.read();
+        throw std::runtime_error("The stage failed");
+    }
+};
+
+SCENARIO("Testing stream chunks")
+{
+    GIVEN("An array")
+    {
+        DynamicArray<int> array = TestStream::makeArray(10);
+
+        THEN("The chunks should cover it in order")
+        {
+            size_t chunks = 0;
+            int expected = 0;
+            for(std::span<const int> chunk : stream_chunks(array, 4))
+            {
+                REQUIRE(chunk.size() == (chunks < 2 ? 4 : 2));
+                for(int value : chunk)
+                {
+                    REQUIRE(value == expected++);
+                }
+                ++chunks;
+            }
+            REQUIRE(chunks == 3);
+        }
+
+        THEN("Empty chunks should be rejected")
+        {
+            Generator<std::span<const int>> chunks = stream_chunks(array, 0);
+            REQUIRE_THROWS_AS(chunks.begin(), std::invalid_argument);
+        }
+    }
+
+    GIVEN("An empty array")
+    {
+        DynamicArray<int> array;
+
+        THEN("There should be no chunks")
+        {
+            size_t chunks = 0;
+            for(std::span<const int> chunk : stream_chunks(array, 4))
+            {
+                chunks += chunk.size() + 1;
+            }
+            REQUIRE(chunks == 0);
+        }
+    }
+}
+
+SCENARIO("Testing batch channels")
+{
+    GIVEN("A pipeline of a producer and a consumer")
+    {
+        DynamicArray<int> source = TestStream::makeArray(1000);
+        StreamScheduler scheduler;
+        DynamicArray<int> out;
+        size_t reads = 0;
+
+        WHEN("The batches are smaller than the limit")
+        {
+            BatchChannel<int> channel(scheduler, 100);
+            StreamTask producer = TestStream::produce(source, 30, channel);
+            StreamTask consumer = TestStream::consume(channel, out, reads);
+            scheduler.spawn(consumer);
+            scheduler.spawn(producer);
+            scheduler.run();
+
+            THEN("All elements should arrive in order without exceeding the limit")
+            {
+                REQUIRE(producer.done());
+                REQUIRE(consumer.done());
+                REQUIRE(out.size() == 1000);
+                for(size_t i = 0; i < 1000; ++i)
+                {
+                    REQUIRE(out[i] == int(2 * i));
+                }
+                REQUIRE(channel.high_water() <= 100);
+                REQUIRE(reads >= 10);
+                REQUIRE(reads < 34);
+            }
+        }
+
+        WHEN("The batches are larger than the limit")
+        {
+            BatchChannel<int> channel(scheduler, 10);
+            StreamTask producer = TestStream::produce(source, 64, channel);
+            StreamTask consumer = TestStream::consume(channel, out, reads);
+            scheduler.spawn(producer);
+            scheduler.spawn(consumer);
+            scheduler.run();
+
+            THEN("Every batch should be passed on its own")
+            {
+                REQUIRE(out.size() == 1000);
+                REQUIRE(out[999] == 1998);
+                REQUIRE(channel.high_water() == 64);
+                REQUIRE(reads == 16);
+            }
+        }
+
+        WHEN("The consumer fails")
+        {
+            BatchChannel<int> channel(scheduler, 10);
+            StreamTask producer = TestStream::produce(source, 5, channel);
+            StreamTask consumer = TestStream::fail(channel);
+            scheduler.spawn(producer);
+            scheduler.spawn(consumer);
+            scheduler.run();
+
+            THEN("Its task should rethrow the error and the producer should stay suspended")
+            {
+                REQUIRE(consumer.done());
+                REQUIRE_THROWS_AS(consumer.get(), std::runtime_error);
+                REQUIRE_FALSE(producer.done());
+                REQUIRE_NOTHROW(producer.get());
+            }
+        }
+    }
+}
@@ -1,4 +1,24 @@
 #define CATCH_CONFIG_MAIN
 
 #include "tests_Buffer.cpp"
-#include "tests_DynamicArray.cpp"
\ No newline at end of file
+#include "tests_DynamicArray.cpp"
+#include "tests_SharedDynamicArray.cpp"
+#include "tests_PersistentVector.cpp"
+#include "tests_FlatSet.cpp"
+#include "tests_FlatMap.cpp"
+#include "tests_EytzingerIndex.cpp"
+#include "tests_Sort.cpp"
+#include "tests_CompressedDynamicArray.cpp"
+#include "tests_Allocator.cpp"
+#include "tests_ExceptionSafety.cpp"
+#include "tests_Hardening.cpp"
+#include "tests_Gather.cpp"
+#include "tests_Filter.cpp"
+#include "tests_FileLoader.cpp"
+#include "tests_Stream.cpp"
+#include "tests_ConcurrentQueue.cpp"
+#include "tests_ShardedDynamicArray.cpp"
+#include "tests_PublishedArray.cpp"
+#include "tests_Expression.cpp"
+#include "tests_DynamicArraySlice.cpp"
+#include "tests_Parallel.cpp"
\ No newline at end of file